@@ -0,0 +1,165 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "flat_octree.h"
+#include "octree.h"
+
+#include "kdl/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumItems = 100'000;
+constexpr size_t NumRays = 10'000;
+constexpr double MinSize = 256.0;
+
+/**
+ * Creates items that resemble the brushes of a large map: mostly small boxes spread over
+ * the entire world, and a few large ones.
+ */
+std::vector<std::pair<vm::bbox3d, size_t>> makeItems()
+{
+  auto rng = std::mt19937{42};
+  auto position = std::uniform_real_distribution<double>{-16384.0, 16384.0};
+  auto smallExtent = std::uniform_real_distribution<double>{8.0, 256.0};
+  auto largeExtent = std::uniform_real_distribution<double>{256.0, 4096.0};
+
+  auto result = std::vector<std::pair<vm::bbox3d, size_t>>{};
+  result.reserve(NumItems);
+  for (size_t i = 0; i < NumItems; ++i)
+  {
+    auto& extent = i % 100 == 0 ? largeExtent : smallExtent;
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto max = min + vm::vec3d{extent(rng), extent(rng), extent(rng)};
+    result.emplace_back(vm::bbox3d{min, max}, i);
+  }
+  return result;
+}
+
+std::vector<vm::ray3d> makeRays()
+{
+  auto rng = std::mt19937{43};
+  auto position = std::uniform_real_distribution<double>{-16384.0, 16384.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumRays);
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto dir = vm::vec3d{direction(rng), direction(rng), direction(rng)};
+    result.emplace_back(origin, vm::normalize(dir));
+  }
+  return result;
+}
+
+template <typename Tree>
+void insertAll(Tree& tree, const std::vector<std::pair<vm::bbox3d, size_t>>& items)
+{
+  for (const auto& [bounds, data] : items)
+  {
+    tree.insert(bounds, data);
+  }
+}
+
+template <typename Tree>
+size_t pickAll(const Tree& tree, const std::vector<vm::ray3d>& rays)
+{
+  auto hits = std::vector<size_t>{};
+  auto numHits = size_t(0);
+  for (const auto& ray : rays)
+  {
+    hits.clear();
+    tree.find_intersectors(ray, std::back_inserter(hits));
+    numHits += hits.size();
+  }
+  return numHits;
+}
+
+} // namespace
+
+TEST_CASE("OctreeBenchmark.benchBuild")
+{
+  const auto items = makeItems();
+
+  timeLambda(
+    [&]() {
+      auto tree = octree<double, size_t>{MinSize};
+      insertAll(tree, items);
+    },
+    fmt::format("octree: insert {} items", NumItems));
+
+  timeLambda(
+    [&]() {
+      auto tree = flat_octree<double, size_t>{MinSize};
+      insertAll(tree, items);
+    },
+    fmt::format("flat_octree: insert {} items", NumItems));
+
+  timeLambda(
+    [&]() {
+      auto tree = flat_octree<double, size_t>{MinSize};
+      tree.build(items);
+    },
+    fmt::format("flat_octree: build from {} items", NumItems));
+
+  auto taskManager = kdl::task_manager{};
+  timeLambda(
+    [&]() {
+      auto tree = flat_octree<double, size_t>{MinSize};
+      tree.build(items, taskManager);
+    },
+    fmt::format("flat_octree: build from {} items in parallel", NumItems));
+}
+
+TEST_CASE("OctreeBenchmark.benchPick")
+{
+  const auto items = makeItems();
+  const auto rays = makeRays();
+
+  auto tree = octree<double, size_t>{MinSize};
+  insertAll(tree, items);
+
+  auto flatTree = flat_octree<double, size_t>{MinSize};
+  flatTree.build(items);
+
+  auto expectedHits = size_t(0);
+  timeLambda(
+    [&]() { expectedHits = pickAll(tree, rays); },
+    fmt::format("octree: pick {} rays", NumRays));
+
+  auto actualHits = size_t(0);
+  timeLambda(
+    [&]() { actualHits = pickAll(flatTree, rays); },
+    fmt::format("flat_octree: pick {} rays", NumRays));
+
+  CHECK(actualHits == expectedHits);
+}
+
+} // namespace tb
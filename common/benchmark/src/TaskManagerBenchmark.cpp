@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "kdl/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumItems = 200'000;
+
+/**
+ * Measures the time per item of the given function, which must process NumItems items.
+ */
+template <typename F>
+void timePerItem(F&& f, const std::string& message)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  f();
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  const auto totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+  printf(
+    "Time elapsed for '%s': %fms (%fns per item)\n",
+    message.c_str(),
+    totalNs / 1'000'000.0,
+    totalNs / double(NumItems));
+}
+
+} // namespace
+
+TEST_CASE("TaskManagerBenchmark.benchSchedulerOverhead")
+{
+  auto taskManager = kdl::task_manager{};
+
+  // a trivial workload so that the scheduler overhead dominates
+  auto items = std::vector<size_t>(NumItems);
+  std::iota(items.begin(), items.end(), size_t(0));
+  const auto work = [](const size_t i) { return i * i; };
+
+  timePerItem(
+    [&]() {
+      auto tasks = items | std::views::transform([&](const auto i) {
+                     return std::function{[&, i]() { return work(i); }};
+                   });
+      const auto results = taskManager.run_tasks_and_wait(std::move(tasks));
+      REQUIRE(results.size() == NumItems);
+    },
+    fmt::format("run_tasks_and_wait with {} items", NumItems));
+
+  timePerItem(
+    [&]() {
+      const auto results = taskManager.parallel_transform(items, work);
+      REQUIRE(results.size() == NumItems);
+    },
+    fmt::format("parallel_transform with {} items", NumItems));
+}
+
+} // namespace tb
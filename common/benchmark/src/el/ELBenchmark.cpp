@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "el/EvaluationContext.h"
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+#include "io/ELParser.h"
+
+#include <fmt/format.h>
+
+#include <string>
+
+namespace tb::el
+{
+namespace
+{
+
+constexpr size_t NumEvaluations = 100'000;
+
+} // namespace
+
+TEST_CASE("ELBenchmark.benchEvaluateModelExpression")
+{
+  const auto expression = io::ELParser::parseStrict(R"({{
+    spawnflags & 2 -> { path: "progs/armor.mdl", skin: 2, scale: modelscale * 2 },
+    spawnflags & 1 -> { path: "progs/armor.mdl", skin: 1, scale: modelscale },
+                      { path: "progs/armor.mdl", skin: 0, frame: [0, 1, 2][frame] }
+  }})")
+                            .value()
+                            .optimize();
+
+  const auto variables = VariableTable{MapType{
+    {"spawnflags", Value{4}},
+    {"modelscale", Value{1.5}},
+    {"frame", Value{1}},
+  }};
+  const auto context = EvaluationContext{variables};
+
+  auto frameSum = 0.0;
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumEvaluations; ++i)
+      {
+        frameSum += expression.evaluate(context)["frame"].numberValue();
+      }
+    },
+    fmt::format("Evaluate model expression {} times", NumEvaluations));
+
+  CHECK(frameSum == double(NumEvaluations));
+}
+
+} // namespace tb::el
@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/DiskIO.h"
+
+#include <fmt/format.h>
+
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumDirectories = 16;
+constexpr size_t NumSubDirectories = 16;
+constexpr size_t NumFiles = 16;
+constexpr size_t NumPaths = 100'000;
+
+/**
+ * Creates a directory tree below the given path and returns the relative paths of the
+ * files in it. The modification times of the directories are set to the past so that
+ * their listings can be cached.
+ */
+std::vector<std::string> createDirectoryTree(const std::filesystem::path& rootPath)
+{
+  const auto pastTime =
+    std::filesystem::file_time_type::clock::now() - std::chrono::hours{1};
+
+  auto filePaths = std::vector<std::string>{};
+  for (size_t i = 0; i < NumDirectories; ++i)
+  {
+    for (size_t j = 0; j < NumSubDirectories; ++j)
+    {
+      const auto directoryPath = fmt::format("textures{}/Base{}", i, j);
+      std::filesystem::create_directories(rootPath / directoryPath);
+
+      for (size_t k = 0; k < NumFiles; ++k)
+      {
+        const auto filePath = fmt::format("{}/Texture_{}.tga", directoryPath, k);
+        std::ofstream{rootPath / filePath};
+        filePaths.push_back(filePath);
+      }
+
+      std::filesystem::last_write_time(rootPath / directoryPath, pastTime);
+    }
+    std::filesystem::last_write_time(rootPath / fmt::format("textures{}", i), pastTime);
+  }
+  std::filesystem::last_write_time(rootPath, pastTime);
+
+  return filePaths;
+}
+
+} // namespace
+
+TEST_CASE("DiskIOBenchmark.benchFixPath")
+{
+  if (!Disk::isCaseSensitive())
+  {
+    return;
+  }
+
+  const auto rootPath = std::filesystem::temp_directory_path() / "DiskIOBenchmark";
+  std::filesystem::remove_all(rootPath);
+  const auto filePaths = createDirectoryTree(rootPath);
+
+  auto rng = std::mt19937{42};
+  auto fileIndex = std::uniform_int_distribution<size_t>{0, filePaths.size() - 1};
+  auto coin = std::bernoulli_distribution{0.5};
+
+  auto mixedCasePaths = std::vector<std::filesystem::path>{};
+  mixedCasePaths.reserve(NumPaths);
+  for (size_t i = 0; i < NumPaths; ++i)
+  {
+    auto filePath = filePaths[fileIndex(rng)];
+    for (auto& c : filePath)
+    {
+      c = coin(rng) ? char(std::toupper(c)) : char(std::tolower(c));
+    }
+    mixedCasePaths.push_back(rootPath / filePath);
+  }
+
+  auto numResolved = size_t(0);
+  timeLambda(
+    [&]() {
+      Disk::clearDirectoryCache();
+      numResolved = 0;
+      for (const auto& path : mixedCasePaths)
+      {
+        if (std::filesystem::exists(Disk::fixPath(path)))
+        {
+          ++numResolved;
+        }
+      }
+    },
+    fmt::format("Resolve {} mixed case paths", NumPaths));
+
+  CHECK(numResolved == NumPaths);
+
+  std::filesystem::remove_all(rootPath);
+}
+
+} // namespace tb::io
@@ -0,0 +1,212 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/StandardMapParser.h"
+#include "io/TestParserStatus.h"
+#include "mdl/BrushFaceAttributes.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 100'000;
+
+/**
+ * Parses a map without creating any nodes and only counts the parsed faces.
+ */
+class CountingMapParser : public StandardMapParser
+{
+public:
+  size_t faceCount = 0;
+
+  CountingMapParser(const std::string_view str, const mdl::MapFormat format)
+    : StandardMapParser{str, format, format}
+  {
+  }
+
+  Result<void> parse(ParserStatus& status) { return parseEntities(status); }
+
+private:
+  void onBeginEntity(
+    const FileLocation&, std::vector<mdl::EntityProperty>, ParserStatus&) override
+  {
+  }
+  void onEndEntity(const FileLocation&, ParserStatus&) override {}
+  void onBeginBrush(const FileLocation&, ParserStatus&) override {}
+  void onEndBrush(const FileLocation&, ParserStatus&) override {}
+  void onStandardBrushFace(
+    const FileLocation&,
+    mdl::MapFormat,
+    const vm::vec3d&,
+    const vm::vec3d&,
+    const vm::vec3d&,
+    const mdl::BrushFaceAttributes&,
+    ParserStatus&) override
+  {
+    ++faceCount;
+  }
+  void onValveBrushFace(
+    const FileLocation&,
+    mdl::MapFormat,
+    const vm::vec3d&,
+    const vm::vec3d&,
+    const vm::vec3d&,
+    const mdl::BrushFaceAttributes&,
+    const vm::vec3d&,
+    const vm::vec3d&,
+    ParserStatus&) override
+  {
+    ++faceCount;
+  }
+  void onPatch(
+    const FileLocation&,
+    const FileLocation&,
+    mdl::MapFormat,
+    size_t,
+    size_t,
+    std::vector<vm::vec<double, 5>>,
+    std::string,
+    ParserStatus&) override
+  {
+  }
+};
+
+std::string makeStandardCube(const int x, const int y, const int z)
+{
+  return fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) material_{6} 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) material_{6} 0 0 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) material_{6} 16 -8 0 0.5 0.5
+( {3} {4} {5} ) ( {3} {4} {7} ) ( {3} {8} {5} ) material_{6} 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {8} {5} ) ( {9} {4} {5} ) material_{6} 0 0 0 1 1
+( {3} {4} {5} ) ( {9} {4} {5} ) ( {3} {4} {7} ) material_{6} 0 0 90 1 1
+}}
+)",
+    x,
+    y,
+    z,
+    x + 16,
+    y + 16,
+    z + 16,
+    (x + y + z) % 64,
+    z + 17,
+    y + 17,
+    x + 17);
+}
+
+std::string makeValveCube(const int x, const int y, const int z)
+{
+  return fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) material_{6} [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) material_{6} [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) material_{6} [ -1 0 0 16 ] [ 0 -1 0 -8 ] 0 0.5 0.5
+( {3} {4} {5} ) ( {3} {4} {7} ) ( {3} {8} {5} ) material_{6} [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( {3} {4} {5} ) ( {3} {8} {5} ) ( {9} {4} {5} ) material_{6} [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {3} {4} {5} ) ( {9} {4} {5} ) ( {3} {4} {7} ) material_{6} [ 0.707107 0.707107 0 0 ] [ 0 0 -1 0 ] 90 1 1
+}}
+)",
+    x,
+    y,
+    z,
+    x + 16,
+    y + 16,
+    z + 16,
+    (x + y + z) % 64,
+    z + 17,
+    y + 17,
+    x + 17);
+}
+
+/**
+ * Generates a map with a worldspawn containing many small cubes.
+ */
+template <typename MakeCube>
+std::string makeMap(const MakeCube& makeCube)
+{
+  auto result = std::string{R"({
+"classname" "worldspawn"
+"wad" "some.wad"
+)"};
+
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    result += makeCube(
+      int(i % 64) * 32 - 2048, int(i / 64 % 64) * 32 - 2048, int(i / 4096) * 32 - 2048);
+  }
+  result += "}\n";
+
+  return result;
+}
+
+void benchParse(const std::string& data, const mdl::MapFormat format)
+{
+  auto status = TestParserStatus{};
+  auto parser = CountingMapParser{data, format};
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = parser.parse(status);
+  const auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(result.is_success());
+  CHECK(parser.faceCount == NumBrushes * 6);
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  const auto megabytes = double(data.size()) / (1024.0 * 1024.0);
+  printf(
+    "Parsed %zu brushes in %s format (%.1f MiB) in %fms: %.1f MiB/s\n",
+    NumBrushes,
+    mdl::formatName(format).c_str(),
+    megabytes,
+    seconds * 1000.0,
+    megabytes / seconds);
+}
+
+} // namespace
+
+TEST_CASE("StandardMapParserBenchmark.benchParseThroughput")
+{
+  SECTION("Standard")
+  {
+    benchParse(makeMap(makeStandardCube), mdl::MapFormat::Standard);
+  }
+
+  SECTION("Valve")
+  {
+    benchParse(makeMap(makeValveCube), mdl::MapFormat::Valve);
+  }
+}
+
+} // namespace tb::io
@@ -0,0 +1,192 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/MapFormatDetection.h"
+#include "io/TestParserStatus.h"
+#include "io/WorldReader.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumEntities = 4'000;
+constexpr size_t NumBrushesPerEntity = 16;
+
+constexpr auto StandardAttributes = "0 0 0 1 1";
+constexpr auto ValveAttributes = "[ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1";
+
+std::string makeCube(
+  const int x, const int y, const int z, const std::string_view attributes)
+{
+  return fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) material_{6} {10}
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) material_{6} {10}
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) material_{6} {10}
+( {3} {4} {5} ) ( {3} {4} {7} ) ( {3} {8} {5} ) material_{6} {10}
+( {3} {4} {5} ) ( {3} {8} {5} ) ( {9} {4} {5} ) material_{6} {10}
+( {3} {4} {5} ) ( {9} {4} {5} ) ( {3} {4} {7} ) material_{6} {10}
+}}
+)",
+    x,
+    y,
+    z,
+    x + 16,
+    y + 16,
+    z + 16,
+    (x + y + z) % 64,
+    z + 17,
+    y + 17,
+    x + 17,
+    attributes);
+}
+
+/**
+ * Generates a map with a worldspawn and many brush entities, each containing a number of
+ * small cubes. The brush faces end with the given attributes. The map has no game and
+ * format header, so its format must be detected from its contents.
+ */
+std::string makeHeaderlessMap(const std::string_view attributes)
+{
+  auto result = std::string{};
+  result += R"({
+"classname" "worldspawn"
+"wad" "some.wad"
+)";
+  for (size_t i = 0; i < NumBrushesPerEntity; ++i)
+  {
+    result += makeCube(int(i) * 32, 0, 0, attributes);
+  }
+  result += "}\n";
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    result += fmt::format(
+      R"({{
+"classname" "func_detail"
+"targetname" "entity_{}"
+)",
+      i);
+    for (size_t j = 0; j < NumBrushesPerEntity; ++j)
+    {
+      result += makeCube(
+        int(j) * 32 - 2048,
+        int(i % 64) * 32 - 2048,
+        int(i / 64) * 32 - 2048,
+        attributes);
+    }
+    result += "}\n";
+  }
+
+  return result;
+}
+
+/**
+ * Generates a map with a worldspawn and many brush entities, each containing a number of
+ * small cubes.
+ */
+std::string makeMap()
+{
+  return "// Game: Quake\n// Format: Standard\n" + makeHeaderlessMap(StandardAttributes);
+}
+
+} // namespace
+
+TEST_CASE("WorldReaderBenchmark.benchParseInParallelChunks")
+{
+  const auto data = makeMap();
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto taskManager = kdl::task_manager{};
+
+  const auto readWorld = [&](const auto chunkSize) {
+    auto status = TestParserStatus{};
+    auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    reader.setParallelParseChunkSize(chunkSize);
+
+    auto worldResult = reader.read(worldBounds, status, taskManager);
+    REQUIRE(worldResult.is_success());
+  };
+
+  timeLambda(
+    [&]() { readWorld(std::nullopt); },
+    fmt::format("read {} bytes serially", data.size()));
+
+  timeLambda(
+    [&]() { readWorld(MapReader::DefaultParallelParseChunkSize); },
+    fmt::format("read {} bytes in parallel chunks", data.size()));
+}
+
+TEST_CASE("WorldReaderBenchmark.benchTryRead")
+{
+  const auto data = makeHeaderlessMap(ValveAttributes);
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto mapFormats = std::vector{mdl::MapFormat::Standard, mdl::MapFormat::Valve};
+  auto taskManager = kdl::task_manager{};
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        CHECK(rankMapFormats(data, mapFormats).front() == mdl::MapFormat::Valve);
+      }
+    },
+    "rank map formats 100 times");
+
+  timeLambda(
+    [&]() {
+      // try the formats in the given order, as WorldReader::tryRead used to do
+      for (const auto mapFormat : mapFormats)
+      {
+        auto status = TestParserStatus{};
+        auto reader = WorldReader{data, mapFormat, {}};
+        if (reader.read(worldBounds, status, taskManager).is_success())
+        {
+          break;
+        }
+      }
+    },
+    fmt::format("read {} bytes trying every format in order", data.size()));
+
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      const auto worldResult =
+        WorldReader::tryRead(data, mapFormats, worldBounds, {}, status, taskManager);
+      REQUIRE(worldResult.is_success());
+    },
+    fmt::format("read {} bytes trying ranked formats", data.size()));
+}
+
+} // namespace tb::io
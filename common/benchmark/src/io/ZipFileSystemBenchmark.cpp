@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/DiskIO.h"
+#include "io/File.h"
+#include "io/ZipFileSystem.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <miniz/miniz.h>
+
+#include <atomic>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumEntries = 4'000;
+constexpr size_t EntrySize = 32 * 1024;
+
+/**
+ * Creates a PK3 file with many entries at the given path. The entries contain random
+ * bytes from a small alphabet so that they compress about as well as typical game data.
+ */
+std::vector<std::filesystem::path> createPk3(const std::filesystem::path& path)
+{
+  auto rng = std::mt19937{42};
+  auto symbol = std::uniform_int_distribution<int>{'a', 'p'};
+
+  auto archive = mz_zip_archive{};
+  mz_zip_zero_struct(&archive);
+  REQUIRE(mz_zip_writer_init_file(&archive, path.string().c_str(), 0));
+
+  auto entryPaths = std::vector<std::filesystem::path>{};
+  entryPaths.reserve(NumEntries);
+
+  auto data = std::string(EntrySize, '\0');
+  for (size_t i = 0; i < NumEntries; ++i)
+  {
+    for (auto& c : data)
+    {
+      c = char(symbol(rng));
+    }
+
+    const auto entryPath = fmt::format("textures/dir{}/entry{}.tga", i % 32, i);
+    REQUIRE(mz_zip_writer_add_mem(
+      &archive, entryPath.c_str(), data.data(), data.size(), MZ_DEFAULT_LEVEL));
+    entryPaths.emplace_back(entryPath);
+  }
+
+  REQUIRE(mz_zip_writer_finalize_archive(&archive));
+  REQUIRE(mz_zip_writer_end(&archive));
+
+  return entryPaths;
+}
+
+} // namespace
+
+TEST_CASE("ZipFileSystemBenchmark.benchExtractAll")
+{
+  const auto pk3Path =
+    std::filesystem::temp_directory_path() / "ZipFileSystemBenchmark.pk3";
+  const auto entryPaths = createPk3(pk3Path);
+
+  for (const auto numThreads : {size_t(1), size_t(4), size_t(16)})
+  {
+    auto fs = Disk::openFile(pk3Path) | kdl::and_then([](auto file) {
+                return createImageFileSystem<ZipFileSystem>(std::move(file));
+              })
+              | kdl::value();
+
+    auto taskManager = kdl::task_manager{numThreads};
+    auto totalSize = std::atomic<size_t>{0};
+
+    timeLambda(
+      [&]() {
+        taskManager.parallel_for(entryPaths, [&](const auto& entryPath) {
+          totalSize += fs->openFile(entryPath)
+                       | kdl::transform([](auto file) { return file->size(); })
+                       | kdl::value();
+        });
+      },
+      fmt::format("Extract {} entries with {} threads", NumEntries, numThreads));
+
+    CHECK(totalSize == NumEntries * EntrySize);
+  }
+
+  std::filesystem::remove(pk3Path);
+}
+
+} // namespace tb::io
@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/EntityModel.h"
+#include "render/IndexRangeMapBuilder.h"
+#include "render/PrimType.h"
+
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumFrames = 200;
+constexpr size_t NumRings = 48;
+constexpr size_t NumSegments = 48;
+
+/**
+ * Adds a frame containing a sphere made of triangle strips, similar to an animated
+ * MD2 or MDL model.
+ */
+void addSphereFrame(EntityModelData& modelData, EntityModelSurface& surface)
+{
+  auto& frame = modelData.addFrame(
+    fmt::format("frame{}", modelData.frameCount()),
+    vm::bbox3f{vm::vec3f::fill(-32.0f), vm::vec3f::fill(32.0f)});
+
+  auto size = render::IndexRangeMap::Size{};
+  size.inc(render::PrimType::TriangleStrip, NumRings);
+
+  auto builder = render::IndexRangeMapBuilder<EntityModelVertex::Type>{
+    NumRings * (NumSegments + 1) * 2, size};
+
+  const auto point = [](const size_t ring, const size_t segment) {
+    const auto theta = float(ring) / float(NumRings) * 3.14159265f;
+    const auto phi = float(segment) / float(NumSegments) * 2.0f * 3.14159265f;
+    const auto direction = vm::vec3f{
+      std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)};
+    return EntityModelVertex{32.0f * direction, vm::vec2f{0, 0}};
+  };
+
+  for (size_t ring = 0; ring < NumRings; ++ring)
+  {
+    auto strip = std::vector<EntityModelVertex>{};
+    for (size_t segment = 0; segment <= NumSegments; ++segment)
+    {
+      strip.push_back(point(ring, segment));
+      strip.push_back(point(ring + 1, segment));
+    }
+    builder.addTriangleStrip(strip);
+  }
+
+  surface.addMesh(frame, builder.vertices(), builder.indices());
+}
+
+} // namespace
+
+TEST_CASE("EntityModelBenchmark.benchFrames")
+{
+  auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+  auto& surface = modelData.addSurface("surface", NumFrames);
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumFrames; ++i)
+      {
+        addSphereFrame(modelData, surface);
+      }
+    },
+    fmt::format("Add {} frames", NumFrames));
+
+  auto rng = std::mt19937{42};
+  auto coord = std::uniform_real_distribution<float>{-24.0f, 24.0f};
+
+  auto rays = std::vector<vm::ray3f>{};
+  for (size_t i = 0; i < 10'000; ++i)
+  {
+    const auto target = vm::vec3f{coord(rng), coord(rng), coord(rng)};
+    const auto origin = vm::vec3f{128, coord(rng), coord(rng)};
+    rays.emplace_back(origin, vm::normalize(target - origin));
+  }
+
+  const auto& frame = modelData.frames().front();
+  auto hits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        hits += frame.intersect(ray) ? 1 : 0;
+      }
+    },
+    fmt::format("Intersect {} rays with one frame", rays.size()));
+
+  CHECK(hits > 0);
+  printf(
+    "Memory used by %zu frames with one BVH: %zu bytes\n",
+    NumFrames,
+    modelData.memoryUsage());
+}
+
+} // namespace tb::mdl
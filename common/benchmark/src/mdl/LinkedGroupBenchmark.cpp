@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/LinkedGroupUtils.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr auto WorldBounds = vm::bbox3d{8192.0};
+
+constexpr size_t NumBrushes = 100'000;
+constexpr size_t NumLinkedGroups = 500;
+constexpr size_t NumGroupsPerLinkSet = 5;
+constexpr size_t NumBrushesPerGroup = 20;
+constexpr size_t NumBrushesToTransform = 1'000;
+
+BrushNode* makeBrushNode(const BrushBuilder& builder, const size_t i)
+{
+  const auto min = vm::vec3d{double(i % 64), double(i / 64 % 64), double(i / 4096)} * 32.0
+                   - vm::vec3d{2048.0, 2048.0, 2048.0};
+  const auto bounds = vm::bbox3d{min, min + vm::vec3d{16.0, 16.0, 16.0}};
+  return new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()};
+}
+
+/**
+ * Creates a world containing NumLinkedGroups linked groups and loose brushes, with
+ * NumBrushes brushes in total. Every NumGroupsPerLinkSet consecutive groups form a link
+ * set.
+ */
+std::unique_ptr<WorldNode> makeWorld()
+{
+  const auto builder = BrushBuilder{MapFormat::Standard, WorldBounds};
+
+  auto worldNode =
+    std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, MapFormat::Standard);
+
+  auto children = std::vector<Node*>{};
+  auto brushIndex = size_t(0);
+  for (size_t i = 0; i < NumLinkedGroups / NumGroupsPerLinkSet; ++i)
+  {
+    auto* groupNode = new GroupNode{Group{fmt::format("group {}", i)}};
+    for (size_t j = 0; j < NumBrushesPerGroup; ++j)
+    {
+      groupNode->addChild(makeBrushNode(builder, brushIndex++));
+    }
+    children.push_back(groupNode);
+
+    for (size_t j = 1; j < NumGroupsPerLinkSet; ++j)
+    {
+      children.push_back(groupNode->cloneRecursively(WorldBounds));
+      brushIndex += NumBrushesPerGroup;
+    }
+  }
+
+  while (brushIndex < NumBrushes)
+  {
+    children.push_back(makeBrushNode(builder, brushIndex++));
+  }
+
+  worldNode->disableNodeTreeUpdates();
+  worldNode->defaultLayer()->addChildren(children);
+  worldNode->enableNodeTreeUpdates();
+  worldNode->rebuildNodeTree();
+  return worldNode;
+}
+
+/**
+ * Returns the brushes of the first linked groups.
+ */
+std::vector<BrushNode*> collectBrushesToTransform(WorldNode& worldNode)
+{
+  auto result = std::vector<BrushNode*>{};
+  for (auto* groupNode : worldNode.defaultLayer()->children())
+  {
+    for (auto* child : groupNode->children())
+    {
+      if (result.size() < NumBrushesToTransform)
+      {
+        result.push_back(static_cast<BrushNode*>(child));
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("LinkedGroupBenchmark.benchTransformBrushesInLinkedGroups")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto worldNode = makeWorld();
+  const auto brushNodes = collectBrushesToTransform(*worldNode);
+  REQUIRE(brushNodes.size() == NumBrushesToTransform);
+
+  const auto transformation = vm::translation_matrix(vm::vec3d{16.0, 0.0, 0.0});
+
+  // mirrors the work that MapDocument::transformObjects does for each brush, the result
+  // indicates whether the brush was transformed with alignment lock
+  auto results = std::vector<bool>{};
+  timeLambda(
+    [&]() {
+      results = taskManager.parallel_transform(brushNodes, [&](auto* brushNode) {
+        const auto* containingGroup = brushNode->containingGroup();
+        const auto lockAlignment =
+          containingGroup && containingGroup->closed()
+          && collectLinkedNodes({worldNode.get()}, *brushNode).size() > 1;
+
+        auto brush = brushNode->brush();
+        return brush.transform(WorldBounds, transformation, lockAlignment).is_success()
+               && lockAlignment;
+      });
+    },
+    fmt::format(
+      "Transform {} brushes in a map with {} brushes and {} linked groups",
+      NumBrushesToTransform,
+      NumBrushes,
+      NumLinkedGroups));
+
+  CHECK(std::ranges::all_of(results, [](const auto result) { return result; }));
+}
+
+} // namespace tb::mdl
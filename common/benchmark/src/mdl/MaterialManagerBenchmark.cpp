@@ -0,0 +1,150 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Logger.h"
+#include "mdl/Material.h"
+#include "mdl/MaterialCollection.h"
+#include "mdl/MaterialManager.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
+
+#include "kdl/string_format.h"
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
+#include <fmt/format.h>
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumMaterials = 2'000;
+constexpr size_t NumFaces = 1'000'000;
+
+std::vector<std::string> makeMaterialNames()
+{
+  auto result = std::vector<std::string>{};
+  result.reserve(NumMaterials);
+  for (size_t i = 0; i < NumMaterials; ++i)
+  {
+    result.push_back(fmt::format("base_wall/metal_panel_{}", i));
+  }
+  return result;
+}
+
+/**
+ * Returns the material names of the faces of a map. The names are picked at random and
+ * have random case, since map files don't have to match the case of the material names.
+ */
+std::vector<std::string> makeFaceMaterialNames(
+  const std::vector<std::string>& materialNames)
+{
+  auto rng = std::mt19937{42};
+  auto index = std::uniform_int_distribution<size_t>{0, materialNames.size() - 1};
+  auto coin = std::bernoulli_distribution{0.25};
+
+  auto result = std::vector<std::string>{};
+  result.reserve(NumFaces);
+  for (size_t i = 0; i < NumFaces; ++i)
+  {
+    auto name = materialNames[index(rng)];
+    for (auto& c : name)
+    {
+      if (coin(rng))
+      {
+        c = char(std::toupper(static_cast<unsigned char>(c)));
+      }
+    }
+    result.push_back(std::move(name));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("MaterialManagerBenchmark.benchMaterialLookup")
+{
+  const auto materialNames = makeMaterialNames();
+  const auto faceMaterialNames = makeFaceMaterialNames(materialNames);
+
+  auto logger = NullLogger{};
+  auto materialManager = MaterialManager{logger};
+
+  auto materials = std::vector<Material>{};
+  materials.reserve(materialNames.size());
+  for (const auto& name : materialNames)
+  {
+    materials.emplace_back(name, createTextureResource(Texture{16, 16}));
+  }
+  materialManager.setMaterialCollections(
+    kdl::vec_from(MaterialCollection{std::move(materials)}));
+
+  // the previous implementation converted every name to lower case before the lookup
+  auto lowerCaseIndex = std::unordered_map<std::string, const Material*>{};
+  for (const auto* material : materialManager.materials())
+  {
+    lowerCaseIndex.emplace(kdl::str_to_lower(material->name()), material);
+  }
+
+  auto numFound = size_t(0);
+  timeLambda(
+    [&]() {
+      numFound = 0;
+      for (const auto& name : faceMaterialNames)
+      {
+        numFound += lowerCaseIndex.count(kdl::str_to_lower(name));
+      }
+    },
+    fmt::format("Resolve {} face materials with lower case conversion", NumFaces));
+  CHECK(numFound == NumFaces);
+
+  const auto& constMaterialManager = materialManager;
+  timeLambda(
+    [&]() {
+      numFound = 0;
+      for (const auto& name : faceMaterialNames)
+      {
+        numFound += constMaterialManager.material(name) != nullptr ? 1 : 0;
+      }
+    },
+    fmt::format("Resolve {} face materials", NumFaces));
+  CHECK(numFound == NumFaces);
+
+  auto taskManager = kdl::task_manager{};
+  auto resolved = std::vector<const Material*>{};
+  timeLambda(
+    [&]() {
+      resolved = taskManager.parallel_transform(faceMaterialNames, [&](const auto& name) {
+        return constMaterialManager.material(name);
+      });
+    },
+    fmt::format("Resolve {} face materials in parallel", NumFaces));
+  CHECK(resolved.size() == NumFaces);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,145 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/HitFilter.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t GridSize = 40;
+constexpr size_t NumBrushes = GridSize * GridSize * GridSize;
+constexpr size_t NumRays = 1'000;
+
+/**
+ * Creates a world with a dense grid of small cubes.
+ */
+std::unique_ptr<WorldNode> makeWorld()
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto worldNode =
+    std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, MapFormat::Standard);
+  auto children = std::vector<Node*>{};
+  for (size_t x = 0; x < GridSize; ++x)
+  {
+    for (size_t y = 0; y < GridSize; ++y)
+    {
+      for (size_t z = 0; z < GridSize; ++z)
+      {
+        const auto min = vm::vec3d{double(x), double(y), double(z)} * 64.0
+                         - vm::vec3d{1280.0, 1280.0, 1280.0};
+        const auto bounds = vm::bbox3d{min, min + vm::vec3d{32.0, 32.0, 32.0}};
+        children.push_back(
+          new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+      }
+    }
+  }
+
+  worldNode->disableNodeTreeUpdates();
+  worldNode->defaultLayer()->addChildren(children);
+  worldNode->enableNodeTreeUpdates();
+  worldNode->rebuildNodeTree();
+  return worldNode;
+}
+
+/**
+ * Creates rays that start outside of the grid and point at random points inside of it.
+ */
+std::vector<vm::ray3d> makeRays()
+{
+  auto rng = std::mt19937{42};
+  auto coord = std::uniform_real_distribution<double>{-1280.0, 1280.0};
+  auto angle = std::uniform_real_distribution<double>{0.0, 6.28};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumRays);
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto a = angle(rng);
+    const auto origin = vm::vec3d{std::cos(a) * 4096.0, std::sin(a) * 4096.0, coord(rng)};
+    const auto target = vm::vec3d{coord(rng), coord(rng), coord(rng)};
+    result.emplace_back(origin, vm::normalize(target - origin));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PickBenchmark.benchPickClosest")
+{
+  const auto worldNode = makeWorld();
+  const auto rays = makeRays();
+  const auto editorContext = EditorContext{};
+  const auto filter = HitFilters::type(BrushNode::BrushHitType);
+
+  auto allDistances = std::vector<double>{};
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult::byDistance();
+        worldNode->pick(editorContext, ray, pickResult);
+        allDistances.push_back(pickResult.first(filter).distance());
+      }
+    },
+    fmt::format("Pick all hits for {} rays in {} brushes", NumRays, NumBrushes));
+
+  auto closestDistances = std::vector<double>{};
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult::byDistance();
+        worldNode->pickClosest(editorContext, ray, filter, pickResult);
+        closestDistances.push_back(pickResult.first(filter).distance());
+      }
+    },
+    fmt::format("Pick closest hit for {} rays in {} brushes", NumRays, NumBrushes));
+
+  CHECK(closestDistances == allDistances);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushGeometry.h"
+#include "mdl/CircleShape.h"
+#include "mdl/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 10'000;
+
+/**
+ * Creates cylinders with varying numbers of sides so that the geometries have between
+ * a few and a few dozen elements of each kind.
+ */
+std::vector<Brush> makeBrushes(const vm::bbox3d& worldBounds)
+{
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto min = vm::vec3d{double(i % 100) * 64.0, double(i / 100) * 64.0, 0.0};
+    result.push_back(
+      builder.createCylinder(
+        vm::bbox3d{min, min + vm::vec3d{32, 32, 32}},
+        EdgeAlignedCircle{4 + i % 16},
+        vm::axis::z,
+        "material")
+      | kdl::value());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.benchUpdateGeometryFromFaces")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushes = makeBrushes(worldBounds);
+
+  // Brush::create calls Brush::updateGeometryFromFaces
+  auto faces = std::vector<std::vector<BrushFace>>{};
+  faces.reserve(brushes.size());
+  for (const auto& brush : brushes)
+  {
+    faces.push_back(brush.faces());
+  }
+
+  auto newBrushes = std::vector<Brush>{};
+  newBrushes.reserve(brushes.size());
+
+  timeLambda(
+    [&]() {
+      for (auto& brushFaces : faces)
+      {
+        newBrushes.push_back(
+          Brush::create(worldBounds, std::move(brushFaces)) | kdl::value());
+      }
+    },
+    fmt::format("update geometry of {} brushes from faces", brushes.size()));
+}
+
+TEST_CASE("PolyhedronBenchmark.benchCopy")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushes = makeBrushes(worldBounds);
+
+  auto geometries = std::vector<BrushGeometry>{};
+  geometries.reserve(brushes.size());
+  for (const auto& brush : brushes)
+  {
+    auto positions = std::vector<vm::vec3d>{};
+    for (const auto* vertex : brush.vertices())
+    {
+      positions.push_back(vertex->position());
+    }
+    geometries.emplace_back(std::move(positions));
+  }
+
+  auto copies = std::vector<BrushGeometry>{};
+  copies.reserve(geometries.size());
+
+  timeLambda(
+    [&]() {
+      for (const auto& geometry : geometries)
+      {
+        copies.push_back(geometry);
+      }
+    },
+    fmt::format("copy {} polyhedra", geometries.size()));
+
+  timeLambda(
+    [&]() { copies.clear(); }, fmt::format("destroy {} polyhedra", geometries.size()));
+
+  auto brushCopies = std::vector<Brush>{};
+  brushCopies.reserve(brushes.size());
+
+  timeLambda(
+    [&]() {
+      for (const auto& brush : brushes)
+      {
+        brushCopies.push_back(brush);
+      }
+    },
+    fmt::format("copy {} brushes", brushes.size()));
+}
+
+} // namespace tb::mdl
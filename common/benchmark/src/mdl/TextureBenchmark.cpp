@@ -0,0 +1,245 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/ReadMipTexture.h"
+#include "io/Reader.h"
+#include "mdl/Palette.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumTextures = 4'000;
+constexpr size_t MipLevels = 4;
+
+std::vector<unsigned char> makeRandomPaletteData(std::mt19937& rng)
+{
+  auto byte = std::uniform_int_distribution<int>{0, 255};
+  auto data = std::vector<unsigned char>(768);
+  for (auto& c : data)
+  {
+    c = static_cast<unsigned char>(byte(rng));
+  }
+  return data;
+}
+
+std::vector<unsigned char> toRgba(const std::vector<unsigned char>& rgbData)
+{
+  auto rgbaData = std::vector<unsigned char>{};
+  rgbaData.reserve(rgbData.size() / 3 * 4);
+  for (size_t i = 0; i + 2 < rgbData.size(); i += 3)
+  {
+    rgbaData.insert(rgbaData.end(), {rgbData[i], rgbData[i + 1], rgbData[i + 2], 0xFF});
+  }
+  return rgbaData;
+}
+
+template <typename T>
+void append(std::vector<char>& data, const T value)
+{
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Creates mip textures like the ones found in a Quake WAD file. The indices consist of
+ * short runs of the same color, as is typical for hand drawn textures.
+ */
+std::vector<std::vector<char>> makeMipTextures(std::mt19937& rng)
+{
+  auto sizeExponent = std::uniform_int_distribution<int>{5, 8};
+  auto index = std::uniform_int_distribution<int>{0, 254};
+  auto runLength = std::uniform_int_distribution<int>{1, 8};
+
+  auto result = std::vector<std::vector<char>>{};
+  result.reserve(NumTextures);
+  for (size_t i = 0; i < NumTextures; ++i)
+  {
+    const auto width = size_t(1) << sizeExponent(rng);
+    const auto height = size_t(1) << sizeExponent(rng);
+
+    auto data = std::vector<char>(16, '\0');
+    append(data, int32_t(width));
+    append(data, int32_t(height));
+
+    auto offset = int32_t(16 + 2 * 4 + MipLevels * 4);
+    for (size_t level = 0; level < MipLevels; ++level)
+    {
+      append(data, offset);
+      offset += int32_t((width >> level) * (height >> level));
+    }
+
+    for (size_t level = 0; level < MipLevels; ++level)
+    {
+      const auto pixelCount = (width >> level) * (height >> level);
+      while (data.size() < size_t(offset) && pixelCount > 0)
+      {
+        const auto color = char(index(rng));
+        const auto run = size_t(runLength(rng));
+        for (size_t j = 0; j < run; ++j)
+        {
+          data.push_back(color);
+        }
+      }
+    }
+    data.resize(size_t(offset));
+
+    result.push_back(std::move(data));
+  }
+  return result;
+}
+
+/**
+ * The previous implementation of Palette::indexedToRgba, kept for comparison.
+ */
+void indexedToRgbaScalar(
+  io::Reader& reader,
+  const size_t pixelCount,
+  TextureBuffer& rgbaImage,
+  const std::vector<unsigned char>& paletteData,
+  Color& averageColor)
+{
+  auto* const rgbaData = rgbaImage.data();
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    const int index = reader.readInt<unsigned char>();
+    std::memcpy(rgbaData + (i * 4), &paletteData[size_t(index) * 4], 4);
+  }
+
+  uint32_t colorSum[3] = {0, 0, 0};
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
+    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
+    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+  }
+  averageColor = Color{
+    float(colorSum[0]) / (255.0f * float(pixelCount)),
+    float(colorSum[1]) / (255.0f * float(pixelCount)),
+    float(colorSum[2]) / (255.0f * float(pixelCount)),
+    1.0f};
+}
+
+} // namespace
+
+TEST_CASE("TextureBenchmark.benchReadMipTextures")
+{
+  auto rng = std::mt19937{42};
+  const auto rgbData = makeRandomPaletteData(rng);
+  const auto palette = makePalette(rgbData, PaletteColorFormat::Rgb) | kdl::value();
+  const auto paletteData = toRgba(rgbData);
+  const auto mipTextures = makeMipTextures(rng);
+
+  const auto expandAll = [&](const auto& expand) {
+    for (const auto& data : mipTextures)
+    {
+      auto reader = io::Reader::from(data.data(), data.data() + data.size());
+      reader.seekFromBegin(16);
+      const auto width = reader.readSize<int32_t>();
+      const auto height = reader.readSize<int32_t>();
+      reader.seekFromBegin(16 + 2 * 4 + MipLevels * 4);
+
+      for (size_t level = 0; level < MipLevels; ++level)
+      {
+        const auto pixelCount = (width >> level) * (height >> level);
+        auto rgbaImage = TextureBuffer{4 * pixelCount};
+        auto averageColor = Color{};
+        expand(reader, pixelCount, rgbaImage, averageColor);
+      }
+    }
+  };
+
+  timeLambda(
+    [&]() {
+      expandAll([&](auto& reader, const auto pixelCount, auto& rgbaImage, auto& color) {
+        indexedToRgbaScalar(reader, pixelCount, rgbaImage, paletteData, color);
+      });
+    },
+    fmt::format("Expand {} mip textures with per pixel reads", NumTextures));
+
+  timeLambda(
+    [&]() {
+      expandAll([&](auto& reader, const auto pixelCount, auto& rgbaImage, auto& color) {
+        palette.indexedToRgba(
+          reader, pixelCount, rgbaImage, PaletteTransparency::Opaque, color);
+      });
+    },
+    fmt::format("Expand {} mip textures", NumTextures));
+
+  auto numTextures = size_t(0);
+  timeLambda(
+    [&]() {
+      numTextures = 0;
+      for (const auto& data : mipTextures)
+      {
+        auto reader = io::Reader::from(data.data(), data.data() + data.size());
+        if (io::readIdMipTexture(reader, palette, TextureMask::Off).is_success())
+        {
+          ++numTextures;
+        }
+      }
+    },
+    fmt::format("Read {} mip textures", NumTextures));
+  CHECK(numTextures == NumTextures);
+}
+
+TEST_CASE("TextureBenchmark.benchGenerateMips")
+{
+  constexpr auto Size = size_t(256);
+  constexpr auto NumMipTextures = size_t(1'000);
+
+  auto rng = std::mt19937{42};
+  auto byte = std::uniform_int_distribution<int>{0, 255};
+
+  auto mip0 = TextureBuffer{4 * Size * Size};
+  for (size_t i = 0; i < mip0.size(); ++i)
+  {
+    mip0.data()[i] = static_cast<unsigned char>(byte(rng));
+  }
+
+  const auto mipLevels = size_t(9);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumMipTextures; ++i)
+      {
+        auto buffers = TextureBufferList{};
+        setMipBufferSize(buffers, mipLevels, Size, Size, GL_RGBA);
+        std::memcpy(buffers[0].data(), mip0.data(), mip0.size());
+        generateMips(buffers, Size, Size, GL_RGBA);
+      }
+    },
+    fmt::format(
+      "Generate mips for {} textures of {}*{} pixels", NumMipTextures, Size, Size));
+}
+
+} // namespace tb::mdl
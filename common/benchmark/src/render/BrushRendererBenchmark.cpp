@@ -27,11 +27,17 @@
 #include "mdl/Texture.h"
 #include "mdl/WorldNode.h"
 #include "render/BrushRenderer.h"
+#include "render/BrushRendererArrays.h"
+#include "render/BrushRendererBrushCache.h"
 
 #include "kdl/result.h"
+#include "kdl/task_manager.h"
 
 #include <fmt/format.h>
 
+#include <chrono>
+#include <cstdio>
+#include <random>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -90,6 +96,22 @@ auto makeBrushes()
   return std::tuple{std::move(result), std::move(materials)};
 }
 
+void printStats(BrushRenderer& r, const std::string& description)
+{
+  const auto print = [&](const char* arrays, const BrushArrayStats& stats) {
+    printf(
+      "%s %s: %zu KiB live, %zu KiB free, largest free block %zu KiB\n",
+      arrays,
+      description.c_str(),
+      stats.liveBytes / 1024u,
+      stats.freeBytes / 1024u,
+      stats.largestFreeBlockBytes / 1024u);
+  };
+
+  print("vertex array", r.vertexArrayStats());
+  print("index arrays", r.indexArrayStats());
+}
+
 } // namespace
 
 TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
@@ -149,4 +171,119 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
     "validate remaining brushes");
 }
 
+TEST_CASE("BrushRendererBenchmark.benchParallelValidate")
+{
+  auto [brushes, materials] = makeBrushes();
+
+  const auto invalidateVertexCaches = [&]() {
+    for (const auto& brush : brushes)
+    {
+      brush->brushRendererBrushCache().invalidateVertexCache();
+    }
+  };
+
+  const auto benchValidate = [&](BrushRenderer& r, const std::string& description) {
+    for (const auto& brush : brushes)
+    {
+      r.addBrush(brush.get());
+    }
+    invalidateVertexCaches();
+    timeLambda(
+      [&]() { r.validate(); },
+      fmt::format("validate {} brushes {}", brushes.size(), description));
+
+    r.invalidate();
+    timeLambda(
+      [&]() { r.validate(); },
+      fmt::format(
+        "validate {} brushes with cached vertices {}", brushes.size(), description));
+  };
+
+  {
+    auto r = BrushRenderer{};
+    benchValidate(r, "serially");
+  }
+
+  for (const auto numThreads : {size_t(4), size_t(16)})
+  {
+    auto taskManager = kdl::task_manager{numThreads};
+    auto r = BrushRenderer{taskManager};
+    benchValidate(r, fmt::format("with {} threads", numThreads));
+  }
+}
+
+TEST_CASE("BrushRendererBenchmark.benchCompaction")
+{
+  auto [brushes, materials] = makeBrushes();
+
+  auto rng = std::mt19937{42};
+  auto coin = std::uniform_int_distribution<size_t>{0, 9};
+
+  auto r = BrushRenderer{};
+  for (const auto& brush : brushes)
+  {
+    r.addBrush(brush.get());
+  }
+  r.validate();
+
+  // randomly remove and add brushes, then remove most of the remaining brushes
+  auto added = std::vector<bool>(brushes.size(), true);
+  timeLambda(
+    [&]() {
+      for (size_t round = 0; round < 20; ++round)
+      {
+        for (size_t i = 0; i < brushes.size(); ++i)
+        {
+          if (coin(rng) == 0)
+          {
+            if (added[i])
+            {
+              r.removeBrush(brushes[i].get());
+            }
+            else
+            {
+              r.addBrush(brushes[i].get());
+            }
+            added[i] = !added[i];
+          }
+        }
+        if (!r.valid())
+        {
+          r.validate();
+        }
+      }
+
+      for (size_t i = 0; i < brushes.size(); ++i)
+      {
+        if (added[i] && coin(rng) < 8)
+        {
+          r.removeBrush(brushes[i].get());
+          added[i] = false;
+        }
+      }
+      if (!r.valid())
+      {
+        r.validate();
+      }
+    },
+    "randomly add and remove brushes");
+
+  printStats(r, "before compaction");
+  CHECK(r.needsCompaction());
+
+  auto frames = size_t(0);
+  timeLambda(
+    [&]() {
+      while (!r.compact(std::chrono::milliseconds{1}))
+      {
+        ++frames;
+      }
+    },
+    "compact with a budget of 1ms per frame");
+
+  printf("compaction took %zu frames\n", frames + 1);
+  printStats(r, "after compaction");
+  CHECK_FALSE(r.needsCompaction());
+}
+
 } // namespace tb::render
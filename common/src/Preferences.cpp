@@ -186,6 +186,8 @@ Preference<Color> GridColor2D("Rendere/Grid/Color2D", Color(0.8f, 0.8f, 0.8f, 0.
 Preference<int> TextureMinFilter("render/Texture mode min filter", 0x2700);
 Preference<int> TextureMagFilter("render/Texture mode mag filter", 0x2600);
 Preference<bool> EnableMSAA("render/Enable multisampling", true);
+Preference<bool> EnableTextureCache("render/Enable texture cache", false);
+Preference<bool> LoadTexturesOnDemand("render/Load textures on demand", false);
 
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
@@ -381,6 +383,8 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &GridColor2D,
     &TextureMinFilter,
     &TextureMagFilter,
+    &EnableTextureCache,
+    &LoadTexturesOnDemand,
     &AlignmentLock,
     &UVLock,
     &RendererFontPath(),
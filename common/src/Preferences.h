@@ -130,6 +130,8 @@ extern Preference<Color> GridColor2D;
 extern Preference<int> TextureMinFilter;
 extern Preference<int> TextureMagFilter;
 extern Preference<bool> EnableMSAA;
+extern Preference<bool> EnableTextureCache;
+extern Preference<bool> LoadTexturesOnDemand;
 
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
@@ -24,8 +24,8 @@ namespace tb::el
 
 std::optional<ExpressionNode> EvaluationTrace::getExpression(const Value& value) const
 {
-  auto it = m_data.find(value);
-  return it != m_data.end() ? std::optional{it->second} : std::nullopt;
+  auto it = m_data.find(value.identity());
+  return it != m_data.end() ? std::optional{std::get<1>(it->second)} : std::nullopt;
 }
 
 std::optional<FileLocation> EvaluationTrace::getLocation(const Value& value) const
@@ -39,7 +39,10 @@ std::optional<FileLocation> EvaluationTrace::getLocation(const Value& value) con
 
 void EvaluationTrace::addTrace(const Value& value, const ExpressionNode& expression)
 {
-  m_data.emplace(value, expression);
+  if (const auto* identity = value.identity())
+  {
+    m_data.emplace(identity, std::tuple{value, expression});
+  }
 }
 
 } // namespace tb::el
@@ -24,15 +24,24 @@
 #include "el/Value.h"
 
 #include <optional>
+#include <tuple>
 #include <unordered_map>
 
 namespace tb::el
 {
 
+/**
+ * Records the expressions that produced the values of an evaluation.
+ *
+ * Values are traced by identity, so equal values produced by different expressions are
+ * told apart. The traced evaluation gives each value an identity, see
+ * Value::withIdentity(). Values without an identity are not traced.
+ */
 class EvaluationTrace
 {
 private:
-  std::unordered_map<Value, ExpressionNode> m_data;
+  // the value keeps its identity alive
+  std::unordered_map<const void*, std::tuple<Value, ExpressionNode>> m_data;
 
 public:
   std::optional<ExpressionNode> getExpression(const Value& value) const;
@@ -127,6 +127,12 @@ public:
 
   ExpressionNode optimize() const;
 
+  /**
+   * Returns the sorted names of the variables that this expression reads when it is
+   * evaluated.
+   */
+  std::vector<std::string> variableNames() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
@@ -31,6 +31,7 @@
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace tb::el
 {
@@ -41,87 +42,148 @@ const NullType NullType::Value = NullType{};
 UndefinedType::UndefinedType() = default;
 const UndefinedType UndefinedType::Value = UndefinedType{};
 
+namespace
+{
+
+template <typename T>
+struct IsSharedPtr : std::false_type
+{
+};
+
+template <typename T>
+struct IsSharedPtr<std::shared_ptr<T>> : std::true_type
+{
+};
+
+} // namespace
+
+template <typename F>
+decltype(auto) Value::visit(const F& f) const
+{
+  return std::visit(
+    [&](const auto& x) -> decltype(auto) {
+      if constexpr (IsSharedPtr<std::decay_t<decltype(x)>>::value)
+      {
+        return f(*x);
+      }
+      else
+      {
+        return f(x);
+      }
+    },
+    m_value);
+}
+
 const Value Value::Null = Value{NullType::Value};
 const Value Value::Undefined = Value{UndefinedType::Value};
 
 Value::Value()
-  : m_value{std::make_shared<VariantType>(NullType::Value)}
+  : m_value{NullType::Value}
 {
 }
 
 Value::Value(const BooleanType value)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
 {
 }
 
 Value::Value(StringType value)
-  : m_value{std::make_shared<VariantType>(std::move(value))}
+  : m_value{std::make_shared<const StringType>(std::move(value))}
 {
 }
 
 Value::Value(const char* value)
-  : m_value{std::make_shared<VariantType>(StringType(value))}
+  : m_value{std::make_shared<const StringType>(value)}
 {
 }
 
 Value::Value(const NumberType value)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
 {
 }
 
 Value::Value(const int value)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
 {
 }
 
 Value::Value(const long value)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
 {
 }
 
 Value::Value(const size_t value)
-  : m_value{std::make_shared<VariantType>(static_cast<NumberType>(value))}
+  : m_value{static_cast<NumberType>(value)}
 {
 }
 
 Value::Value(ArrayType value)
-  : m_value{std::make_shared<VariantType>(std::move(value))}
+  : m_value{std::make_shared<const ArrayType>(std::move(value))}
 {
 }
 
 Value::Value(MapType value)
-  : m_value{std::make_shared<VariantType>(std::move(value))}
+  : m_value{std::make_shared<const MapType>(std::move(value))}
 {
 }
 
 Value::Value(RangeType value)
-  : m_value{std::make_shared<VariantType>(std::move(value))}
+  : m_value{std::move(value)}
 {
 }
 
 Value::Value(NullType value)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
 {
 }
 
 Value::Value(UndefinedType value)
-  : m_value{std::make_shared<VariantType>(value)}
+  : m_value{value}
 {
 }
 
-ValueType Value::type() const
+Value Value::withIdentity() const
+{
+  auto result = *this;
+  std::visit(
+    [&](const auto& x) {
+      using T = std::decay_t<decltype(x)>;
+      if constexpr (!IsSharedPtr<T>::value)
+      {
+        result.m_value = std::make_shared<const T>(x);
+      }
+    },
+    m_value);
+  return result;
+}
+
+const void* Value::identity() const
 {
   return std::visit(
-    kdl::overload(
-      [](const BooleanType&) { return ValueType::Boolean; },
-      [](const StringType&) { return ValueType::String; },
-      [](const NumberType&) { return ValueType::Number; },
-      [](const ArrayType&) { return ValueType::Array; },
-      [](const MapType&) { return ValueType::Map; },
-      [](const RangeType&) { return ValueType::Range; },
-      [](const NullType&) { return ValueType::Null; },
-      [](const UndefinedType&) { return ValueType::Undefined; }),
-    *m_value);
+    [](const auto& x) -> const void* {
+      if constexpr (IsSharedPtr<std::decay_t<decltype(x)>>::value)
+      {
+        return x.get();
+      }
+      else
+      {
+        return nullptr;
+      }
+    },
+    m_value);
+}
+
+ValueType Value::type() const
+{
+  return visit(kdl::overload(
+    [](const BooleanType&) { return ValueType::Boolean; },
+    [](const StringType&) { return ValueType::String; },
+    [](const NumberType&) { return ValueType::Number; },
+    [](const ArrayType&) { return ValueType::Array; },
+    [](const MapType&) { return ValueType::Map; },
+    [](const RangeType&) { return ValueType::Range; },
+    [](const NullType&) { return ValueType::Null; },
+    [](const UndefinedType&) { return ValueType::Undefined; }));
 }
 
 bool Value::hasType(ValueType type) const
@@ -141,92 +203,86 @@ std::string Value::describe() const
 
 const BooleanType& Value::booleanValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType& b) -> const BooleanType& { return b; },
-      [&](const StringType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::String};
-      },
-      [&](const NumberType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::Number};
-      },
-      [&](const ArrayType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::Array};
-      },
-      [&](const MapType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::Map};
-      },
-      [&](const RangeType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::Range};
-      },
-      [&](const NullType&) -> const BooleanType& {
-        static const BooleanType b = false;
-        return b;
-      },
-      [&](const UndefinedType&) -> const BooleanType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType& b) -> const BooleanType& { return b; },
+    [&](const StringType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::String};
+    },
+    [&](const NumberType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::Number};
+    },
+    [&](const ArrayType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::Array};
+    },
+    [&](const MapType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::Map};
+    },
+    [&](const RangeType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::Range};
+    },
+    [&](const NullType&) -> const BooleanType& {
+      static const BooleanType b = false;
+      return b;
+    },
+    [&](const UndefinedType&) -> const BooleanType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 const StringType& Value::stringValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Boolean};
-      },
-      [&](const StringType& s) -> const StringType& { return s; },
-      [&](const NumberType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Number};
-      },
-      [&](const ArrayType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Array};
-      },
-      [&](const MapType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Map};
-      },
-      [&](const RangeType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Range};
-      },
-      [&](const NullType&) -> const StringType& {
-        static const StringType s;
-        return s;
-      },
-      [&](const UndefinedType&) -> const StringType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Boolean};
+    },
+    [&](const StringType& s) -> const StringType& { return s; },
+    [&](const NumberType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Number};
+    },
+    [&](const ArrayType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Array};
+    },
+    [&](const MapType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Map};
+    },
+    [&](const RangeType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Range};
+    },
+    [&](const NullType&) -> const StringType& {
+      static const StringType s;
+      return s;
+    },
+    [&](const UndefinedType&) -> const StringType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 const NumberType& Value::numberValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::Boolean};
-      },
-      [&](const StringType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::String};
-      },
-      [&](const NumberType& n) -> const NumberType& { return n; },
-      [&](const ArrayType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::Array};
-      },
-      [&](const MapType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::Map};
-      },
-      [&](const RangeType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::Range};
-      },
-      [&](const NullType&) -> const NumberType& {
-        static const NumberType n = 0.0;
-        return n;
-      },
-      [&](const UndefinedType&) -> const NumberType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::Boolean};
+    },
+    [&](const StringType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::String};
+    },
+    [&](const NumberType& n) -> const NumberType& { return n; },
+    [&](const ArrayType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::Array};
+    },
+    [&](const MapType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::Map};
+    },
+    [&](const RangeType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::Range};
+    },
+    [&](const NullType&) -> const NumberType& {
+      static const NumberType n = 0.0;
+      return n;
+    },
+    [&](const UndefinedType&) -> const NumberType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 IntegerType Value::integerValue() const
@@ -236,91 +292,85 @@ IntegerType Value::integerValue() const
 
 const ArrayType& Value::arrayValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::Boolean};
-      },
-      [&](const StringType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::String};
-      },
-      [&](const NumberType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::Number};
-      },
-      [&](const ArrayType& a) -> const ArrayType& { return a; },
-      [&](const MapType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::Map};
-      },
-      [&](const RangeType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::Range};
-      },
-      [&](const NullType&) -> const ArrayType& {
-        static const ArrayType a(0);
-        return a;
-      },
-      [&](const UndefinedType&) -> const ArrayType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::Boolean};
+    },
+    [&](const StringType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::String};
+    },
+    [&](const NumberType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::Number};
+    },
+    [&](const ArrayType& a) -> const ArrayType& { return a; },
+    [&](const MapType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::Map};
+    },
+    [&](const RangeType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::Range};
+    },
+    [&](const NullType&) -> const ArrayType& {
+      static const ArrayType a(0);
+      return a;
+    },
+    [&](const UndefinedType&) -> const ArrayType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 const MapType& Value::mapValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::Boolean};
-      },
-      [&](const StringType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::String};
-      },
-      [&](const NumberType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::Number};
-      },
-      [&](const ArrayType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::Array};
-      },
-      [&](const MapType& m) -> const MapType& { return m; },
-      [&](const RangeType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::Range};
-      },
-      [&](const NullType&) -> const MapType& {
-        static const MapType m;
-        return m;
-      },
-      [&](const UndefinedType&) -> const MapType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::Boolean};
+    },
+    [&](const StringType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::String};
+    },
+    [&](const NumberType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::Number};
+    },
+    [&](const ArrayType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::Array};
+    },
+    [&](const MapType& m) -> const MapType& { return m; },
+    [&](const RangeType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::Range};
+    },
+    [&](const NullType&) -> const MapType& {
+      static const MapType m;
+      return m;
+    },
+    [&](const UndefinedType&) -> const MapType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 const RangeType& Value::rangeValue() const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Boolean};
-      },
-      [&](const StringType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::String};
-      },
-      [&](const NumberType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Number};
-      },
-      [&](const ArrayType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Array};
-      },
-      [&](const MapType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Map};
-      },
-      [&](const RangeType& r) -> const RangeType& { return r; },
-      [&](const NullType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Null};
-      },
-      [&](const UndefinedType&) -> const RangeType& {
-        throw DereferenceError{describe(), type(), ValueType::Undefined};
-      }),
-    *m_value);
+  return visit(kdl::overload(
+    [&](const BooleanType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Boolean};
+    },
+    [&](const StringType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::String};
+    },
+    [&](const NumberType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Number};
+    },
+    [&](const ArrayType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Array};
+    },
+    [&](const MapType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Map};
+    },
+    [&](const RangeType& r) -> const RangeType& { return r; },
+    [&](const NullType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Null};
+    },
+    [&](const UndefinedType&) -> const RangeType& {
+      throw DereferenceError{describe(), type(), ValueType::Undefined};
+    }));
 }
 
 const std::vector<std::string> Value::asStringList() const
@@ -352,339 +402,333 @@ const std::vector<std::string> Value::asStringSet() const
 
 size_t Value::length() const
 {
-  return std::visit(
-    kdl::overload(
-      [](const BooleanType&) -> size_t { return 1u; },
-      [](const StringType& s) -> size_t { return s.length(); },
-      [](const NumberType&) -> size_t { return 1u; },
-      [](const ArrayType& a) -> size_t { return a.size(); },
-      [](const MapType& m) -> size_t { return m.size(); },
-      [](const RangeType&) -> size_t { return 2u; },
-      [](const NullType&) -> size_t { return 0u; },
-      [](const UndefinedType&) -> size_t { return 0u; }),
-    *m_value);
+  return visit(kdl::overload(
+    [](const BooleanType&) -> size_t { return 1u; },
+    [](const StringType& s) -> size_t { return s.length(); },
+    [](const NumberType&) -> size_t { return 1u; },
+    [](const ArrayType& a) -> size_t { return a.size(); },
+    [](const MapType& m) -> size_t { return m.size(); },
+    [](const RangeType&) -> size_t { return 2u; },
+    [](const NullType&) -> size_t { return 0u; },
+    [](const UndefinedType&) -> size_t { return 0u; }));
 }
 
 bool Value::convertibleTo(const ValueType toType) const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType&) {
-        switch (toType)
-        {
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-          return true;
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Undefined:
-        case ValueType::Null:
-          break;
-        }
+  return visit(kdl::overload(
+    [&](const BooleanType&) {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+        return true;
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Undefined:
+      case ValueType::Null:
+        break;
+      }
 
-        return false;
-      },
-      [&](const StringType& s) {
-        switch (toType)
+      return false;
+    },
+    [&](const StringType& s) {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+      case ValueType::String:
+        return true;
+      case ValueType::Number: {
+        if (kdl::str_is_blank(s))
         {
-        case ValueType::Boolean:
-        case ValueType::String:
-          return true;
-        case ValueType::Number: {
-          if (kdl::str_is_blank(s))
-          {
-            return true;
-          }
-          const char* begin = s.c_str();
-          char* end;
-          const NumberType value = std::strtod(begin, &end);
-          if (value == 0.0 && end == begin)
-          {
-            return false;
-          }
           return true;
         }
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
-
-        return false;
-      },
-      [&](const NumberType&) {
-        switch (toType)
+        const char* begin = s.c_str();
+        char* end;
+        const NumberType value = std::strtod(begin, &end);
+        if (value == 0.0 && end == begin)
         {
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-          return true;
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
+          return false;
         }
+        return true;
+      }
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      },
-      [&](const ArrayType&) {
-        switch (toType)
-        {
-        case ValueType::Array:
-          return true;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      return false;
+    },
+    [&](const NumberType&) {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+        return true;
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      },
-      [&](const MapType&) {
-        switch (toType)
-        {
-        case ValueType::Map:
-          return true;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Array:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      return false;
+    },
+    [&](const ArrayType&) {
+      switch (toType)
+      {
+      case ValueType::Array:
+        return true;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      },
-      [&](const RangeType&) {
-        switch (toType)
-        {
-        case ValueType::Range:
-          return true;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      return false;
+    },
+    [&](const MapType&) {
+      switch (toType)
+      {
+      case ValueType::Map:
+        return true;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Array:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      },
-      [&](const NullType&) {
-        switch (toType)
-        {
-        case ValueType::Boolean:
-        case ValueType::Null:
-        case ValueType::Number:
-        case ValueType::String:
-        case ValueType::Array:
-        case ValueType::Map:
-          return true;
-        case ValueType::Range:
-        case ValueType::Undefined:
-          break;
-        }
+      return false;
+    },
+    [&](const RangeType&) {
+      switch (toType)
+      {
+      case ValueType::Range:
+        return true;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      },
-      [&](const UndefinedType&) {
-        switch (toType)
-        {
-        case ValueType::Undefined:
-          return true;
-        case ValueType::Boolean:
-        case ValueType::Number:
-        case ValueType::String:
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-          break;
-        }
+      return false;
+    },
+    [&](const NullType&) {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+      case ValueType::Null:
+      case ValueType::Number:
+      case ValueType::String:
+      case ValueType::Array:
+      case ValueType::Map:
+        return true;
+      case ValueType::Range:
+      case ValueType::Undefined:
+        break;
+      }
 
-        return false;
-      }),
-    *m_value);
+      return false;
+    },
+    [&](const UndefinedType&) {
+      switch (toType)
+      {
+      case ValueType::Undefined:
+        return true;
+      case ValueType::Boolean:
+      case ValueType::Number:
+      case ValueType::String:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+        break;
+      }
+
+      return false;
+    }));
 }
 
 Value Value::convertTo(const ValueType toType) const
 {
-  return std::visit(
-    kdl::overload(
-      [&](const BooleanType& b) -> Value {
-        switch (toType)
-        {
-        case ValueType::Boolean:
-          return *this;
-        case ValueType::String:
-          return Value{b ? "true" : "false"};
-        case ValueType::Number:
-          return Value{b ? 1.0 : 0.0};
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Undefined:
-        case ValueType::Null:
-          break;
-        }
+  return visit(kdl::overload(
+    [&](const BooleanType& b) -> Value {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+        return *this;
+      case ValueType::String:
+        return Value{b ? "true" : "false"};
+      case ValueType::Number:
+        return Value{b ? 1.0 : 0.0};
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Undefined:
+      case ValueType::Null:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const StringType& s) -> Value {
-        switch (toType)
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const StringType& s) -> Value {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+        return Value{!kdl::cs::str_is_equal(s, "false") && !s.empty()};
+      case ValueType::String:
+        return *this;
+      case ValueType::Number: {
+        if (kdl::str_is_blank(s))
         {
-        case ValueType::Boolean:
-          return Value{!kdl::cs::str_is_equal(s, "false") && !s.empty()};
-        case ValueType::String:
-          return *this;
-        case ValueType::Number: {
-          if (kdl::str_is_blank(s))
-          {
-            return Value{0.0};
-          }
-          const char* begin = s.c_str();
-          char* end;
-          const NumberType value = std::strtod(begin, &end);
-          if (value == 0.0 && end == begin)
-          {
-            throw ConversionError{describe(), type(), toType};
-          }
-          return Value{value};
-        }
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
+          return Value{0.0};
         }
-
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const NumberType& n) -> Value {
-        switch (toType)
+        const char* begin = s.c_str();
+        char* end;
+        const NumberType value = std::strtod(begin, &end);
+        if (value == 0.0 && end == begin)
         {
-        case ValueType::Boolean:
-          return Value{n != 0.0};
-        case ValueType::String:
-          return Value{describe()};
-        case ValueType::Number:
-          return *this;
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
+          throw ConversionError{describe(), type(), toType};
         }
+        return Value{value};
+      }
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const ArrayType&) -> Value {
-        switch (toType)
-        {
-        case ValueType::Array:
-          return *this;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const NumberType& n) -> Value {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+        return Value{n != 0.0};
+      case ValueType::String:
+        return Value{describe()};
+      case ValueType::Number:
+        return *this;
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const MapType&) -> Value {
-        switch (toType)
-        {
-        case ValueType::Map:
-          return *this;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Array:
-        case ValueType::Range:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const ArrayType&) -> Value {
+      switch (toType)
+      {
+      case ValueType::Array:
+        return *this;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const RangeType&) -> Value {
-        switch (toType)
-        {
-        case ValueType::Range:
-          return *this;
-        case ValueType::Boolean:
-        case ValueType::String:
-        case ValueType::Number:
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Null:
-        case ValueType::Undefined:
-          break;
-        }
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const MapType&) -> Value {
+      switch (toType)
+      {
+      case ValueType::Map:
+        return *this;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Array:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const NullType&) -> Value {
-        switch (toType)
-        {
-        case ValueType::Boolean:
-          return Value{false};
-        case ValueType::Null:
-          return *this;
-        case ValueType::Number:
-          return Value{0.0};
-        case ValueType::String:
-          return Value{""};
-        case ValueType::Array:
-          return Value{ArrayType{0}};
-        case ValueType::Map:
-          return Value{MapType{}};
-        case ValueType::Range:
-        case ValueType::Undefined:
-          break;
-        }
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const RangeType&) -> Value {
+      switch (toType)
+      {
+      case ValueType::Range:
+        return *this;
+      case ValueType::Boolean:
+      case ValueType::String:
+      case ValueType::Number:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      },
-      [&](const UndefinedType&) -> Value {
-        switch (toType)
-        {
-        case ValueType::Undefined:
-          return *this;
-        case ValueType::Boolean:
-        case ValueType::Number:
-        case ValueType::String:
-        case ValueType::Array:
-        case ValueType::Map:
-        case ValueType::Range:
-        case ValueType::Null:
-          break;
-        }
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const NullType&) -> Value {
+      switch (toType)
+      {
+      case ValueType::Boolean:
+        return Value{false};
+      case ValueType::Null:
+        return *this;
+      case ValueType::Number:
+        return Value{0.0};
+      case ValueType::String:
+        return Value{""};
+      case ValueType::Array:
+        return Value{ArrayType{0}};
+      case ValueType::Map:
+        return Value{MapType{}};
+      case ValueType::Range:
+      case ValueType::Undefined:
+        break;
+      }
+
+      throw ConversionError{describe(), type(), toType};
+    },
+    [&](const UndefinedType&) -> Value {
+      switch (toType)
+      {
+      case ValueType::Undefined:
+        return *this;
+      case ValueType::Boolean:
+      case ValueType::Number:
+      case ValueType::String:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+        break;
+      }
 
-        throw ConversionError{describe(), type(), toType};
-      }),
-    *m_value);
+      throw ConversionError{describe(), type(), toType};
+    }));
 }
 
 std::optional<Value> Value::tryConvertTo(const ValueType toType) const
@@ -709,133 +753,131 @@ std::string Value::asString(const bool multiline) const
 void Value::appendToStream(
   std::ostream& str, const bool multiline, const std::string& indent) const
 {
-  std::visit(
-    kdl::overload(
-      [&](const BooleanType& b) { str << (b ? "true" : "false"); },
-      [&](const StringType& s) {
-        // Unescaping happens in io::ELParser::parseLiteral
-        str << "\"" << kdl::str_escape(s, "\\\"") << "\"";
-      },
-      [&](const NumberType& n) {
-        static constexpr auto RoundingThreshold = 0.00001;
-        if (std::abs(n - std::round(n)) < RoundingThreshold)
+  visit(kdl::overload(
+    [&](const BooleanType& b) { str << (b ? "true" : "false"); },
+    [&](const StringType& s) {
+      // Unescaping happens in io::ELParser::parseLiteral
+      str << "\"" << kdl::str_escape(s, "\\\"") << "\"";
+    },
+    [&](const NumberType& n) {
+      static constexpr auto RoundingThreshold = 0.00001;
+      if (std::abs(n - std::round(n)) < RoundingThreshold)
+      {
+        str.precision(0);
+        str.setf(std::ios::fixed);
+      }
+      else
+      {
+        str.precision(17);
+        str.unsetf(std::ios::fixed);
+      }
+      str << n;
+    },
+    [&](const ArrayType& a) {
+      if (a.empty())
+      {
+        str << "[]";
+      }
+      else
+      {
+        const std::string childIndent = multiline ? indent + "\t" : "";
+        str << "[";
+        if (multiline)
         {
-          str.precision(0);
-          str.setf(std::ios::fixed);
+          str << "\n";
         }
         else
         {
-          str.precision(17);
-          str.unsetf(std::ios::fixed);
+          str << " ";
         }
-        str << n;
-      },
-      [&](const ArrayType& a) {
-        if (a.empty())
+        for (size_t i = 0; i < a.size(); ++i)
         {
-          str << "[]";
-        }
-        else
-        {
-          const std::string childIndent = multiline ? indent + "\t" : "";
-          str << "[";
-          if (multiline)
-          {
-            str << "\n";
-          }
-          else
+          str << childIndent;
+          a[i].appendToStream(str, multiline, childIndent);
+          if (i < a.size() - 1)
           {
-            str << " ";
-          }
-          for (size_t i = 0; i < a.size(); ++i)
-          {
-            str << childIndent;
-            a[i].appendToStream(str, multiline, childIndent);
-            if (i < a.size() - 1)
+            str << ",";
+            if (!multiline)
             {
-              str << ",";
-              if (!multiline)
-              {
-                str << " ";
-              }
-            }
-            if (multiline)
-            {
-              str << "\n";
+              str << " ";
             }
           }
           if (multiline)
           {
-            str << indent;
-          }
-          else
-          {
-            str << " ";
+            str << "\n";
           }
-          str << "]";
         }
-      },
-      [&](const MapType& m) {
-        if (m.empty())
+        if (multiline)
         {
-          str << "{}";
+          str << indent;
         }
         else
         {
-          const std::string childIndent = multiline ? indent + "\t" : "";
-          str << "{";
-          if (multiline)
-          {
-            str << "\n";
-          }
-          else
-          {
-            str << " ";
-          }
+          str << " ";
+        }
+        str << "]";
+      }
+    },
+    [&](const MapType& m) {
+      if (m.empty())
+      {
+        str << "{}";
+      }
+      else
+      {
+        const std::string childIndent = multiline ? indent + "\t" : "";
+        str << "{";
+        if (multiline)
+        {
+          str << "\n";
+        }
+        else
+        {
+          str << " ";
+        }
 
-          size_t i = 0;
-          for (const auto& [key, value] : m)
+        size_t i = 0;
+        for (const auto& [key, value] : m)
+        {
+          str << childIndent << "\"" << key << "\""
+              << ": ";
+          value.appendToStream(str, multiline, childIndent);
+          if (i++ < m.size() - 1)
           {
-            str << childIndent << "\"" << key << "\""
-                << ": ";
-            value.appendToStream(str, multiline, childIndent);
-            if (i++ < m.size() - 1)
-            {
-              str << ",";
-              if (!multiline)
-              {
-                str << " ";
-              }
-            }
-            if (multiline)
+            str << ",";
+            if (!multiline)
             {
-              str << "\n";
+              str << " ";
             }
           }
           if (multiline)
           {
-            str << indent;
-          }
-          else
-          {
-            str << " ";
+            str << "\n";
           }
-          str << "}";
         }
-      },
-      [&](const RangeType& r) {
-        str << "[";
-        std::visit(
-          kdl::overload(
-            [&](const LeftBoundedRange& lbr) { str << lbr.first << ".."; },
-            [&](const RightBoundedRange& rbr) { str << ".." << rbr.last; },
-            [&](const BoundedRange& br) { str << br.first << ".." << br.last; }),
-          r);
-        str << "]";
-      },
-      [&](const NullType&) { str << "null"; },
-      [&](const UndefinedType&) { str << "undefined"; }),
-    *m_value);
+        if (multiline)
+        {
+          str << indent;
+        }
+        else
+        {
+          str << " ";
+        }
+        str << "}";
+      }
+    },
+    [&](const RangeType& r) {
+      str << "[";
+      std::visit(
+        kdl::overload(
+          [&](const LeftBoundedRange& lbr) { str << lbr.first << ".."; },
+          [&](const RightBoundedRange& rbr) { str << ".." << rbr.last; },
+          [&](const BoundedRange& br) { str << br.first << ".." << br.last; }),
+        r);
+      str << "]";
+    },
+    [&](const NullType&) { str << "null"; },
+    [&](const UndefinedType&) { str << "undefined"; }));
 }
 
 namespace
@@ -1264,31 +1306,30 @@ Value Value::operator[](const char* key) const
 
 bool operator==(const Value& lhs, const Value& rhs)
 {
-  return lhs.m_value == rhs.m_value
-         || std::visit(
-           kdl::overload(
-             [](const BooleanType& lhsBool, const BooleanType& rhsBool) {
-               return lhsBool == rhsBool;
-             },
-             [](const StringType& lhsString, const StringType& rhsString) {
-               return lhsString == rhsString;
-             },
-             [](const NumberType& lhsNumber, const NumberType& rhsNumber) {
-               return lhsNumber == rhsNumber;
-             },
-             [](const ArrayType& lhsArray, const ArrayType& rhsArray) {
-               return lhsArray == rhsArray;
-             },
-             [](
-               const MapType& lhsMap, const MapType& rhsMap) { return lhsMap == rhsMap; },
-             [](const RangeType& lhsRange, const RangeType& rhsRange) {
-               return lhsRange == rhsRange;
-             },
-             [](const NullType&, const NullType&) { return true; },
-             [](const UndefinedType&, const UndefinedType&) { return true; },
-             [](const auto&, const auto&) { return false; }),
-           *lhs.m_value,
-           *rhs.m_value);
+  return lhs.visit([&](const auto& lhsValue) {
+    return rhs.visit([&](const auto& rhsValue) {
+      return kdl::overload(
+        [](const BooleanType& lhsBool, const BooleanType& rhsBool) {
+          return lhsBool == rhsBool;
+        },
+        [](const StringType& lhsString, const StringType& rhsString) {
+          return lhsString == rhsString;
+        },
+        [](const NumberType& lhsNumber, const NumberType& rhsNumber) {
+          return lhsNumber == rhsNumber;
+        },
+        [](const ArrayType& lhsArray, const ArrayType& rhsArray) {
+          return lhsArray == rhsArray;
+        },
+        [](const MapType& lhsMap, const MapType& rhsMap) { return lhsMap == rhsMap; },
+        [](const RangeType& lhsRange, const RangeType& rhsRange) {
+          return lhsRange == rhsRange;
+        },
+        [](const NullType&, const NullType&) { return true; },
+        [](const UndefinedType&, const UndefinedType&) { return true; },
+        [](const auto&, const auto&) { return false; })(lhsValue, rhsValue);
+    });
+  });
 }
 
 bool operator!=(const Value& lhs, const Value& rhs)
@@ -55,19 +55,31 @@ public:
   static const UndefinedType Value;
 };
 
+/**
+ * An immutable EL value.
+ *
+ * Scalar values are stored inline unless they were given an identity, see
+ * withIdentity(). Strings, arrays and maps are shared between copies of a value, so
+ * copying a value never copies its contents.
+ */
 class Value
 {
 private:
   using VariantType = std::variant<
     BooleanType,
-    StringType,
+    std::shared_ptr<const StringType>,
     NumberType,
-    ArrayType,
-    MapType,
+    std::shared_ptr<const ArrayType>,
+    std::shared_ptr<const MapType>,
     RangeType,
     NullType,
-    UndefinedType>;
-  std::shared_ptr<VariantType> m_value;
+    UndefinedType,
+    std::shared_ptr<const BooleanType>,
+    std::shared_ptr<const NumberType>,
+    std::shared_ptr<const RangeType>,
+    std::shared_ptr<const NullType>,
+    std::shared_ptr<const UndefinedType>>;
+  VariantType m_value;
 
 public:
   static const Value Null;
@@ -88,6 +100,19 @@ public:
   explicit Value(NullType value);
   explicit Value(UndefinedType value);
 
+  /**
+   * Returns a copy of this value that can be told apart from equal values by its
+   * identity. Strings, arrays and maps already have an identity and are returned
+   * unchanged, scalars are moved to shared storage.
+   */
+  Value withIdentity() const;
+
+  /**
+   * Returns the address that identifies this value and all of its copies, or nullptr if
+   * this value is a scalar without an identity.
+   */
+  const void* identity() const;
+
   ValueType type() const;
 
   bool hasType(ValueType type) const;
@@ -137,17 +162,12 @@ public:
 
   friend std::ostream& operator<<(std::ostream& lhs, const Value& rhs);
 
-  friend struct std::hash<tb::el::Value>;
+private:
+  /**
+   * Calls the given function with the value, passing shared values by reference.
+   */
+  template <typename F>
+  decltype(auto) visit(const F& f) const;
 };
 
 } // namespace tb::el
-
-
-template <>
-struct std::hash<tb::el::Value>
-{
-  std::size_t operator()(const tb::el::Value& value) const noexcept
-  {
-    return std::hash<std::shared_ptr<tb::el::Value::VariantType>>{}(value.m_value);
-  }
-};
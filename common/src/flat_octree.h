@@ -0,0 +1,917 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Exceptions.h"
+#include "octree.h"
+
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/ray.h"
+#include "vm/scalar.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * An octree that allows for quick ray intersection queries. It uses the same node
+ * addressing scheme and returns the same query results as octree, but it stores all
+ * nodes in a single array and refers to child nodes by their index. The data of each
+ * node is stored in a contiguous span of a single data array.
+ *
+ * The tree can be built incrementally by inserting data one by one, or all at once from a
+ * list of bounds and data pairs using build, which places the nodes and their data in
+ * depth first order.
+ *
+ * @tparam T the floating point type
+ * @tparam U the node data to store in the nodes, must be default constructible
+ */
+template <typename T, typename U>
+class flat_octree
+{
+public:
+  using index_type = uint32_t;
+  static constexpr auto no_index = std::numeric_limits<index_type>::max();
+
+  struct node
+  {
+    detail::node_address address;
+    index_type parent;
+    std::array<index_type, 8> children;
+    index_type data_offset = 0;
+    index_type data_count = 0;
+    index_type data_capacity = 0;
+
+    node(const detail::node_address i_address, const index_type i_parent)
+      : address{i_address}
+      , parent{i_parent}
+    {
+      children.fill(no_index);
+    }
+  };
+
+private:
+  struct build_entry
+  {
+    detail::node_address address = {0, 0, 0, 0};
+    U data = {};
+    size_t bucket = 0;
+  };
+
+  struct subtree
+  {
+    size_t quadrant;
+    size_t first;
+    size_t last;
+    std::vector<node> nodes = {};
+    std::vector<U> data = {};
+  };
+
+  std::vector<node> m_nodes;
+  std::vector<index_type> m_free_nodes;
+  index_type m_root = no_index;
+
+  std::vector<U> m_data;
+  size_t m_unused_data_count = 0;
+
+  T m_min_size;
+  std::unordered_map<U, index_type> m_node_for_data;
+
+public:
+  explicit flat_octree(const T min_size)
+    : m_min_size{min_size}
+  {
+  }
+
+  /**
+   * Indicates whether a node with the given data exists in this tree.
+   *
+   * @param data the data to find
+   * @return true if a node with the given data exists and false otherwise
+   */
+  bool contains(const U& data) const { return m_node_for_data.count(data) > 0; }
+
+  void insert(const vm::bbox<T, 3>& bounds, U data)
+  {
+    check(bounds);
+
+    if (contains(data))
+    {
+      throw NodeTreeException("Data already in tree");
+    }
+
+    const auto address = detail::get_container(bounds, m_min_size);
+    if (m_root == no_index)
+    {
+      m_root = allocate_node(get_root_address(address), no_index);
+    }
+    else if (!m_nodes[m_root].address.contains(address))
+    {
+      // The children of the root remain within the corresponding quadrants of the new
+      // root because all root addresses are centered around the origin.
+      m_nodes[m_root].address = get_root_address(address);
+    }
+
+    const auto node_index = find_or_create_node(address);
+    m_node_for_data.emplace(data, node_index);
+    append_data(node_index, std::move(data));
+  }
+
+  /**
+   * Replaces the contents of this tree with the given data items.
+   *
+   * The tree is built top down by partitioning the items into the quadrants of each node
+   * in linear time, so the cost is O(n log n) for n items.
+   *
+   * @param items pairs of bounds and data to insert
+   *
+   * @throws NodeTreeException if any bounds are invalid or if any data is contained more
+   * than once, in which case this tree is left empty
+   */
+  void build(std::vector<std::pair<vm::bbox<T, 3>, U>> items)
+  {
+    build_tree(std::move(items), nullptr);
+  }
+
+  /**
+   * Replaces the contents of this tree with the given data items like the overload above,
+   * but computes the node addresses of the items and builds the subtrees of the quadrants
+   * of the root node in parallel using the given task manager.
+   *
+   * The resulting tree is identical to the one built without a task manager.
+   */
+  void build(
+    std::vector<std::pair<vm::bbox<T, 3>, U>> items, kdl::task_manager& task_manager)
+  {
+    build_tree(std::move(items), &task_manager);
+  }
+
+  /**
+   * Removes the node with the given data from this tree.
+   *
+   * @param data the data to remove
+   * @return true if a node with the given data was removed, and false otherwise
+   */
+  bool remove(const U& data)
+  {
+    const auto i_node_index = m_node_for_data.find(data);
+    if (i_node_index == m_node_for_data.end())
+    {
+      return false;
+    }
+
+    const auto node_index = i_node_index->second;
+    m_node_for_data.erase(i_node_index);
+
+    if (m_node_for_data.empty())
+    {
+      clear();
+      return true;
+    }
+
+    remove_data(node_index, data);
+    prune(node_index);
+    compact_data_if_necessary();
+
+    return true;
+  }
+
+  /**
+   * Updates the node with the given data with the given new bounds.
+   *
+   * @param newBounds the new bounds of the node
+   * @param data the node data of the node to update
+   *
+   * @throws NodeTreeException if no node with the given data can be found in this tree
+   */
+  void update(const vm::bbox<T, 3>& newBounds, const U& data)
+  {
+    check(newBounds);
+
+    if (!remove(data))
+    {
+      throw NodeTreeException("node not found");
+    }
+    insert(newBounds, data);
+  }
+
+  /**
+   * Clears this node tree.
+   */
+  void clear()
+  {
+    m_nodes.clear();
+    m_free_nodes.clear();
+    m_root = no_index;
+    m_data.clear();
+    m_unused_data_count = 0;
+    m_node_for_data.clear();
+  }
+
+  /**
+   * Indicates whether this tree is empty.
+   *
+   * @return true if this tree is empty and false otherwise
+   */
+  bool empty() const { return m_root == no_index; }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and returns a list of those items.
+   *
+   * @param ray the ray to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::ray<T, 3>& ray) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(ray, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param ray the ray to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::ray<T, 3>& ray, O out) const
+  {
+    if (m_root != no_index)
+    {
+      visit_node_if(
+        m_root,
+        [&](const auto& node) { copy_data(node, out); },
+        [&](const auto& address) {
+          const auto bounds = address.to_bounds(m_min_size);
+          return bounds.contains(ray.origin) || vm::intersect_ray_bbox(ray, bounds);
+        });
+    }
+  }
+
+  /**
+   * Visits the data items of the nodes intersected by the given ray in the order in which
+   * the ray enters the nodes. The visitor is called with each data item and returns the
+   * distance along the ray up to which the traversal must continue. The traversal stops
+   * once the ray enters all remaining nodes beyond the smallest distance returned so far.
+   *
+   * Since the bounds of every data item are contained in the bounds of its node, a
+   * visitor that returns the distance of the closest intersection found so far will see
+   * every data item that could yield a closer intersection.
+   *
+   * @tparam V the visitor type
+   * @param ray the ray to test
+   * @param visitor the visitor to call with each data item
+   */
+  template <typename V>
+  void visit_intersectors_in_order(const vm::ray<T, 3>& ray, const V& visitor) const
+  {
+    if (m_root == no_index)
+    {
+      return;
+    }
+
+    // a min heap of the nodes to visit, ordered by the distance at which the ray enters
+    // them
+    auto queue = std::vector<std::pair<T, index_type>>{};
+    const auto push = [&](const index_type node_index) {
+      if (const auto distance = entry_distance(ray, m_nodes[node_index].address))
+      {
+        queue.emplace_back(*distance, node_index);
+        std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+      }
+    };
+
+    auto max_distance = std::numeric_limits<T>::max();
+    push(m_root);
+    while (!queue.empty() && queue.front().first <= max_distance)
+    {
+      std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+      const auto& node = m_nodes[queue.back().second];
+      queue.pop_back();
+
+      for (auto i = node.data_offset; i < node.data_offset + node.data_count; ++i)
+      {
+        max_distance = std::min(max_distance, T(visitor(m_data[i])));
+      }
+
+      for (const auto child_index : node.children)
+      {
+        if (child_index != no_index)
+        {
+          push(child_index);
+        }
+      }
+    }
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and returns a list of those items.
+   *
+   * @param bbox the bbox to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::bbox<T, 3>& bbox) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(bbox, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param bbox the bbox to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
+  {
+    if (m_root != no_index)
+    {
+      visit_node_if(
+        m_root,
+        [&](const auto& node) { copy_data(node, out); },
+        [&](const auto& address) {
+          return bbox.intersects(address.to_bounds(m_min_size));
+        });
+    }
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * returns a list of those items.
+   *
+   * @param point the point to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_containers(const vm::vec<T, 3>& point) const
+  {
+    auto result = std::vector<U>{};
+    find_containers(point, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param point the point to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    if (m_root != no_index)
+    {
+      visit_node_if(
+        m_root,
+        [&](const auto& node) { copy_data(node, out); },
+        [&](const auto& address) {
+          return address.to_bounds(m_min_size).contains(point);
+        });
+    }
+  }
+
+private:
+  static detail::node_address get_root_address(const detail::node_address& address)
+  {
+    return detail::is_root(address) ? address : detail::get_root(address);
+  }
+
+  index_type allocate_node(const detail::node_address& address, const index_type parent)
+  {
+    if (!m_free_nodes.empty())
+    {
+      const auto node_index = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_nodes[node_index] = node{address, parent};
+      return node_index;
+    }
+
+    assert(m_nodes.size() < size_t(no_index));
+    m_nodes.emplace_back(address, parent);
+    return index_type(m_nodes.size() - 1);
+  }
+
+  void free_node(const index_type node_index)
+  {
+    auto& node = m_nodes[node_index];
+    assert(node.data_count == 0);
+
+    m_unused_data_count += node.data_capacity;
+    node.data_capacity = 0;
+    m_free_nodes.push_back(node_index);
+  }
+
+  /**
+   * Returns the index of the node that stores data with the given address, creating it
+   * and any container nodes if necessary. A node in a child slot may have an address that
+   * is smaller than the corresponding quadrant of its parent, so container nodes are only
+   * created where the paths to two addresses diverge.
+   */
+  index_type find_or_create_node(const detail::node_address& address)
+  {
+    auto node_index = m_root;
+    while (true)
+    {
+      const auto node_address = m_nodes[node_index].address;
+      assert(node_address.contains(address));
+
+      if (node_address == address)
+      {
+        return node_index;
+      }
+
+      const auto quadrant = detail::get_quadrant(node_address, address);
+      if (!quadrant)
+      {
+        return node_index;
+      }
+
+      const auto child_index = m_nodes[node_index].children[*quadrant];
+      if (child_index == no_index)
+      {
+        const auto new_child_index = allocate_node(address, node_index);
+        m_nodes[node_index].children[*quadrant] = new_child_index;
+        return new_child_index;
+      }
+
+      const auto child_address = m_nodes[child_index].address;
+      if (child_address.contains(address))
+      {
+        node_index = child_index;
+        continue;
+      }
+
+      const auto container_address = detail::get_container(child_address, address);
+      const auto child_quadrant = detail::get_quadrant(container_address, child_address);
+      assert(child_quadrant.has_value());
+
+      const auto container_index = allocate_node(container_address, node_index);
+      m_nodes[container_index].children[*child_quadrant] = child_index;
+      m_nodes[child_index].parent = container_index;
+      m_nodes[node_index].children[*quadrant] = container_index;
+      node_index = container_index;
+    }
+  }
+
+  void append_data(const index_type node_index, U data)
+  {
+    auto& node = m_nodes[node_index];
+    if (node.data_count == node.data_capacity)
+    {
+      const auto new_capacity = std::max(index_type(4), node.data_capacity * 2);
+      if (node.data_offset + node.data_capacity == m_data.size())
+      {
+        // the span is at the end of the data array, so it can grow in place
+        m_data.resize(node.data_offset + new_capacity);
+      }
+      else
+      {
+        const auto new_offset = m_data.size();
+        m_data.resize(new_offset + new_capacity);
+
+        const auto i_begin = std::next(m_data.begin(), node.data_offset);
+        std::move(
+          i_begin,
+          std::next(i_begin, node.data_count),
+          std::next(m_data.begin(), new_offset));
+
+        m_unused_data_count += node.data_capacity;
+        node.data_offset = index_type(new_offset);
+      }
+
+      assert(m_data.size() < size_t(no_index));
+      node.data_capacity = new_capacity;
+    }
+
+    m_data[node.data_offset + node.data_count] = std::move(data);
+    ++node.data_count;
+  }
+
+  void remove_data(const index_type node_index, const U& data)
+  {
+    auto& node = m_nodes[node_index];
+
+    const auto i_begin = std::next(m_data.begin(), node.data_offset);
+    const auto i_end = std::next(i_begin, node.data_count);
+    const auto i_data = std::find(i_begin, i_end, data);
+    assert(i_data != i_end);
+
+    // keep the remaining data in insertion order
+    std::move(std::next(i_data), i_end, i_data);
+    --node.data_count;
+  }
+
+  /**
+   * Removes the given node if it is empty and has no children, and replaces it with its
+   * child if it is empty and has only one child. The root node is never removed.
+   */
+  void prune(index_type node_index)
+  {
+    while (node_index != m_root)
+    {
+      const auto& node = m_nodes[node_index];
+      if (node.data_count > 0)
+      {
+        return;
+      }
+
+      const auto num_children = std::count_if(
+        node.children.begin(), node.children.end(), [](const auto child_index) {
+          return child_index != no_index;
+        });
+      if (num_children > 1)
+      {
+        return;
+      }
+
+      const auto parent_index = node.parent;
+      auto& parent = m_nodes[parent_index];
+      const auto i_slot =
+        std::find(parent.children.begin(), parent.children.end(), node_index);
+      assert(i_slot != parent.children.end());
+
+      if (num_children == 0)
+      {
+        *i_slot = no_index;
+        free_node(node_index);
+        node_index = parent_index;
+      }
+      else
+      {
+        const auto child_index = *std::find_if(
+          node.children.begin(), node.children.end(), [](const auto index) {
+            return index != no_index;
+          });
+        *i_slot = child_index;
+        m_nodes[child_index].parent = parent_index;
+        free_node(node_index);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Moves the data spans of all nodes into a new data array without gaps once more than
+   * half of the data array is unused.
+   */
+  void compact_data_if_necessary()
+  {
+    if (m_unused_data_count < 1024 || m_unused_data_count * 2 < m_data.size())
+    {
+      return;
+    }
+
+    auto data = std::vector<U>{};
+    data.reserve(m_data.size() - m_unused_data_count);
+
+    for (auto& node : m_nodes)
+    {
+      const auto i_begin = std::next(m_data.begin(), node.data_offset);
+      const auto new_offset = data.size();
+      std::move(i_begin, std::next(i_begin, node.data_count), std::back_inserter(data));
+
+      node.data_offset = index_type(new_offset);
+      node.data_capacity = node.data_count;
+    }
+
+    m_data = std::move(data);
+    m_unused_data_count = 0;
+  }
+
+  void build_tree(
+    std::vector<std::pair<vm::bbox<T, 3>, U>> items, kdl::task_manager* task_manager)
+  {
+    clear();
+    if (items.empty())
+    {
+      return;
+    }
+
+    const auto make_entry = [&](auto& item) {
+      check(item.first);
+      return build_entry{
+        detail::get_container(item.first, m_min_size), std::move(item.second)};
+    };
+
+    auto entries = std::vector<build_entry>{};
+    if (task_manager)
+    {
+      entries = task_manager->parallel_transform(items, make_entry);
+    }
+    else
+    {
+      entries.reserve(items.size());
+      for (auto& item : items)
+      {
+        entries.push_back(make_entry(item));
+      }
+    }
+
+    auto root_address = get_root_address(entries.front().address);
+    for (const auto& entry : entries)
+    {
+      const auto address = get_root_address(entry.address);
+      if (address.size > root_address.size)
+      {
+        root_address = address;
+      }
+    }
+
+    m_data.reserve(entries.size());
+
+    // The root node is built here, and the subtrees of its quadrants are built
+    // independently of each other and then appended to this tree.
+    auto scratch = std::vector<build_entry>(entries.size());
+    const auto bucket_offsets =
+      partition(root_address, entries, scratch, 0, entries.size());
+
+    m_root = add_node(m_nodes, m_data, root_address, no_index, scratch, bucket_offsets);
+
+    auto subtrees = std::vector<subtree>{};
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      const auto first = bucket_offsets[quadrant + 1];
+      const auto last = bucket_offsets[quadrant + 2];
+      if (first < last)
+      {
+        subtrees.push_back({quadrant, first, last});
+      }
+    }
+
+    const auto build_subtree = [&](subtree& s) {
+      build_node(s.nodes, s.data, scratch, entries, s.first, s.last, no_index);
+    };
+
+    if (task_manager)
+    {
+      task_manager->parallel_for(subtrees, build_subtree);
+    }
+    else
+    {
+      std::for_each(subtrees.begin(), subtrees.end(), build_subtree);
+    }
+
+    for (auto& s : subtrees)
+    {
+      m_nodes[m_root].children[s.quadrant] = append_subtree(s);
+    }
+
+    for (index_type node_index = 0; node_index < m_nodes.size(); ++node_index)
+    {
+      const auto& node = m_nodes[node_index];
+      for (auto i = node.data_offset; i < node.data_offset + node.data_count; ++i)
+      {
+        if (!m_node_for_data.emplace(m_data[i], node_index).second)
+        {
+          clear();
+          throw NodeTreeException("Data already in tree");
+        }
+      }
+    }
+  }
+
+  /**
+   * Distributes the entries in the given range of the given entry buffer into the same
+   * range of the given scratch buffer, sorted by the bucket they belong to. Bucket 0
+   * holds the entries stored in the node with the given address, and buckets 1 to 8 hold
+   * the entries stored in the subtrees of its quadrants.
+   *
+   * Returns the offset of each bucket and the end of the last bucket.
+   */
+  static std::array<size_t, 10> partition(
+    const detail::node_address& address,
+    std::vector<build_entry>& entries,
+    std::vector<build_entry>& scratch,
+    const size_t first,
+    const size_t last)
+  {
+    auto bucket_offsets = std::array<size_t, 10>{};
+    bucket_offsets.fill(first);
+
+    auto bucket_sizes = std::array<size_t, 9>{};
+    for (size_t i = first; i < last; ++i)
+    {
+      auto& entry = entries[i];
+      const auto quadrant = entry.address == address
+                              ? std::nullopt
+                              : detail::get_quadrant(address, entry.address);
+      entry.bucket = quadrant ? *quadrant + 1 : 0;
+      ++bucket_sizes[entry.bucket];
+    }
+
+    for (size_t i = 0; i < bucket_sizes.size(); ++i)
+    {
+      bucket_offsets[i + 1] = bucket_offsets[i] + bucket_sizes[i];
+    }
+
+    auto insert_offsets = bucket_offsets;
+    for (size_t i = first; i < last; ++i)
+    {
+      auto& entry = entries[i];
+      scratch[insert_offsets[entry.bucket]++] = std::move(entry);
+    }
+
+    return bucket_offsets;
+  }
+
+  /**
+   * Builds the node for the entries in the given range of the given entry buffer and
+   * returns its index.
+   */
+  static index_type build_node(
+    std::vector<node>& nodes,
+    std::vector<U>& data,
+    std::vector<build_entry>& entries,
+    std::vector<build_entry>& scratch,
+    const size_t first,
+    const size_t last,
+    const index_type parent)
+  {
+    // skip the nodes between the parent and the smallest node containing all entries
+    auto address = entries[first].address;
+    for (size_t i = first + 1; i < last; ++i)
+    {
+      address = detail::get_container(address, entries[i].address);
+    }
+
+    const auto bucket_offsets = partition(address, entries, scratch, first, last);
+    return build_node(nodes, data, address, parent, scratch, entries, bucket_offsets);
+  }
+
+  /**
+   * Builds the node with the given address and its children from the partitioned entries
+   * in the given entry buffer and returns its index.
+   */
+  static index_type build_node(
+    std::vector<node>& nodes,
+    std::vector<U>& data,
+    const detail::node_address& address,
+    const index_type parent,
+    std::vector<build_entry>& entries,
+    std::vector<build_entry>& scratch,
+    const std::array<size_t, 10>& bucket_offsets)
+  {
+    const auto node_index =
+      add_node(nodes, data, address, parent, entries, bucket_offsets);
+
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      const auto first = bucket_offsets[quadrant + 1];
+      const auto last = bucket_offsets[quadrant + 2];
+      if (first < last)
+      {
+        const auto child_index =
+          build_node(nodes, data, entries, scratch, first, last, node_index);
+        nodes[node_index].children[quadrant] = child_index;
+      }
+    }
+
+    return node_index;
+  }
+
+  /**
+   * Adds a node with the given address and the data of the first bucket of the given
+   * partitioned entries and returns its index.
+   */
+  static index_type add_node(
+    std::vector<node>& nodes,
+    std::vector<U>& data,
+    const detail::node_address& address,
+    const index_type parent,
+    std::vector<build_entry>& entries,
+    const std::array<size_t, 10>& bucket_offsets)
+  {
+    assert(nodes.size() < size_t(no_index));
+    const auto node_index = index_type(nodes.size());
+    nodes.emplace_back(address, parent);
+
+    const auto first = bucket_offsets[0];
+    const auto last = bucket_offsets[1];
+    auto& node = nodes[node_index];
+    node.data_offset = index_type(data.size());
+    node.data_count = index_type(last - first);
+    node.data_capacity = node.data_count;
+    for (size_t i = first; i < last; ++i)
+    {
+      data.push_back(std::move(entries[i].data));
+    }
+
+    return node_index;
+  }
+
+  /**
+   * Appends the nodes and data of the given subtree to this tree and returns the index of
+   * its root node.
+   */
+  index_type append_subtree(subtree& s)
+  {
+    const auto node_offset = index_type(m_nodes.size());
+    const auto data_offset = index_type(m_data.size());
+    assert(m_nodes.size() + s.nodes.size() < size_t(no_index));
+    assert(m_data.size() + s.data.size() < size_t(no_index));
+
+    for (auto& node : s.nodes)
+    {
+      node.parent = node.parent == no_index ? m_root : node.parent + node_offset;
+      for (auto& child_index : node.children)
+      {
+        if (child_index != no_index)
+        {
+          child_index += node_offset;
+        }
+      }
+      node.data_offset += data_offset;
+      m_nodes.push_back(node);
+    }
+
+    std::move(s.data.begin(), s.data.end(), std::back_inserter(m_data));
+    return node_offset;
+  }
+
+  template <typename Visitor, typename Predicate>
+  void visit_node_if(
+    const index_type node_index, const Visitor& visitor, const Predicate& predicate) const
+  {
+    const auto& node = m_nodes[node_index];
+    if (predicate(node.address))
+    {
+      visitor(node);
+      for (const auto child_index : node.children)
+      {
+        if (child_index != no_index)
+        {
+          visit_node_if(child_index, visitor, predicate);
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns the distance at which the given ray enters the bounds of the node with the
+   * given address, or nullopt if the ray misses the node.
+   */
+  std::optional<T> entry_distance(
+    const vm::ray<T, 3>& ray, const detail::node_address& address) const
+  {
+    const auto bounds = address.to_bounds(m_min_size);
+    return bounds.contains(ray.origin) ? std::optional{T(0)}
+                                       : vm::intersect_ray_bbox(ray, bounds);
+  }
+
+  template <typename O>
+  void copy_data(const node& node, O& out) const
+  {
+    const auto i_begin = std::next(m_data.begin(), node.data_offset);
+    out = std::copy(i_begin, std::next(i_begin, node.data_count), out);
+  }
+
+  void check(const vm::bbox<T, 3>& bounds) const
+  {
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to octree with invalid bounds");
+    }
+  }
+};
+
+} // namespace tb
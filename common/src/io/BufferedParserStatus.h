@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "io/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Records the messages logged to it so that they can be passed on to another status
+ * later. This allows parsing on a worker thread while keeping the order of the messages
+ * deterministic.
+ *
+ * The messages are formatted using the prefix of the target status. Progress updates are
+ * discarded.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  std::vector<std::tuple<LogLevel, std::string>> m_messages;
+
+public:
+  explicit BufferedParserStatus(const ParserStatus& target);
+
+  /**
+   * Passes all recorded messages to the given status in the order in which they were
+   * logged and clears the recorded messages.
+   */
+  void flush(ParserStatus& target);
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+
+} // namespace tb::io
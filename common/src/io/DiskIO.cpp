@@ -31,6 +31,11 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace tb::io::Disk
 {
 namespace
@@ -45,6 +50,87 @@ bool doCheckCaseSensitive()
          || !std::filesystem::exists(kdl::str_to_upper(cwd.string()));
 }
 
+/**
+ * The entries of a directory, indexed by their lower case names.
+ */
+struct DirectoryListing
+{
+  std::filesystem::file_time_type modificationTime;
+  std::unordered_map<std::filesystem::path::string_type, std::filesystem::path> entries;
+};
+
+/**
+ * Caches the listings of the directories visited by fixCase. A listing is reused until
+ * the modification time of its directory changes or the cache is cleared.
+ */
+class DirectoryListingCache
+{
+private:
+  std::mutex m_mutex;
+  std::unordered_map<
+    std::filesystem::path::string_type,
+    std::shared_ptr<const DirectoryListing>>
+    m_listings;
+
+public:
+  std::shared_ptr<const DirectoryListing> listing(const std::filesystem::path& path)
+  {
+    auto error = std::error_code{};
+    const auto modificationTime = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+      return nullptr;
+    }
+
+    {
+      auto guard = std::lock_guard{m_mutex};
+      if (const auto it = m_listings.find(path.native());
+          it != m_listings.end() && it->second->modificationTime == modificationTime)
+      {
+        return it->second;
+      }
+    }
+
+    auto listing = std::make_shared<DirectoryListing>();
+    listing->modificationTime = modificationTime;
+    for (auto it = std::filesystem::directory_iterator{path, error};
+         !error && it != std::filesystem::directory_iterator{};
+         it.increment(error))
+    {
+      auto name = it->path().filename();
+      listing->entries.emplace(kdl::path_to_lower(name).native(), std::move(name));
+    }
+
+    if (error)
+    {
+      return nullptr;
+    }
+
+    // The modification time has a limited resolution, so a directory that was modified
+    // very recently could change again without its modification time changing.
+    if (
+      modificationTime
+      < std::filesystem::file_time_type::clock::now() - std::chrono::seconds{2})
+    {
+      auto guard = std::lock_guard{m_mutex};
+      m_listings[path.native()] = listing;
+    }
+    return listing;
+  }
+
+  void clear()
+  {
+    auto guard = std::lock_guard{m_mutex};
+    m_listings.clear();
+  }
+};
+
+DirectoryListingCache& directoryListingCache()
+{
+  static auto cache = DirectoryListingCache{};
+  return cache;
+}
+
 std::filesystem::path fixCase(const std::filesystem::path& path)
 {
   try
@@ -62,19 +148,19 @@ std::filesystem::path fixCase(const std::filesystem::path& path)
     while (!remainder.empty())
     {
       const auto nameToFind = kdl::path_front(remainder);
-      const auto entryIt = std::find_if(
-        std::filesystem::directory_iterator{result},
-        std::filesystem::directory_iterator{},
-        [&](const auto& entry) {
-          return nameToFind == kdl::path_to_lower(entry.path().filename());
-        });
-
-      if (entryIt == std::filesystem::directory_iterator{})
+      const auto listing = directoryListingCache().listing(result);
+      if (!listing)
+      {
+        return path;
+      }
+
+      const auto entryIt = listing->entries.find(nameToFind.native());
+      if (entryIt == listing->entries.end())
       {
         return path;
       }
 
-      result = result / entryIt->path().filename();
+      result = result / entryIt->second;
       remainder = kdl::path_pop_front(remainder);
     }
     return result;
@@ -107,6 +193,11 @@ std::filesystem::path fixPath(const std::filesystem::path& path)
   return fixCase(path.lexically_normal());
 }
 
+void clearDirectoryCache()
+{
+  directoryListingCache().clear();
+}
+
 PathInfo pathInfo(const std::filesystem::path& path)
 {
   return pathInfoForFixedPath(fixPath(path));
@@ -157,7 +248,8 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, const FileMapping mapping)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
@@ -165,7 +257,7 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
     return Error{fmt::format("Failed to open {}: path does not denote a file", path)};
   }
 
-  return createCFile(fixedPath);
+  return createCFile(fixedPath, mapping);
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
@@ -41,8 +41,20 @@ namespace Disk
 {
 bool isCaseSensitive();
 
+/**
+ * Normalizes the given path and, if the file system is case sensitive and the path does
+ * not exist, resolves its components case insensitively.
+ *
+ * The directory listings needed to resolve the path components are cached and reused
+ * until the modification time of the directory changes.
+ */
 std::filesystem::path fixPath(const std::filesystem::path& path);
 
+/**
+ * Clears the directory listings cached by fixPath.
+ */
+void clearDirectoryCache();
+
 PathInfo pathInfo(const std::filesystem::path& path);
 
 Result<std::vector<std::filesystem::path>> find(
@@ -50,7 +62,12 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+/**
+ * Opens the file at the given path. The file contents are mapped into memory unless
+ * requested otherwise, see FileMapping for the risks of mapping a file.
+ */
+Result<std::shared_ptr<CFile>> openFile(
+  const std::filesystem::path& path, FileMapping mapping = FileMapping::Mapped);
 
 template <typename Stream, typename F>
 auto withStream(
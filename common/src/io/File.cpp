@@ -27,6 +27,13 @@
 #include <cstdio>
 #include <cstring>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
 namespace tb::io
 {
 
@@ -102,11 +109,59 @@ Result<size_t> fileSize(std::FILE* file)
 
   return static_cast<size_t>(size);
 }
+
+/**
+ * Maps the contents of the given file into memory. Returns null if the file cannot be
+ * mapped, e.g. because it is empty.
+ */
+CFile::BufferType mapFile(std::FILE* file, const size_t size)
+{
+  if (size == 0)
+  {
+    return nullptr;
+  }
+
+#ifdef _WIN32
+  auto* handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+
+  auto* mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+
+  // the view keeps the mapping object alive
+  auto* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+  CloseHandle(mapping);
+  if (!data)
+  {
+    return nullptr;
+  }
+
+  return CFile::BufferType{
+    static_cast<char*>(data), [](char* view) { UnmapViewOfFile(view); }};
+#else
+  auto* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(file), 0);
+  if (data == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  return CFile::BufferType{
+    static_cast<char*>(data), [size](char* view) { munmap(view, size); }};
+#endif
+}
+
 } // namespace
 
-CFile::CFile(kdl::resource<std::FILE*> file, const size_t size)
+CFile::CFile(kdl::resource<std::FILE*> file, const size_t size, BufferType mapping)
   : m_file{std::move(file)}
   , m_size{size}
+  , m_mapping{std::move(mapping)}
 {
 }
 
@@ -125,8 +180,21 @@ std::FILE* CFile::file() const
   return *m_file;
 }
 
+bool CFile::isMapped() const
+{
+  return m_mapping != nullptr;
+}
+
 std::unique_ptr<OwningBufferFile> CFile::buffer() const
 {
+  if (m_mapping)
+  {
+    auto buffer = std::make_unique<char[]>(size());
+    std::memcpy(buffer.get(), m_mapping.get(), size());
+    return std::make_unique<OwningBufferFile>(std::move(buffer), size());
+  }
+
+  auto guard = std::lock_guard{m_mutex};
   if (std::fseek(file(), 0, SEEK_SET))
   {
     return nullptr;
@@ -141,6 +209,11 @@ std::unique_ptr<OwningBufferFile> CFile::buffer() const
   return std::make_unique<OwningBufferFile>(std::move(buffer), size());
 }
 
+const CFile::BufferType& CFile::mapping() const
+{
+  return m_mapping;
+}
+
 Result<void> CFile::read(char* val, const size_t position, const size_t size) const
 {
   auto guard = std::lock_guard{m_mutex};
@@ -185,12 +258,16 @@ Error CFile::makeError(const std::string& msg) const
                             : Error{fmt::format("{}: {}", msg, std::strerror(errno))};
 }
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, const FileMapping mapping)
 {
-  return openPathAsFILE(path, "rb") | kdl::and_then([](auto file) {
+  return openPathAsFILE(path, "rb") | kdl::and_then([&](auto file) {
            return fileSize(*file) | kdl::transform([&](auto size) {
+                    auto buffer = mapping == FileMapping::Mapped ? mapFile(*file, size)
+                                                                 : nullptr;
                     // NOLINTNEXTLINE
-                    return std::shared_ptr<CFile>{new CFile{std::move(file), size}};
+                    return std::shared_ptr<CFile>{
+                      new CFile{std::move(file), size, std::move(buffer)}};
                   });
          });
 }
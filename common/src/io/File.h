@@ -76,9 +76,29 @@ public:
   size_t size() const override;
 };
 
+/**
+ * Controls whether the contents of a physical file are mapped into memory.
+ *
+ * Files are mapped by default, including package files that remain open for as long as
+ * they are mounted. If another process truncates a mapped file while it is open,
+ * accessing the removed part crashes the process instead of failing with a read error.
+ * Callers that cannot accept this risk must opt into reading the file with stdio by
+ * passing Unmapped.
+ */
+enum class FileMapping
+{
+  Mapped,
+  Unmapped,
+};
+
 /**
  * A file that is backed by a physical file on the disk. The file is opened in the
  * constructor and closed in the destructor.
+ *
+ * If requested and possible, the file contents are mapped into memory. Readers then
+ * access the mapped memory directly without copying and without locking, and they share
+ * ownership of the mapping, so they remain valid after the file is destroyed. Otherwise,
+ * readers read the file using the C stdio functions.
  */
 class CFile : public File
 {
@@ -93,15 +113,18 @@ public:
 private:
   kdl::resource<std::FILE*> m_file;
   size_t m_size;
+  BufferType m_mapping;
   mutable std::mutex m_mutex;
 
   /**
-   * Creates a new file with the given file ptr and size in bytes.
+   * Creates a new file with the given file ptr and size in bytes. The given mapping may
+   * be null if the file could not be mapped into memory.
    */
-  CFile(kdl::resource<std::FILE*> file, size_t size);
+  CFile(kdl::resource<std::FILE*> file, size_t size, BufferType mapping);
 
 public:
-  friend Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+  friend Result<std::shared_ptr<CFile>> createCFile(
+    const std::filesystem::path& path, FileMapping mapping);
 
   Reader reader() const override;
   size_t size() const override;
@@ -111,18 +134,27 @@ public:
    */
   std::FILE* file() const;
 
+  /**
+   * Indicates whether the contents of this file are mapped into memory.
+   */
+  bool isMapped() const;
+
   std::unique_ptr<OwningBufferFile> buffer() const;
 
 private:
+  friend class Reader;
   friend class FileReaderSource;
 
+  const BufferType& mapping() const;
+
   Result<void> read(char* val, size_t position, size_t size) const;
   Result<BufferType> buffer(size_t position, size_t size) const;
 
   Error makeError(const std::string& msg) const;
 };
 
-Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
+Result<std::shared_ptr<CFile>> createCFile(
+  const std::filesystem::path& path, FileMapping mapping = FileMapping::Mapped);
 
 /**
  * A file that is backed by a portion of a physical file.
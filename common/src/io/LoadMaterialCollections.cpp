@@ -31,6 +31,7 @@
 #include "io/ReadMipTexture.h"
 #include "io/ReadWalTexture.h"
 #include "io/ResourceUtils.h"
+#include "io/TextureCache.h"
 #include "io/TraversalMode.h"
 #include "mdl/GameConfig.h"
 #include "mdl/MaterialCollection.h"
@@ -53,6 +54,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <memory>
 #include <string>
 
 namespace tb::io
@@ -74,6 +76,68 @@ std::optional<Result<mdl::Palette>> loadPalette(
          });
 }
 
+/**
+ * Returns a description of the inputs other than the texture file itself that affect how
+ * a texture is decoded.
+ */
+std::string makeTextureCacheContext(
+  const FileSystem& fs, const mdl::MaterialConfig& materialConfig)
+{
+  if (materialConfig.palette.empty())
+  {
+    return "";
+  }
+
+  if (const auto paletteKey = makeTextureCacheKey(fs, materialConfig.palette, ""))
+  {
+    return fmt::format(
+      "{}:{}:{}", paletteKey->location, paletteKey->size, paletteKey->modificationTime);
+  }
+  return materialConfig.palette.generic_string();
+}
+
+/**
+ * Wraps the given texture loader so that it returns a cached texture if the cache holds
+ * an up to date entry for the texture file, and stores every texture it loads otherwise.
+ */
+mdl::ResourceLoader<mdl::Texture> withTextureCache(
+  mdl::ResourceLoader<mdl::Texture> textureLoader,
+  const FileSystem& fs,
+  const std::filesystem::path& path,
+  const std::string& textureCacheContext,
+  const std::shared_ptr<const TextureCache>& textureCache)
+{
+  if (!textureCache)
+  {
+    return textureLoader;
+  }
+
+  return [&fs,
+          path,
+          textureCacheContext,
+          textureCache,
+          textureLoader = std::move(textureLoader)]() -> Result<mdl::Texture> {
+    const auto key = makeTextureCacheKey(fs, path, textureCacheContext);
+    if (key)
+    {
+      if (auto texture = textureCache->load(*key))
+      {
+        return std::move(*texture);
+      }
+    }
+
+    return textureLoader() | kdl::transform([&](auto texture) {
+             if (key)
+             {
+               // the cache is an optimization, so failing to store an entry is not an
+               // error
+               textureCache->store(*key, texture) | kdl::transform_error([](auto) {});
+             }
+             return texture;
+           });
+  };
+}
+
 bool shouldExclude(
   const std::string& materialName, const std::vector<std::string>& patterns)
 {
@@ -188,10 +252,12 @@ Result<mdl::Material> loadShaderMaterial(
   const mdl::Quake3Shader& shader,
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
-  const mdl::CreateTextureResource& createResource)
+  const mdl::CreateTextureResource& createResource,
+  const std::string& textureCacheContext,
+  const std::shared_ptr<const TextureCache>& textureCache)
 {
   return findShaderTexture(shader, fs, materialConfig) | kdl::transform([&](auto path_) {
-           return [&, path = std::move(path_)]() {
+           auto textureLoader = [&, path = path_]() {
              return fs.openFile(path) | kdl::and_then([&](auto file) {
                       auto reader = file->reader().buffer();
                       return readFreeImageTexture(reader).transform([](auto texture) {
@@ -200,6 +266,8 @@ Result<mdl::Material> loadShaderMaterial(
                       });
                     });
            };
+           return withTextureCache(
+             std::move(textureLoader), fs, path_, textureCacheContext, textureCache);
          })
          | kdl::transform([&](auto textureLoader) {
              const auto prefixLength = kdl::path_length(materialConfig.root);
@@ -321,6 +389,39 @@ Result<mdl::Texture> loadTexture(
     });
 }
 
+/**
+ * Reads the size of the given texture from its header if that is supported by the texture
+ * format without decoding the texture.
+ */
+std::optional<vm::vec2s> readTextureSize(
+  const std::filesystem::path& path,
+  const std::vector<std::filesystem::path>& extensions,
+  const FileSystem& fs)
+{
+  return findMaterialFile(fs, path, extensions)
+         | kdl::and_then([&](const auto& actualPath) -> Result<vm::vec2s> {
+             const auto extension = kdl::path_to_lower(actualPath.extension());
+             if (extension == ".d" || extension == ".c")
+             {
+               return fs.openFile(actualPath) | kdl::and_then([](auto file) {
+                        auto reader = file->reader();
+                        return readMipTextureSize(reader);
+                      });
+             }
+             else if (extension == ".wal")
+             {
+               return fs.openFile(actualPath) | kdl::and_then([](auto file) {
+                        auto reader = file->reader();
+                        return readWalTextureSize(reader);
+                      });
+             }
+             return Error{fmt::format("Cannot read size of {} files", extension)};
+           })
+         | kdl::transform([](auto size) { return std::optional{size}; })
+         | kdl::transform_error([](auto) { return std::optional<vm::vec2s>{}; })
+         | kdl::value();
+}
+
 mdl::ResourceLoader<mdl::Texture> makeTextureResourceLoader(
   const std::filesystem::path& path,
   const std::string& name,
@@ -341,7 +442,9 @@ Result<mdl::Material> loadTextureMaterial(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
-  const std::optional<Result<mdl::Palette>>& paletteResult)
+  const std::optional<Result<mdl::Palette>>& paletteResult,
+  const std::string& textureCacheContext,
+  const std::shared_ptr<const TextureCache>& textureCache)
 {
   const auto prefixLength = kdl::path_length(materialConfig.root);
   const auto pathMatcher = !materialConfig.extensions.empty()
@@ -349,10 +452,28 @@ Result<mdl::Material> loadTextureMaterial(
                              : matchAnyPath;
   auto name = getMaterialNameFromPathSuffix(texturePath, prefixLength);
 
-  auto textureLoader = makeTextureResourceLoader(
-    texturePath, name, materialConfig.extensions, fs, paletteResult);
+  auto textureLoader = withTextureCache(
+    makeTextureResourceLoader(
+      texturePath, name, materialConfig.extensions, fs, paletteResult),
+    fs,
+    texturePath,
+    textureCacheContext,
+    textureCache);
   auto textureResource = createResource(std::move(textureLoader));
-  return mdl::Material{std::move(name), std::move(textureResource)};
+  auto material = mdl::Material{std::move(name), std::move(textureResource)};
+
+  // Materials whose texture is loaded on demand need a size for the material browser
+  // layout before the texture is loaded.
+  if (material.textureResource().isDeferred())
+  {
+    if (const auto textureSize =
+          readTextureSize(texturePath, materialConfig.extensions, fs))
+    {
+      material.setTextureSize(*textureSize);
+    }
+  }
+
+  return material;
 }
 
 std::string materialCollectionName(
@@ -419,16 +540,15 @@ std::vector<mdl::MaterialCollection> groupMaterialsIntoCollections(
   });
 }
 
-} // namespace
-
-
 Result<mdl::Material> loadMaterial(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const std::filesystem::path& materialPath,
   const mdl::CreateTextureResource& createResource,
   const std::vector<mdl::Quake3Shader>& shaders,
-  const std::optional<Result<mdl::Palette>>& paletteResult)
+  const std::optional<Result<mdl::Palette>>& paletteResult,
+  const std::string& textureCacheContext,
+  const std::shared_ptr<const TextureCache>& textureCache)
 {
   const auto materialPathStem = kdl::path_remove_extension(materialPath);
   const auto iShader =
@@ -437,9 +557,21 @@ Result<mdl::Material> loadMaterial(
     });
 
   return (iShader != shaders.end()
-            ? loadShaderMaterial(*iShader, fs, materialConfig, createResource)
+            ? loadShaderMaterial(
+                *iShader,
+                fs,
+                materialConfig,
+                createResource,
+                textureCacheContext,
+                textureCache)
             : loadTextureMaterial(
-                materialPath, fs, materialConfig, createResource, paletteResult))
+                materialPath,
+                fs,
+                materialConfig,
+                createResource,
+                paletteResult,
+                textureCacheContext,
+                textureCache))
          | kdl::transform([&](auto material) {
              fs.makeAbsolute(materialPath)
                | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
@@ -451,14 +583,31 @@ Result<mdl::Material> loadMaterial(
            });
 }
 
+} // namespace
+
+Result<mdl::Material> loadMaterial(
+  const FileSystem& fs,
+  const mdl::MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
+  const mdl::CreateTextureResource& createResource,
+  const std::vector<mdl::Quake3Shader>& shaders,
+  const std::optional<Result<mdl::Palette>>& paletteResult)
+{
+  return loadMaterial(
+    fs, materialConfig, materialPath, createResource, shaders, paletteResult, "", nullptr);
+}
+
 Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
   kdl::task_manager& taskManager,
-  Logger& logger)
+  Logger& logger,
+  std::shared_ptr<const TextureCache> textureCache)
 {
   const auto paletteResult = loadPalette(fs, materialConfig);
+  const auto textureCacheContext =
+    textureCache ? makeTextureCacheContext(fs, materialConfig) : std::string{};
 
   return loadShaders(fs, materialConfig, taskManager, logger)
          | kdl::transform([&](auto shaders) {
@@ -478,7 +627,9 @@ Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
                                      materialPath,
                                      createResource,
                                      shaders,
-                                     paletteResult);
+                                     paletteResult,
+                                     textureCacheContext,
+                                     textureCache);
                                  })
                                | kdl::fold;
                       });
@@ -25,6 +25,7 @@
 #include "mdl/TextureResource.h"
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -48,6 +49,7 @@ struct MaterialConfig;
 namespace tb::io
 {
 class FileSystem;
+class TextureCache;
 
 Result<mdl::Material> loadMaterial(
   const FileSystem& fs,
@@ -62,6 +64,7 @@ Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
   kdl::task_manager& taskManager,
-  Logger& logger);
+  Logger& logger,
+  std::shared_ptr<const TextureCache> textureCache = nullptr);
 
 } // namespace tb::io
@@ -0,0 +1,296 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapFormatDetection.h"
+
+#include "Macros.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <ranges>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr auto MaxPrefixLength = size_t(1024 * 1024);
+
+enum class SampleType
+{
+  Face,
+  BrushPrimitiveFace,
+  BrushPrimitive,
+  Patch,
+};
+
+struct Sample
+{
+  SampleType type;
+  bool hasValveUVAxes = false;
+  size_t attributeCount = 0;
+};
+
+bool isBlank(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * Splits the given line into whitespace separated tokens. Quoted strings are returned as
+ * a single token, and a line comment ends the line.
+ */
+std::vector<std::string_view> splitLine(const std::string_view line)
+{
+  auto result = std::vector<std::string_view>{};
+
+  auto i = size_t(0);
+  while (i < line.size())
+  {
+    if (isBlank(line[i]))
+    {
+      ++i;
+      continue;
+    }
+
+    if (line.substr(i, 2) == "//" || line[i] == ';')
+    {
+      break;
+    }
+
+    const auto begin = i;
+    if (line[i] == '"')
+    {
+      ++i;
+      while (i < line.size() && (line[i] != '"' || line[i - 1] == '\\'))
+      {
+        ++i;
+      }
+      i = std::min(i + 1, line.size());
+    }
+    else
+    {
+      while (i < line.size() && !isBlank(line[i]))
+      {
+        ++i;
+      }
+    }
+    result.push_back(line.substr(begin, i - begin));
+  }
+
+  return result;
+}
+
+bool isDigit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool isNumber(const std::string_view token)
+{
+  const auto isNumberChar = [](const auto c) {
+    return isDigit(c) || c == '+' || c == '-' || c == '.' || c == 'e' || c == 'E';
+  };
+  return std::ranges::any_of(token, isDigit) && std::ranges::all_of(token, isNumberChar);
+}
+
+/**
+ * Consumes a list of `count` numbers enclosed in the given delimiters.
+ */
+bool consumeNumberList(
+  const std::vector<std::string_view>& tokens,
+  size_t& i,
+  const std::string_view open,
+  const size_t count,
+  const std::string_view close)
+{
+  if (
+    i + count + 2 > tokens.size() || tokens[i] != open || tokens[i + count + 1] != close)
+  {
+    return false;
+  }
+
+  for (size_t j = 0; j < count; ++j)
+  {
+    if (!isNumber(tokens[i + j + 1]))
+    {
+      return false;
+    }
+  }
+
+  i += count + 2;
+  return true;
+}
+
+std::optional<Sample> sampleLine(const std::string_view line)
+{
+  const auto tokens = splitLine(line);
+  if (tokens.empty())
+  {
+    return std::nullopt;
+  }
+
+  if (tokens.front() == "brushDef")
+  {
+    return Sample{SampleType::BrushPrimitive};
+  }
+
+  if (tokens.front() == "patchDef2")
+  {
+    return Sample{SampleType::Patch};
+  }
+
+  auto i = size_t(0);
+  for (size_t j = 0; j < 3; ++j)
+  {
+    if (!consumeNumberList(tokens, i, "(", 3, ")"))
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (i < tokens.size() && tokens[i] == "(")
+  {
+    return Sample{SampleType::BrushPrimitiveFace};
+  }
+
+  // the material name
+  if (++i > tokens.size())
+  {
+    return std::nullopt;
+  }
+
+  auto sample = Sample{SampleType::Face};
+  if (i < tokens.size() && tokens[i] == "[")
+  {
+    if (
+      !consumeNumberList(tokens, i, "[", 4, "]")
+      || !consumeNumberList(tokens, i, "[", 4, "]"))
+    {
+      return std::nullopt;
+    }
+    sample.hasValveUVAxes = true;
+  }
+
+  sample.attributeCount = tokens.size() - i;
+  return sample;
+}
+
+/**
+ * Returns whether a face with the given number of attributes after the material name and
+ * the optional UV axes can be parsed in a format with the given number of standard
+ * attributes and optional extra attributes.
+ */
+bool matchesAttributeCount(
+  const Sample& sample,
+  const size_t count,
+  const std::initializer_list<size_t> extraCounts = {})
+{
+  return sample.attributeCount == count
+         || std::ranges::any_of(extraCounts, [&](const auto extraCount) {
+              return sample.attributeCount == count + extraCount;
+            });
+}
+
+bool matches(const mdl::MapFormat format, const Sample& sample)
+{
+  switch (sample.type)
+  {
+  case SampleType::BrushPrimitive:
+  case SampleType::BrushPrimitiveFace:
+    return format == mdl::MapFormat::Quake3;
+  case SampleType::Patch:
+    return format == mdl::MapFormat::Quake3 || format == mdl::MapFormat::Quake3_Valve
+           || format == mdl::MapFormat::Quake3_Legacy;
+  case SampleType::Face:
+    break;
+    switchDefault();
+  }
+
+  switch (format)
+  {
+  case mdl::MapFormat::Standard:
+    return !sample.hasValveUVAxes && matchesAttributeCount(sample, 5);
+  case mdl::MapFormat::Valve:
+    return sample.hasValveUVAxes && matchesAttributeCount(sample, 3);
+  case mdl::MapFormat::Quake2:
+  case mdl::MapFormat::Quake3_Legacy:
+  case mdl::MapFormat::Quake3:
+    return !sample.hasValveUVAxes && matchesAttributeCount(sample, 5, {3});
+  case mdl::MapFormat::Quake2_Valve:
+  case mdl::MapFormat::Quake3_Valve:
+    return sample.hasValveUVAxes && matchesAttributeCount(sample, 3, {3});
+  case mdl::MapFormat::Hexen2:
+    return !sample.hasValveUVAxes && matchesAttributeCount(sample, 5, {1});
+  case mdl::MapFormat::Daikatana:
+    return !sample.hasValveUVAxes && matchesAttributeCount(sample, 5, {3, 6});
+  case mdl::MapFormat::Unknown:
+    return false;
+    switchDefault();
+  }
+}
+
+std::vector<Sample> collectSamples(std::string_view str, const size_t maxSampleCount)
+{
+  auto result = std::vector<Sample>{};
+
+  const auto truncated = str.size() > MaxPrefixLength;
+  str = str.substr(0, MaxPrefixLength);
+  while (!str.empty() && result.size() < maxSampleCount)
+  {
+    const auto lineEnd = str.find('\n');
+    if (lineEnd == std::string_view::npos && truncated)
+    {
+      // the last line of the prefix is incomplete
+      break;
+    }
+
+    if (const auto sample = sampleLine(str.substr(0, lineEnd)))
+    {
+      result.push_back(*sample);
+    }
+
+    str = lineEnd != std::string_view::npos ? str.substr(lineEnd + 1)
+                                            : std::string_view{};
+  }
+
+  return result;
+}
+
+} // namespace
+
+std::vector<mdl::MapFormat> rankMapFormats(
+  const std::string_view str,
+  const std::vector<mdl::MapFormat>& candidates,
+  const size_t maxSampleCount)
+{
+  const auto samples = collectSamples(str, maxSampleCount);
+  const auto countMismatches = [&](const auto format) {
+    return std::ranges::count_if(
+      samples, [&](const auto& sample) { return !matches(format, sample); });
+  };
+
+  auto result = candidates;
+  std::ranges::stable_sort(result, std::less<>{}, countMismatches);
+  return result;
+}
+
+} // namespace tb::io
@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/MapFormat.h"
+
+#include <string_view>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Ranks the given candidate formats by how well they match the given map without parsing
+ * it.
+ *
+ * Only a bounded prefix of the map is examined. It is scanned for up to
+ * `maxSampleCount` brush face lines and brush primitive or patch keywords. Each sample is
+ * matched against the syntax of the candidate formats, e.g., whether a face has Valve 220
+ * UV axes, Quake 2 surface attributes, or a Daikatana color.
+ *
+ * The returned vector contains the given candidates, ordered by the number of samples
+ * they don't match. Candidates with the same number of mismatches retain their relative
+ * order, so if no samples are found, the candidates are returned unchanged.
+ */
+std::vector<mdl::MapFormat> rankMapFormats(
+  std::string_view str,
+  const std::vector<mdl::MapFormat>& candidates,
+  size_t maxSampleCount = 32);
+
+} // namespace tb::io
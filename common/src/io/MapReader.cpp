@@ -22,6 +22,7 @@
 #include "Error.h" // IWYU pragma: keep
 #include "FileLocation.h"
 #include "Uuid.h"
+#include "io/BufferedParserStatus.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -46,9 +47,11 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <ostream>
+#include <ranges>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -70,21 +73,70 @@ auto getFilePosition(const T& info)
 
 } // namespace
 
+/**
+ * Parses a chunk of top level entities on a worker thread. The created object infos are
+ * merged into the object infos of the reader that owns the chunk.
+ */
+class MapReader::EntityChunkReader : public MapReader
+{
+public:
+  EntityChunkReader(
+    const EntityChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat,
+    mdl::EntityPropertyConfig entityPropertyConfig)
+    : MapReader{
+        chunk.str,
+        sourceMapFormat,
+        targetMapFormat,
+        std::move(entityPropertyConfig),
+        chunk.line,
+        chunk.column}
+  {
+  }
+
+  Result<std::vector<ObjectInfo>> read(ParserStatus& status)
+  {
+    return parseEntities(status)
+           | kdl::transform([&]() { return std::move(m_objectInfos); });
+  }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+};
+
 MapReader::MapReader(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat,
-  mdl::EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  mdl::EntityPropertyConfig entityPropertyConfig,
+  const size_t line,
+  const size_t column)
+  : StandardMapParser{str, sourceMapFormat, targetMapFormat, line, column}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
+void MapReader::setParallelParseChunkSize(const std::optional<size_t> chunkSize)
+{
+  m_parallelParseChunkSize = chunkSize;
+}
+
 Result<void> MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
   m_worldBounds = worldBounds;
-  return parseEntities(status)
+  return (m_parallelParseChunkSize
+            ? parseEntitiesInParallel(*m_parallelParseChunkSize, status, taskManager)
+            : parseEntities(status))
          | kdl::transform([&]() { createNodes(status, taskManager); });
 }
 
@@ -641,27 +693,23 @@ std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   kdl::task_manager& taskManager)
 {
   // create nodes in parallel, moving data out of objectInfos
-  // we store optionals in the result vector to make the elements default constructible,
-  // which is a requirement for parallel transform
-  auto tasks = objectInfos | std::views::transform([&](auto& objectInfo) {
-                 return std::function{[&]() -> CreateNodeResult {
-                   return std::visit(
-                     kdl::overload(
-                       [&](MapReader::EntityInfo& entityInfo) {
-                         return createNodeFromEntityInfo(
-                           entityPropertyConfig, std::move(entityInfo), mapFormat);
-                       },
-                       [&](MapReader::BrushInfo& brushInfo) {
-                         return createBrushNode(std::move(brushInfo), worldBounds);
-                       },
-                       [&](MapReader::PatchInfo& patchInfo) {
-                         return createPatchNode(std::move(patchInfo));
-                       }),
-                     objectInfo);
-                 }};
-               });
-
-  auto results = taskManager.run_tasks_and_wait(std::move(tasks));
+  auto results = taskManager.parallel_transform(
+    objectInfos, [&](MapReader::ObjectInfo& objectInfo) -> CreateNodeResult {
+      return std::visit(
+        kdl::overload(
+          [&](MapReader::EntityInfo& entityInfo) {
+            return createNodeFromEntityInfo(
+              entityPropertyConfig, std::move(entityInfo), mapFormat);
+          },
+          [&](MapReader::BrushInfo& brushInfo) {
+            return createBrushNode(std::move(brushInfo), worldBounds);
+          },
+          [&](MapReader::PatchInfo& patchInfo) {
+            return createPatchNode(std::move(patchInfo));
+          }),
+        objectInfo);
+    });
+
   return results | std::views::transform([&](auto& createNodeResult) {
            return std::move(createNodeResult)
                   | kdl::transform([&](NodeInfo&& nodeInfo) -> std::optional<NodeInfo> {
@@ -988,6 +1036,70 @@ void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager
   }
 }
 
+/**
+ * Splits the input into chunks of complete top level entities and parses the chunks in
+ * parallel. The messages logged while parsing a chunk are buffered and passed on to the
+ * given status in file order, and the parent indices of the object infos of each chunk
+ * are offset by the number of object infos of the preceding chunks.
+ *
+ * If any chunk fails to parse, then either the input is malformed or the chunks were not
+ * split at actual entity boundaries. In that case, all chunk results are discarded and the
+ * input is parsed serially so that the result and the diagnostics are the same as if the
+ * input had been parsed serially in the first place.
+ */
+Result<void> MapReader::parseEntitiesInParallel(
+  const size_t chunkSize, ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto chunks = splitIntoEntityChunks(m_str, chunkSize);
+  if (chunks.size() < 2)
+  {
+    return parseEntities(status);
+  }
+
+  struct ChunkResult
+  {
+    Result<std::vector<ObjectInfo>> objectInfos;
+    BufferedParserStatus status;
+  };
+
+  auto results = taskManager.parallel_transform(chunks, [&](const auto& chunk) {
+    auto chunkStatus = BufferedParserStatus{status};
+    auto reader = EntityChunkReader{
+      chunk, m_sourceMapFormat, m_targetMapFormat, m_entityPropertyConfig};
+    auto objectInfos = reader.read(chunkStatus);
+    return ChunkResult{std::move(objectInfos), std::move(chunkStatus)};
+  });
+  if (std::ranges::any_of(
+        results, [](const auto& result) { return result.objectInfos.is_error(); }))
+  {
+    return parseEntities(status);
+  }
+
+  for (auto& result : results)
+  {
+    result.status.flush(status);
+
+    const auto offset = m_objectInfos.size();
+    auto chunkObjectInfos = std::move(result.objectInfos) | kdl::value();
+    for (auto& objectInfo : chunkObjectInfos)
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](auto& brushOrPatchInfo) {
+            if (brushOrPatchInfo.parentIndex)
+            {
+              *brushOrPatchInfo.parentIndex += offset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  return kdl::void_success;
+}
+
 /**
  * Default implementation adds it to the current BrushInfo
  * Overridden in BrushFaceReader (which doesn't use m_brushInfos) to collect the faces
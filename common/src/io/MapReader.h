@@ -105,9 +105,19 @@ public: // only public so that helper methods can see these declarations
 
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
+  /**
+   * The default minimum size of the chunks that are parsed in parallel when reading
+   * entities.
+   */
+  static constexpr size_t DefaultParallelParseChunkSize = 1024 * 1024;
+
 private:
+  class EntityChunkReader;
+
+  std::string_view m_str;
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
+  std::optional<size_t> m_parallelParseChunkSize = DefaultParallelParseChunkSize;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -123,13 +133,32 @@ protected:
    * @param targetMapFormat the format to convert the created objects to
    * @param entityPropertyConfig the entity property config to use
    * if orphaned
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   MapReader(
     std::string_view str,
     mdl::MapFormat sourceMapFormat,
     mdl::MapFormat targetMapFormat,
-    mdl::EntityPropertyConfig entityPropertyConfig);
+    mdl::EntityPropertyConfig entityPropertyConfig,
+    size_t line = 1,
+    size_t column = 1);
+
+public:
+  /**
+   * Controls whether readEntities parses the input in parallel. If a chunk size is given,
+   * the input is split into chunks of complete top level entities of at least that size,
+   * and the chunks are parsed concurrently. The resulting objects and the diagnostics
+   * passed to the parser status are identical to parsing the input serially.
+   *
+   * Parallel parsing bypasses onBrushFace, so subclasses that override it must disable
+   * parallel parsing.
+   *
+   * Pass std::nullopt to always parse the input serially.
+   */
+  void setParallelParseChunkSize(std::optional<size_t> chunkSize);
 
+protected:
   /**
    * Attempts to parse as one or more entities.
    */
@@ -182,6 +211,8 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  Result<void> parseEntitiesInParallel(
+    size_t chunkSize, ParserStatus& status, kdl::task_manager& taskManager);
   void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
 
 private: // subclassing interface - these will be called in the order that nodes should be
@@ -95,6 +95,12 @@ void ParserStatus::errorAndThrow(const std::string& str)
   throw ParserException(buildMessage(str));
 }
 
+void ParserStatus::forwardLog(
+  ParserStatus& target, const LogLevel level, const std::string& str)
+{
+  target.doLog(level, str);
+}
+
 void ParserStatus::log(
   const LogLevel level, const FileLocation& location, const std::string& str)
 {
@@ -38,6 +38,7 @@ private:
 
 protected:
   ParserStatus(Logger& logger, std::string prefix);
+  ParserStatus(const ParserStatus& other) = default;
 
 public:
   virtual ~ParserStatus();
@@ -57,6 +58,12 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+protected:
+  /**
+   * Passes a fully built message to the log implementation of the given status.
+   */
+  static void forwardLog(ParserStatus& target, LogLevel level, const std::string& str);
+
 private:
   void log(LogLevel level, const FileLocation& location, const std::string& str);
   std::string buildMessage(const FileLocation& location, const std::string& str) const;
@@ -140,6 +140,28 @@ std::string readMipTextureName(Reader& reader)
   }
 }
 
+Result<vm::vec2s> readMipTextureSize(Reader& reader)
+{
+  try
+  {
+    reader.seekFromBegin(MipLayout::TextureNameLength);
+
+    const auto width = reader.readSize<int32_t>();
+    const auto height = reader.readSize<int32_t>();
+
+    if (!checkTextureDimensions(width, height))
+    {
+      return Error{fmt::format("Invalid texture dimensions: {}*{}", width, height)};
+    }
+
+    return vm::vec2s{width, height};
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
 Result<mdl::Texture> readIdMipTexture(
   Reader& reader, const mdl::Palette& palette, const mdl::TextureMask mask)
 {
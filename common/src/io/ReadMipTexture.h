@@ -21,6 +21,8 @@
 
 #include "Result.h"
 
+#include "vm/vec.h"
+
 #include <string>
 
 namespace tb::mdl
@@ -36,6 +38,12 @@ class Reader;
 
 std::string readMipTextureName(Reader& reader);
 
+/**
+ * Reads the dimensions of a Quake or Half-Life mip texture from its header without
+ * decoding the texture.
+ */
+Result<vm::vec2s> readMipTextureSize(Reader& reader);
+
 Result<mdl::Texture> readIdMipTexture(
   Reader& reader, const mdl::Palette& palette, mdl::TextureMask mask);
 
@@ -245,4 +245,37 @@ Result<mdl::Texture> readWalTexture(
   }
 }
 
+Result<vm::vec2s> readWalTextureSize(Reader& reader)
+{
+  try
+  {
+    const auto version = reader.readChar<char>();
+    reader.seekFromBegin(0);
+
+    if (version == 3)
+    {
+      // version, name and garbage, see readDkWal
+      reader.seekForward(1 + WalLayout::TextureNameLength + 3);
+    }
+    else
+    {
+      reader.seekForward(WalLayout::TextureNameLength);
+    }
+
+    const auto width = reader.readSize<uint32_t>();
+    const auto height = reader.readSize<uint32_t>();
+
+    if (!checkTextureDimensions(width, height))
+    {
+      return Error{fmt::format("Invalid texture dimensions: {}*{}", width, height)};
+    }
+
+    return vm::vec2s{width, height};
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
 } // namespace tb::io
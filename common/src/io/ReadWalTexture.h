@@ -22,6 +22,8 @@
 #include "Result.h"
 #include "mdl/Palette.h"
 
+#include "vm/vec.h"
+
 #include <optional>
 
 namespace tb::mdl
@@ -36,4 +38,10 @@ class Reader;
 Result<mdl::Texture> readWalTexture(
   Reader& reader, const std::optional<mdl::Palette>& palette);
 
+/**
+ * Reads the dimensions of a Quake 2 or Daikatana WAL texture from its header without
+ * decoding the texture.
+ */
+Result<vm::vec2s> readWalTextureSize(Reader& reader);
+
 } // namespace tb::io
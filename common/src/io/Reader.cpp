@@ -161,6 +161,13 @@ public:
   {
   }
 
+  std::shared_ptr<ReaderSource> subSource(
+    const size_t offset, const size_t length) const override
+  {
+    return std::make_shared<OwningBufferReaderSource>(
+      m_buffer, begin() + offset, begin() + offset + length);
+  }
+
   std::shared_ptr<BufferReaderSource> buffer() const override
   {
     return std::make_shared<OwningBufferReaderSource>(m_buffer, begin(), end());
@@ -235,6 +242,12 @@ Reader::~Reader() = default;
 
 Reader Reader::from(const CFile& file, const size_t size)
 {
+  if (const auto& mapping = file.mapping())
+  {
+    const auto* begin = mapping.get();
+    return Reader{
+      std::make_shared<OwningBufferReaderSource>(mapping, begin, begin + size)};
+  }
   return Reader{std::make_shared<FileReaderSource>(file, 0, size)};
 }
 
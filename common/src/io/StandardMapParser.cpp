@@ -24,6 +24,8 @@
 #include "mdl/BrushFace.h"
 #include "mdl/EntityProperties.h"
 
+#include "kdl/string_utils.h"
+
 #include "vm/vec.h"
 
 #include <string>
@@ -61,8 +63,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{tokenNames(), str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{tokenNames(), str, "\"", '\\', line, column}
 {
 }
 
@@ -71,6 +74,127 @@ void QuakeMapTokenizer::setSkipEol(bool skipEol)
   m_skipEol = skipEol;
 }
 
+bool QuakeMapTokenizer::readNumberList(
+  const QuakeMapToken::Type open,
+  const QuakeMapToken::Type close,
+  const std::span<double> values)
+{
+  const auto delimiter = [](const auto type) {
+    return type == QuakeMapToken::OParenthesis   ? '('
+           : type == QuakeMapToken::CParenthesis ? ')'
+           : type == QuakeMapToken::OBracket     ? '['
+           : type == QuakeMapToken::CBracket     ? ']'
+                                                 : char(0);
+  };
+
+  discardLeadingWhitespace();
+
+  const auto skipBlanks = [&](const char* c) {
+    while (!eof(c) && (*c == ' ' || *c == '\t'))
+    {
+      ++c;
+    }
+    return c;
+  };
+
+  const auto* c = curPos();
+  if (eof(c) || *c != delimiter(open))
+  {
+    return false;
+  }
+  ++c;
+
+  for (auto& value : values)
+  {
+    c = skipBlanks(c);
+    const auto* e = scanNumber(c);
+    if (!e)
+    {
+      return false;
+    }
+    value = kdl::str_to_double(std::string_view{c, size_t(e - c)}).value_or(0.0);
+    c = e;
+  }
+
+  c = skipBlanks(c);
+  if (eof(c) || *c != delimiter(close))
+  {
+    return false;
+  }
+  ++c;
+
+  // the list contains no line breaks and no escape characters
+  m_state.column += size_t(c - curPos());
+  m_state.cur = c;
+  m_state.escaped = false;
+  return true;
+}
+
+std::optional<double> QuakeMapTokenizer::readNumber()
+{
+  discardLeadingWhitespace();
+
+  const auto* c = curPos();
+  const auto* e = scanNumber(c);
+  if (!e)
+  {
+    return std::nullopt;
+  }
+
+  m_state.column += size_t(e - c);
+  m_state.cur = e;
+  m_state.escaped = false;
+  return kdl::str_to_double(std::string_view{c, size_t(e - c)}).value_or(0.0);
+}
+
+void QuakeMapTokenizer::discardLeadingWhitespace()
+{
+  discardWhile(m_skipEol ? std::string_view{Whitespace()} : std::string_view{" \t"});
+}
+
+/**
+ * Returns the end of the number starting at the given position, or nullptr if there is
+ * no number. Accepts exactly the numbers that emitToken returns as integer or decimal
+ * tokens.
+ */
+const char* QuakeMapTokenizer::scanNumber(const char* c) const
+{
+  const auto isDigit = [](const char x) { return x >= '0' && x <= '9'; };
+  const auto skipDigits = [&](const char* x) {
+    while (!eof(x) && isDigit(*x))
+    {
+      ++x;
+    }
+    return x;
+  };
+
+  if (eof(c) || !(*c == '+' || *c == '-' || *c == '.' || isDigit(*c)))
+  {
+    return nullptr;
+  }
+
+  if (*c != '.')
+  {
+    c = skipDigits(c + 1);
+  }
+
+  if (!eof(c) && *c == '.')
+  {
+    c = skipDigits(c + 1);
+  }
+
+  if (!eof(c) && (*c == 'e' || *c == 'E'))
+  {
+    ++c;
+    if (!eof(c) && (*c == '+' || *c == '-' || isDigit(*c)))
+    {
+      c = skipDigits(c + 1);
+    }
+  }
+
+  return eof(c) || isAnyOf(*c, NumberDelim()) ? c : nullptr;
+}
+
 QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
 {
   while (!eof())
@@ -168,14 +292,224 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
   return Token{QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column()};
 }
 
+namespace
+{
+
+/**
+ * Mirrors the character handling of QuakeMapTokenizer closely enough to find the
+ * boundaries of top level entities without creating any tokens.
+ */
+class EntityChunkScanner
+{
+private:
+  std::string_view m_str;
+  size_t m_pos = 0;
+  size_t m_line = 1;
+  size_t m_column = 1;
+
+public:
+  explicit EntityChunkScanner(const std::string_view str)
+    : m_str{str}
+  {
+  }
+
+  std::vector<EntityChunk> split(const size_t minChunkSize)
+  {
+    auto result = std::vector<EntityChunk>{};
+
+    auto chunkBegin = size_t(0);
+    auto chunkLine = size_t(1);
+    auto chunkColumn = size_t(1);
+    auto chunkHasEntity = false;
+    auto depth = size_t(0);
+
+    while (!eof())
+    {
+      switch (curChar())
+      {
+      case '/':
+        advance();
+        if (curChar() == '/')
+        {
+          advance();
+          if (curChar() == '/' && lookAhead() == ' ')
+          {
+            // a "/// " comment token, the remainder of the line is tokenized normally
+            advance();
+            break;
+          }
+          discardUntilEol();
+        }
+        break;
+      case ';':
+        discardUntilEol();
+        break;
+      case '"':
+        advance();
+        discardQuotedString();
+        break;
+      case '{':
+        if (!isBrace())
+        {
+          // a material name such as {grate which the parser reads as a string
+          discardWord();
+          break;
+        }
+        advance();
+        ++depth;
+        chunkHasEntity = true;
+        break;
+      case '}':
+        if (!isBrace())
+        {
+          discardWord();
+          break;
+        }
+        advance();
+        if (depth > 0 && --depth == 0 && m_pos - chunkBegin >= minChunkSize)
+        {
+          result.push_back(
+            EntityChunk{m_str.substr(chunkBegin, m_pos - chunkBegin), chunkLine, chunkColumn});
+          chunkBegin = m_pos;
+          chunkLine = m_line;
+          chunkColumn = m_column;
+          chunkHasEntity = false;
+        }
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+      case '(':
+      case ')':
+      case '[':
+      case ']':
+        advance();
+        break;
+      default:
+        discardWord();
+        break;
+      }
+    }
+
+    if (chunkBegin < m_str.size())
+    {
+      if (!chunkHasEntity && !result.empty())
+      {
+        // append trailing whitespace and comments to the last chunk
+        auto& lastChunk = result.back();
+        const auto lastChunkBegin = size_t(lastChunk.str.data() - m_str.data());
+        lastChunk.str = m_str.substr(lastChunkBegin);
+      }
+      else
+      {
+        result.push_back(EntityChunk{m_str.substr(chunkBegin), chunkLine, chunkColumn});
+      }
+    }
+
+    return result;
+  }
+
+private:
+  bool eof() const { return m_pos >= m_str.size(); }
+
+  char curChar() const { return !eof() ? m_str[m_pos] : 0; }
+
+  char lookAhead() const { return m_pos + 1 < m_str.size() ? m_str[m_pos + 1] : 0; }
+
+  static bool isWhitespace(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  /**
+   * Braces that are immediately followed by other characters are most likely part of a
+   * material name.
+   */
+  bool isBrace() const
+  {
+    const auto next = lookAhead();
+    return next == 0 || isWhitespace(next) || next == '{' || next == '}' || next == '"'
+           || next == '(';
+  }
+
+  void advance()
+  {
+    switch (curChar())
+    {
+    case '\r':
+      if (lookAhead() == '\n')
+      {
+        ++m_column;
+        break;
+      }
+      switchFallthrough();
+    case '\n':
+      ++m_line;
+      m_column = 1;
+      break;
+    default:
+      ++m_column;
+      break;
+    }
+    ++m_pos;
+  }
+
+  void discardUntilEol()
+  {
+    while (!eof() && curChar() != '\n' && curChar() != '\r')
+    {
+      advance();
+    }
+  }
+
+  void discardWord()
+  {
+    while (!eof() && !isWhitespace(curChar()))
+    {
+      advance();
+    }
+  }
+
+  void discardQuotedString()
+  {
+    auto escaped = false;
+    while (!eof() && (curChar() != '"' || escaped))
+    {
+      // see Tokenizer::readQuotedString
+      if (curChar() == '"' && escaped && (lookAhead() == '\n' || lookAhead() == '}'))
+      {
+        break;
+      }
+      escaped = curChar() == '\\' && !escaped;
+      advance();
+    }
+
+    if (!eof())
+    {
+      advance();
+    }
+  }
+};
+
+} // namespace
+
+std::vector<EntityChunk> splitIntoEntityChunks(
+  const std::string_view str, const size_t minChunkSize)
+{
+  return EntityChunkScanner{str}.split(minChunkSize);
+}
+
 const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
 const std::string StandardMapParser::PatchId = "patchDef2";
 
 StandardMapParser::StandardMapParser(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
-  const mdl::MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  const mdl::MapFormat targetMapFormat,
+  const size_t line,
+  const size_t column)
+  : m_tokenizer{str, line, column}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
@@ -772,6 +1106,10 @@ std::tuple<vm::vec3d, vm::vec3d> StandardMapParser::parsePrimitiveUVAxes(
 
 float StandardMapParser::parseFloat()
 {
+  if (const auto value = m_tokenizer.readNumber())
+  {
+    return static_cast<float>(*value);
+  }
   return m_tokenizer.nextToken(QuakeMapToken::Number).toFloat<float>();
 }
 
@@ -29,6 +29,9 @@
 
 #include "vm/vec.h"
 
+#include <array>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -67,14 +70,61 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
+  /**
+   * Reads a list of numbers enclosed in the given delimiters, such as "( 1 2 3 )", in a
+   * single pass without creating any tokens. The opening and closing delimiters must be
+   * either parentheses or brackets, and the elements must be separated by spaces or tabs.
+   *
+   * If the input does not have this shape, only leading whitespace is consumed and false
+   * is returned, so that the caller can fall back to regular tokenization, which also
+   * creates the appropriate error messages.
+   *
+   * The numbers are converted exactly as Token::toFloat would convert them.
+   */
+  bool readNumberList(
+    QuakeMapToken::Type open, QuakeMapToken::Type close, std::span<double> values);
+
+  /**
+   * Reads a single number without creating a token. Returns std::nullopt if the input
+   * does not start with a number, in which case only leading whitespace is consumed.
+   */
+  std::optional<double> readNumber();
+
 private:
+  void discardLeadingWhitespace();
+  const char* scanNumber(const char* c) const;
+
   Token emitToken() override;
 };
 
+/**
+ * A part of a map file that contains a sequence of complete top level entities.
+ */
+struct EntityChunk
+{
+  std::string_view str;
+  size_t line;
+  size_t column;
+};
+
+/**
+ * Splits the given string into chunks of complete top level entities so that the chunks
+ * can be parsed independently.
+ *
+ * The string is scanned for top level entity boundaries by tracking the brace depth while
+ * skipping quoted strings and comments. Every chunk except for the last one ends
+ * immediately after the closing brace of a top level entity and is at least
+ * `minChunkSize` characters long. The last chunk contains the remainder of the string.
+ *
+ * The scan is only a heuristic and does not validate the input, so callers must be
+ * prepared for chunks that do not parse successfully on their own.
+ */
+std::vector<EntityChunk> splitIntoEntityChunks(std::string_view str, size_t minChunkSize);
+
 class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
 private:
@@ -98,9 +148,15 @@ public:
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   StandardMapParser(
-    std::string_view str, mdl::MapFormat sourceMapFormat, mdl::MapFormat targetMapFormat);
+    std::string_view str,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat,
+    size_t line = 1,
+    size_t column = 1);
 
   ~StandardMapParser() override;
 
@@ -147,8 +203,17 @@ private:
   template <size_t S = 3, typename T = double>
   vm::vec<T, S> parseFloatVector(const QuakeMapToken::Type o, const QuakeMapToken::Type c)
   {
-    m_tokenizer.nextToken(o);
     vm::vec<T, S> vec;
+    if (auto values = std::array<double, S>{}; m_tokenizer.readNumberList(o, c, values))
+    {
+      for (size_t i = 0; i < S; i++)
+      {
+        vec[i] = static_cast<T>(values[i]);
+      }
+      return vec;
+    }
+
+    m_tokenizer.nextToken(o);
     for (size_t i = 0; i < S; i++)
     {
       vec[i] = m_tokenizer.nextToken(QuakeMapToken::Number).toFloat<T>();
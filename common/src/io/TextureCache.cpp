@@ -0,0 +1,415 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCache.h"
+
+#include "io/DiskIO.h"
+#include "io/FileSystem.h"
+#include "io/FileSystemMetadata.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/overload.h"
+#include "kdl/reflection_impl.h"
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+namespace tb::io
+{
+namespace TextureCacheLayout
+{
+constexpr auto Magic = std::string_view{"TBTC"};
+// Must be incremented whenever the layout or the decoded textures change, e.g. because
+// the way indexed textures are expanded or mipmaps are generated changed, so that
+// entries written by earlier versions are not reused.
+constexpr uint32_t Version = 2;
+constexpr uint8_t NoEmbeddedDefaults = 0;
+constexpr uint8_t Q2EmbeddedDefaults = 1;
+constexpr uint8_t MaskOff = 0;
+constexpr uint8_t MaskOn = 1;
+} // namespace TextureCacheLayout
+
+namespace
+{
+
+/**
+ * FNV-1a, used to derive a file name from a texture location. Unlike std::hash, the
+ * result does not depend on the standard library implementation.
+ */
+uint64_t hashLocation(const std::string_view location)
+{
+  auto hash = uint64_t(14695981039346656037u);
+  for (const auto c : location)
+  {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= uint64_t(1099511628211u);
+  }
+  return hash;
+}
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& stream, const std::string_view str)
+{
+  write(stream, uint32_t(str.size()));
+  stream.write(str.data(), std::streamsize(str.size()));
+}
+
+std::string readString(Reader& reader)
+{
+  const auto size = reader.readSize<uint32_t>();
+  return reader.readString(size);
+}
+
+mdl::EmbeddedDefaults readEmbeddedDefaults(Reader& reader)
+{
+  const auto type = reader.read<uint8_t, uint8_t>();
+  if (type == TextureCacheLayout::Q2EmbeddedDefaults)
+  {
+    const auto flags = reader.readInt<int32_t>();
+    const auto contents = reader.readInt<int32_t>();
+    const auto value = reader.readInt<int32_t>();
+    return mdl::Q2EmbeddedDefaults{flags, contents, value};
+  }
+  return mdl::NoEmbeddedDefaults{};
+}
+
+void writeEmbeddedDefaults(
+  std::ostream& stream, const mdl::EmbeddedDefaults& embeddedDefaults)
+{
+  std::visit(
+    kdl::overload(
+      [&](const mdl::NoEmbeddedDefaults&) {
+        write(stream, TextureCacheLayout::NoEmbeddedDefaults);
+      },
+      [&](const mdl::Q2EmbeddedDefaults& q2Defaults) {
+        write(stream, TextureCacheLayout::Q2EmbeddedDefaults);
+        write(stream, int32_t(q2Defaults.flags));
+        write(stream, int32_t(q2Defaults.contents));
+        write(stream, int32_t(q2Defaults.value));
+      }),
+    embeddedDefaults);
+}
+
+} // namespace
+
+kdl_reflect_impl(TextureCacheKey);
+
+std::optional<TextureCacheKey> makeTextureCacheKey(
+  const FileSystem& fs, const std::filesystem::path& path, const std::string_view context)
+{
+  auto diskPath = std::filesystem::path{};
+  auto location = std::string{};
+
+  if (const auto* metadata = fs.metadata(path, FileSystemMetadataKeys::ImageFilePath);
+      metadata && std::holds_alternative<std::filesystem::path>(*metadata))
+  {
+    diskPath = std::get<std::filesystem::path>(*metadata);
+    location = fmt::format("{}:{}", diskPath.generic_string(), path.generic_string());
+  }
+  else if (auto absPath = fs.makeAbsolute(path); absPath.is_success())
+  {
+    diskPath = std::move(absPath).value();
+    location = diskPath.generic_string();
+  }
+  else
+  {
+    return std::nullopt;
+  }
+
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(diskPath, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+
+  const auto modificationTime = std::filesystem::last_write_time(diskPath, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+
+  if (!context.empty())
+  {
+    location = fmt::format("{}|{}", location, context);
+  }
+
+  return TextureCacheKey{
+    std::move(location),
+    size,
+    std::int64_t(modificationTime.time_since_epoch().count()),
+  };
+}
+
+Result<mdl::Texture> readCachedTexture(Reader& reader, const TextureCacheKey& key)
+{
+  try
+  {
+    if (reader.readString(TextureCacheLayout::Magic.size()) != TextureCacheLayout::Magic)
+    {
+      return Error{"Unknown texture cache entry format"};
+    }
+
+    if (const auto version = reader.readUnsignedInt<uint32_t>();
+        version != TextureCacheLayout::Version)
+    {
+      return Error{fmt::format("Unknown texture cache entry version: {}", version)};
+    }
+
+    const auto location = readString(reader);
+    const auto size = reader.read<uint64_t, std::uintmax_t>();
+    const auto modificationTime = reader.read<int64_t, std::int64_t>();
+    if (
+      location != key.location || size != key.size
+      || modificationTime != key.modificationTime)
+    {
+      return Error{"Texture cache entry is out of date"};
+    }
+
+    const auto width = reader.readSize<uint32_t>();
+    const auto height = reader.readSize<uint32_t>();
+    if (width == 0 || height == 0)
+    {
+      return Error{fmt::format("Invalid texture dimensions: {}*{}", width, height)};
+    }
+
+    const auto averageColor = Color{reader.readVec<float, 4>()};
+    const auto format = GLenum(reader.readUnsignedInt<uint32_t>());
+    const auto mask = reader.read<uint8_t, uint8_t>() == TextureCacheLayout::MaskOn
+                        ? mdl::TextureMask::On
+                        : mdl::TextureMask::Off;
+    auto embeddedDefaults = readEmbeddedDefaults(reader);
+
+    const auto bufferCount = reader.readSize<uint32_t>();
+    auto buffers = mdl::TextureBufferList{};
+    buffers.reserve(bufferCount);
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+      const auto bufferSize = reader.readSize<uint64_t>();
+      if (!reader.canRead(bufferSize))
+      {
+        return Error{"Texture cache entry is truncated"};
+      }
+
+      auto& buffer = buffers.emplace_back(bufferSize);
+      reader.read(buffer.data(), bufferSize);
+    }
+
+    return mdl::Texture{
+      width,
+      height,
+      averageColor,
+      format,
+      mask,
+      std::move(embeddedDefaults),
+      std::move(buffers)};
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+Result<void> writeCachedTexture(
+  std::ostream& stream, const TextureCacheKey& key, const mdl::Texture& texture)
+{
+  const auto& buffers = texture.buffersIfLoaded();
+  if (buffers.empty())
+  {
+    return Error{"Texture is not loaded"};
+  }
+
+  stream.write(
+    TextureCacheLayout::Magic.data(), std::streamsize(TextureCacheLayout::Magic.size()));
+  write(stream, TextureCacheLayout::Version);
+
+  write(stream, std::string_view{key.location});
+  write(stream, uint64_t(key.size));
+  write(stream, int64_t(key.modificationTime));
+
+  write(stream, uint32_t(texture.width()));
+  write(stream, uint32_t(texture.height()));
+  for (size_t i = 0; i < 4; ++i)
+  {
+    write(stream, texture.averageColor()[i]);
+  }
+  write(stream, uint32_t(texture.format()));
+  write(
+    stream,
+    texture.mask() == mdl::TextureMask::On ? TextureCacheLayout::MaskOn
+                                           : TextureCacheLayout::MaskOff);
+  writeEmbeddedDefaults(stream, texture.embeddedDefaults());
+
+  write(stream, uint32_t(buffers.size()));
+  for (const auto& buffer : buffers)
+  {
+    write(stream, uint64_t(buffer.size()));
+    stream.write(
+      reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+  }
+
+  if (!stream)
+  {
+    return Error{"Failed to write texture cache entry"};
+  }
+  return kdl::void_success;
+}
+
+const std::uintmax_t TextureCache::DefaultMaxSize = std::uintmax_t(1024) * 1024 * 1024;
+
+TextureCache::TextureCache(std::filesystem::path directory, const std::uintmax_t maxSize)
+  : m_directory{std::move(directory)}
+  , m_maxSize{maxSize}
+{
+}
+
+const std::filesystem::path& TextureCache::directory() const
+{
+  return m_directory;
+}
+
+std::uintmax_t TextureCache::maxSize() const
+{
+  return m_maxSize;
+}
+
+std::optional<mdl::Texture> TextureCache::load(const TextureCacheKey& key) const
+{
+  const auto path = entryPath(key);
+  auto error = std::error_code{};
+  if (!std::filesystem::is_regular_file(path, error))
+  {
+    return std::nullopt;
+  }
+
+  return Disk::openFile(path) | kdl::and_then([&](auto file) {
+           auto reader = file->reader().buffer();
+           return readCachedTexture(reader, key);
+         })
+         | kdl::transform([&](auto texture) {
+             // mark the entry as recently used, failing to do so is not an error
+             std::filesystem::last_write_time(
+               path, std::filesystem::file_time_type::clock::now(), error);
+             return std::optional{std::move(texture)};
+           })
+         | kdl::transform_error([](auto) { return std::optional<mdl::Texture>{}; })
+         | kdl::value();
+}
+
+Result<void> TextureCache::store(
+  const TextureCacheKey& key, const mdl::Texture& texture) const
+{
+  static auto counter = std::atomic<uint64_t>{0};
+
+  // Write to a temporary file first so that concurrent readers never see a partially
+  // written entry.
+  const auto path = entryPath(key);
+  const auto tempPath =
+    std::filesystem::path{fmt::format("{}.{}.tmp", path.string(), counter++)};
+
+  return Disk::createDirectory(m_directory) | kdl::and_then([&](auto) {
+           return Disk::withOutputStream(
+             tempPath, std::ios::out | std::ios::binary, [&](auto& stream) {
+               return writeCachedTexture(stream, key, texture);
+             });
+         })
+         | kdl::and_then([&]() { return Disk::moveFile(tempPath, path); })
+         | kdl::or_else([&](auto e) -> Result<void> {
+             auto error = std::error_code{};
+             std::filesystem::remove(tempPath, error);
+             return e;
+           });
+}
+
+Result<void> TextureCache::evictEntries() const
+{
+  struct Entry
+  {
+    std::filesystem::path path;
+    std::uintmax_t size;
+    std::filesystem::file_time_type lastUsed;
+  };
+
+  auto error = std::error_code{};
+  if (!std::filesystem::is_directory(m_directory, error))
+  {
+    return kdl::void_success;
+  }
+
+  auto entries = std::vector<Entry>{};
+  auto totalSize = std::uintmax_t(0);
+  for (auto it = std::filesystem::directory_iterator{m_directory, error};
+       !error && it != std::filesystem::directory_iterator{};
+       it.increment(error))
+  {
+    if (it->path().extension() == ".tex")
+    {
+      auto entryError = std::error_code{};
+      const auto size = it->file_size(entryError);
+      const auto lastUsed = it->last_write_time(entryError);
+      if (!entryError)
+      {
+        entries.push_back(Entry{it->path(), size, lastUsed});
+        totalSize += size;
+      }
+    }
+  }
+
+  if (error)
+  {
+    return Error{fmt::format("Failed to list {}: {}", m_directory, error.message())};
+  }
+
+  std::ranges::sort(entries, std::less<>{}, &Entry::lastUsed);
+  for (auto it = entries.begin(); it != entries.end() && totalSize > m_maxSize; ++it)
+  {
+    // entries that are in use by another process may fail to be removed
+    if (std::filesystem::remove(it->path, error))
+    {
+      totalSize -= it->size;
+    }
+  }
+
+  return kdl::void_success;
+}
+
+std::filesystem::path TextureCache::entryPath(const TextureCacheKey& key) const
+{
+  return m_directory / fmt::format("{:016x}.tex", hashLocation(key.location));
+}
+
+} // namespace tb::io
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace tb::mdl
+{
+class Texture;
+}
+
+namespace tb::io
+{
+class FileSystem;
+class Reader;
+
+/**
+ * Identifies the source of a decoded texture.
+ *
+ * The location identifies the texture file and everything else that influences the
+ * decoded texture, such as the palette. The size and modification time identify the
+ * version of the file on disk that contains the texture. For textures that were loaded
+ * from an archive such as a WAD or PAK file, these refer to the archive.
+ */
+struct TextureCacheKey
+{
+  std::string location;
+  std::uintmax_t size = 0;
+  std::int64_t modificationTime = 0;
+
+  kdl_reflect_decl(TextureCacheKey, location, size, modificationTime);
+};
+
+/**
+ * Returns a key for the texture file at the given path of the given file system, or
+ * std::nullopt if the file is not backed by a file on disk.
+ *
+ * The given context is appended to the location of the key. It should describe any other
+ * input that affects the decoded texture.
+ */
+std::optional<TextureCacheKey> makeTextureCacheKey(
+  const FileSystem& fs, const std::filesystem::path& path, std::string_view context);
+
+/**
+ * Reads a texture that was previously written by writeCachedTexture. Returns an error if
+ * the data is malformed or if it was written for a key other than the given one.
+ */
+Result<mdl::Texture> readCachedTexture(Reader& reader, const TextureCacheKey& key);
+
+/**
+ * Writes the given texture to the given stream. The texture must be in the loaded state.
+ */
+Result<void> writeCachedTexture(
+  std::ostream& stream, const TextureCacheKey& key, const mdl::Texture& texture);
+
+/**
+ * Stores decoded textures in a directory on disk so that they don't have to be decoded
+ * again when they are loaded the next time.
+ *
+ * Every texture location maps to one file in the cache directory. The file records the
+ * full key, so a cache entry becomes stale as soon as the source file changes, and it is
+ * replaced when the texture is stored again.
+ *
+ * The size of the cache directory is limited by evicting the least recently used entries
+ * when evictEntries is called. Loading an entry updates its modification time to mark it
+ * as recently used.
+ *
+ * All functions can be called concurrently.
+ */
+class TextureCache
+{
+private:
+  std::filesystem::path m_directory;
+  std::uintmax_t m_maxSize;
+
+public:
+  static const std::uintmax_t DefaultMaxSize;
+
+  explicit TextureCache(
+    std::filesystem::path directory, std::uintmax_t maxSize = DefaultMaxSize);
+
+  const std::filesystem::path& directory() const;
+  std::uintmax_t maxSize() const;
+
+  /**
+   * Returns the cached texture for the given key or std::nullopt if the cache does not
+   * contain an up to date entry for the key.
+   */
+  std::optional<mdl::Texture> load(const TextureCacheKey& key) const;
+
+  /**
+   * Stores the given texture under the given key, replacing any existing entry for the
+   * key's location.
+   */
+  Result<void> store(const TextureCacheKey& key, const mdl::Texture& texture) const;
+
+  /**
+   * Removes the least recently used entries until the total size of the remaining
+   * entries does not exceed the maximum size of this cache.
+   */
+  Result<void> evictEntries() const;
+
+private:
+  std::filesystem::path entryPath(const TextureCacheKey& key) const;
+};
+
+} // namespace tb::io
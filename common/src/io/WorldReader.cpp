@@ -19,6 +19,7 @@
 
 #include "WorldReader.h"
 
+#include "io/MapFormatDetection.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
@@ -33,6 +34,7 @@
 #include <fmt/format.h>
 
 #include <cassert>
+#include <chrono>
 #include <sstream>
 #include <string>
 
@@ -76,7 +78,9 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
 {
   auto parserErrors = std::vector<std::tuple<mdl::MapFormat, std::string>>{};
 
-  for (const auto mapFormat : mapFormatsToTry)
+  // try the formats that match the beginning of the map first, so that the map usually
+  // only has to be parsed once
+  for (const auto mapFormat : rankMapFormats(str, mapFormatsToTry))
   {
     if (mapFormat == mdl::MapFormat::Unknown)
     {
@@ -168,6 +172,18 @@ void setLinkIds(mdl::WorldNode& worldNode, ParserStatus& status)
   }
 }
 
+void rebuildNodeTree(
+  mdl::WorldNode& worldNode, ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto startTime = std::chrono::high_resolution_clock::now();
+  worldNode.rebuildNodeTree(taskManager);
+  const auto endTime = std::chrono::high_resolution_clock::now();
+
+  status.info(fmt::format(
+    "Built node tree in {}ms",
+    std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count()));
+}
+
 } // namespace
 
 Result<std::unique_ptr<mdl::WorldNode>> WorldReader::read(
@@ -176,7 +192,7 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::read(
   return readEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
            sanitizeLayerSortIndicies(*m_worldNode, status);
            setLinkIds(*m_worldNode, status);
-           m_worldNode->rebuildNodeTree();
+           rebuildNodeTree(*m_worldNode, status, taskManager);
            m_worldNode->enableNodeTreeUpdates();
            return std::move(m_worldNode);
          });
@@ -57,11 +57,13 @@ public:
     const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
 
   /**
-   * Try to parse the given string as the given map formats, in order.
+   * Try to parse the given string as the given map formats. The formats are ranked by
+   * how well they match the beginning of the given string, see rankMapFormats, and tried
+   * in that order.
    * Returns the world if parsing is successful, otherwise returns an error.
    *
    * @param str the string to parse
-   * @param mapFormatsToTry formats to try, in order
+   * @param mapFormatsToTry formats to try
    * @param worldBounds world bounds
    * @param status status
    * @param taskManager the task manager to use for parallel tasks
@@ -20,6 +20,8 @@
 #include "ZipFileSystem.h"
 
 #include "io/File.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
 
 #include "kdl/result.h"
 
@@ -56,6 +58,26 @@ std::string filename(mz_zip_archive& archive, const mz_uint fileIndex)
 
   return result;
 }
+
+/**
+ * Read callback for miniz. The opaque pointer must point to a Reader for the archive
+ * file. Reading from different readers for the same file is safe from multiple threads.
+ */
+size_t readArchive(void* opaque, const mz_uint64 offset, void* buffer, const size_t n)
+{
+  auto& reader = *static_cast<Reader*>(opaque);
+  try
+  {
+    reader.seekFromBegin(static_cast<size_t>(offset));
+    reader.read(static_cast<char*>(buffer), n);
+    return n;
+  }
+  catch (const ReaderException&)
+  {
+    return 0;
+  }
+}
+
 } // namespace
 
 ZipFileSystem::~ZipFileSystem()
@@ -67,9 +89,18 @@ Result<void> ZipFileSystem::doReadDirectory()
 {
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  // The reader is only used to read the central directory. Extractions replace it with
+  // their own reader.
+  auto directoryReader = m_file->reader();
+  m_archive.m_pRead = readArchive;
+  m_archive.m_pIO_opaque = &directoryReader;
+
+  const auto initialized = mz_zip_reader_init(&m_archive, m_file->size(), 0);
+  m_archive.m_pIO_opaque = nullptr;
+
+  if (initialized != MZ_TRUE)
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    return Error{"Error calling mz_zip_reader_init"};
   }
 
   const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -79,10 +110,15 @@ Result<void> ZipFileSystem::doReadDirectory()
     {
       const auto path = std::filesystem::path{filename(m_archive, i)};
       addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
-        auto loadFileGoard = std::lock_guard{m_mutex};
+        // Use a shallow copy of the archive with its own reader. The copy shares the
+        // central directory with m_archive, which miniz only reads during extraction.
+        auto reader = m_file->reader();
+        auto archive = m_archive;
+        archive.m_pRead = readArchive;
+        archive.m_pIO_opaque = &reader;
 
         auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
+        if (!mz_zip_reader_file_stat(&archive, i, &stat))
         {
           return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
         }
@@ -91,7 +127,7 @@ Result<void> ZipFileSystem::doReadDirectory()
         auto data = std::make_unique<char[]>(uncompressedSize);
         auto* begin = data.get();
 
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
+        if (!mz_zip_reader_extract_to_mem(&archive, i, begin, uncompressedSize, 0))
         {
           return Error{fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
         }
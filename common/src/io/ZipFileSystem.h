@@ -24,17 +24,20 @@
 
 #include <miniz/miniz.h>
 
-#include <mutex>
-
 namespace tb::io
 {
 class CFile;
 
+/**
+ * A file system backed by a zip archive.
+ *
+ * Files can be extracted concurrently. The archive's central directory is read once and
+ * not modified afterwards, and every extraction uses its own reader state.
+ */
 class ZipFileSystem : public ImageFileSystem<CFile>
 {
 private:
   mz_zip_archive m_archive;
-  std::mutex m_mutex;
 
 public:
   using ImageFileSystem::ImageFileSystem;
@@ -393,6 +393,11 @@ GroupNode* BrushNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void BrushNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void BrushNode::invalidateVertexCache()
 {
   m_brushRendererBrushCache->invalidateVertexCache();
@@ -120,6 +120,7 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdDidChange(const std::string& oldLinkId) override;
 
 public: // renderer cache
   /**
@@ -36,7 +36,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 EmptyBrushEntityValidator::EmptyBrushEntityValidator()
-  : Validator{Type, "Empty brush entity"}
+  : Validator{Type, "Empty brush entity", true}
 {
   addQuickFix(makeDeleteNodesQuickFix());
 }
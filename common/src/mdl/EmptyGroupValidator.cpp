@@ -34,7 +34,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 EmptyGroupValidator::EmptyGroupValidator()
-  : Validator{Type, "Empty group"}
+  : Validator{Type, "Empty group", true}
 {
   addQuickFix(makeDeleteNodesQuickFix());
 }
@@ -34,7 +34,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 EmptyPropertyKeyValidator::EmptyPropertyKeyValidator()
-  : Validator{Type, "Empty property name"}
+  : Validator{Type, "Empty property name", true}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
@@ -35,7 +35,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 EmptyPropertyValueValidator::EmptyPropertyValueValidator()
-  : Validator{Type, "Empty property value"}
+  : Validator{Type, "Empty property value", true}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
@@ -95,6 +95,7 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -153,6 +154,7 @@ void Entity::setDefinition(EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
 }
 
 const EntityModel* Entity::model() const
@@ -182,17 +184,22 @@ const EntityModelFrame* Entity::modelFrame() const
 
 ModelSpecification Entity::modelSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
-  {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->modelDefinition().modelSpecification(variableStore);
-  }
-  else
+  if (!m_cachedModelSpecification)
   {
-    return ModelSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointDefinition->modelDefinition().modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = ModelSpecification{};
+    }
   }
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4d& Entity::modelTransformation(
@@ -244,11 +251,14 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
 }
 
 void Entity::addOrUpdateProperty(
   std::string key, std::string value, const bool defaultToProtected)
 {
+  invalidateCachedModelSpecification(key);
+
   auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
@@ -294,6 +304,8 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
       m_properties.erase(newIt);
     }
 
+    invalidateCachedModelSpecification(oldKey);
+    invalidateCachedModelSpecification(newKey);
     oldIt->setKey(std::move(newKey));
 
     m_cachedClassname = std::nullopt;
@@ -314,6 +326,7 @@ void Entity::removeProperty(const std::string& key)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    invalidateCachedModelSpecification(key);
   }
 }
 
@@ -329,6 +342,7 @@ void Entity::removeNumberedProperty(const std::string& prefix)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    m_cachedModelSpecification = std::nullopt;
   }
 }
 
@@ -480,4 +494,15 @@ void Entity::transform(const vm::mat4x4d& transformation, const bool updateAngle
   }
 }
 
+void Entity::invalidateCachedModelSpecification(const std::string& key)
+{
+  if (
+    const auto* pointDefinition =
+      dynamic_cast<const PointEntityDefinition*>(m_definition.get());
+    pointDefinition && pointDefinition->modelDefinition().dependsOnVariable(key))
+  {
+    m_cachedModelSpecification = std::nullopt;
+  }
+}
+
 } // namespace tb::mdl
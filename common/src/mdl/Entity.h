@@ -22,6 +22,7 @@
 #include "el/EL_Forward.h" // IWYU pragma: keep
 #include "mdl/AssetReference.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/ModelSpecification.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -40,7 +41,6 @@ class Entity;
 class EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 
 enum class SetDefaultPropertyMode
 {
@@ -107,6 +107,12 @@ private:
   mutable std::optional<vm::mat4x4d> m_cachedRotation;
   mutable std::optional<vm::mat4x4d> m_cachedModelTransformation;
 
+  /**
+   * The model specification is only invalidated if the definition changes or if a
+   * property changes that is read by the definition's model expression.
+   */
+  mutable std::optional<ModelSpecification> m_cachedModelSpecification;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -181,6 +187,9 @@ public: // property management
   std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
   void transform(const vm::mat4x4d& transformation, bool updateAngleProperty);
+
+private:
+  void invalidateCachedModelSpecification(const std::string& key);
 };
 
 } // namespace tb::mdl
@@ -21,6 +21,7 @@
 
 #include "mdl/MaterialCollection.h"
 #include "mdl/Texture.h"
+#include "mdl/TriangleBvh.h"
 #include "render/IndexRangeMap.h"
 #include "render/MaterialIndexRangeMap.h"
 #include "render/MaterialIndexRangeRenderer.h"
@@ -30,7 +31,6 @@
 
 #include "vm/bbox.h"
 #include "vm/bbox_io.h" // IWYU pragma: keep
-#include "vm/intersection.h"
 
 #include <fmt/format.h>
 
@@ -87,10 +87,11 @@ EntityModelFrame::EntityModelFrame(
   : m_index{index}
   , m_name{std::move(name)}
   , m_bounds{bounds}
-  , m_spacialTree{16.0f}
 {
 }
 
+EntityModelFrame::~EntityModelFrame() = default;
+
 size_t EntityModelFrame::index() const
 {
   return m_index;
@@ -116,28 +117,15 @@ const vm::bbox3f& EntityModelFrame::bounds() const
   return m_bounds;
 }
 
-std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+namespace
 {
-  auto closestDistance = std::optional<float>{};
-
-  const auto candidates = m_spacialTree.find_intersectors(ray);
-  for (const auto triNum : candidates)
-  {
-    const auto& p1 = m_tris[triNum * 3 + 0];
-    const auto& p2 = m_tris[triNum * 3 + 1];
-    const auto& p3 = m_tris[triNum * 3 + 2];
-    closestDistance =
-      vm::safe_min(closestDistance, vm::intersect_ray_triangle(ray, p1, p2, p3));
-  }
-
-  return closestDistance;
-}
 
-void EntityModelFrame::addToSpacialTree(
+void collectTriangles(
   const std::vector<EntityModelVertex>& vertices,
   const render::PrimType primType,
   const size_t index,
-  const size_t count)
+  const size_t count,
+  std::vector<vm::vec3f>& tris)
 {
   switch (primType)
   {
@@ -148,45 +136,24 @@ void EntityModelFrame::addToSpacialTree(
     break;
   case render::PrimType::Triangles: {
     assert(count % 3 == 0);
-    m_tris.reserve(m_tris.size() + count);
-    for (size_t i = 0; i < count; i += 3)
+    tris.reserve(tris.size() + count);
+    for (size_t i = 0; i < count; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i]));
     }
     break;
   }
   case render::PrimType::Polygon:
   case render::PrimType::TriangleFan: {
     assert(count > 2);
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
+    tris.reserve(tris.size() + (count - 2) * 3);
 
     const auto& p1 = render::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      tris.push_back(p1);
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i]));
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i + 1]));
     }
     break;
   }
@@ -194,31 +161,24 @@ void EntityModelFrame::addToSpacialTree(
   case render::PrimType::QuadStrip:
   case render::PrimType::TriangleStrip: {
     assert(count > 2);
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
+    tris.reserve(tris.size() + (count - 2) * 3);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
 
-      const auto triIndex = m_tris.size() / 3u;
+      tris.push_back(p1);
       if (i % 2 == 0)
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p2);
-        m_tris.push_back(p3);
+        tris.push_back(p2);
+        tris.push_back(p3);
       }
       else
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p3);
-        m_tris.push_back(p2);
+        tris.push_back(p3);
+        tris.push_back(p2);
       }
-      m_spacialTree.insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -226,6 +186,57 @@ void EntityModelFrame::addToSpacialTree(
   }
 }
 
+} // namespace
+
+std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+{
+  if (!m_bvh)
+  {
+    auto tris = std::vector<vm::vec3f>{};
+    for (const auto& primitives : m_primitives)
+    {
+      collectTriangles(
+        *primitives.vertices,
+        primitives.primType,
+        primitives.index,
+        primitives.count,
+        tris);
+    }
+    m_bvh = std::make_unique<TriangleBvh>(tris);
+  }
+
+  return m_bvh->intersect(ray);
+}
+
+bool EntityModelFrame::hasBvh() const
+{
+  return m_bvh != nullptr;
+}
+
+size_t EntityModelFrame::memoryUsage() const
+{
+  return m_primitives.capacity() * sizeof(Primitives)
+         + (m_bvh ? sizeof(TriangleBvh) + m_bvh->memoryUsage() : 0);
+}
+
+void EntityModelFrame::addPrimitives(
+  const std::vector<EntityModelVertex>& vertices,
+  const render::PrimType primType,
+  const size_t index,
+  const size_t count)
+{
+  m_primitives.push_back({&vertices, primType, index, count});
+  m_bvh.reset();
+}
+
+void EntityModelFrame::removePrimitives(const std::vector<EntityModelVertex>& vertices)
+{
+  std::erase_if(m_primitives, [&](const auto& primitives) {
+    return primitives.vertices == &vertices;
+  });
+  m_bvh.reset();
+}
+
 // EntityModelData::Mesh
 
 /**
@@ -265,6 +276,19 @@ public:
     return doBuildRenderer(skin, vertexArray);
   }
 
+  /**
+   * Returns the vertices of this mesh.
+   */
+  const std::vector<EntityModelVertex>& vertices() const { return m_vertices; }
+
+  /**
+   * Returns the number of bytes allocated for the vertices of this mesh.
+   */
+  size_t memoryUsage() const
+  {
+    return m_vertices.capacity() * sizeof(EntityModelVertex);
+  }
+
 private:
   /**
    * Creates and returns the actual mesh renderer
@@ -309,7 +333,7 @@ public:
   {
     m_indices.forEachPrimitive(
       [&](const render::PrimType primType, const size_t index, const size_t count) {
-        frame.addToSpacialTree(m_vertices, primType, index, count);
+        frame.addPrimitives(m_vertices, primType, index, count);
       });
   }
 
@@ -355,7 +379,7 @@ public:
                                  const render::PrimType primType,
                                  const size_t index,
                                  const size_t count) {
-      frame.addToSpacialTree(m_vertices, primType, index, count);
+      frame.addPrimitives(m_vertices, primType, index, count);
     });
   }
 
@@ -415,6 +439,10 @@ void EntityModelSurface::addMesh(
   render::IndexRangeMap indices)
 {
   assert(frame.index() < frameCount());
+  if (const auto& mesh = m_meshes[frame.index()])
+  {
+    frame.removePrimitives(mesh->vertices());
+  }
   m_meshes[frame.index()] = std::make_unique<EntityModelIndexedMesh>(
     frame, std::move(vertices), std::move(indices));
 }
@@ -425,6 +453,10 @@ void EntityModelSurface::addMesh(
   render::MaterialIndexRangeMap indices)
 {
   assert(frame.index() < frameCount());
+  if (const auto& mesh = m_meshes[frame.index()])
+  {
+    frame.removePrimitives(mesh->vertices());
+  }
   m_meshes[frame.index()] = std::make_unique<EntityModelMaterialMesh>(
     frame, std::move(vertices), std::move(indices));
 }
@@ -464,6 +496,31 @@ std::unique_ptr<render::MaterialIndexRangeRenderer> EntityModelSurface::buildRen
                               : nullptr;
 }
 
+size_t EntityModelSurface::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& mesh : m_meshes)
+  {
+    if (mesh)
+    {
+      result += mesh->memoryUsage();
+    }
+  }
+
+  for (const auto& material : m_skins->materials())
+  {
+    if (const auto* texture = material.texture())
+    {
+      for (const auto& buffer : texture->buffersIfLoaded())
+      {
+        result += buffer.size();
+      }
+    }
+  }
+
+  return result;
+}
+
 // EntityModelData
 
 kdl_reflect_impl(EntityModelData);
@@ -600,6 +657,20 @@ const EntityModelSurface* EntityModelData::surface(const std::string& name) cons
   return it != m_surfaces.end() ? &*it : nullptr;
 }
 
+size_t EntityModelData::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& frame : m_frames)
+  {
+    result += frame.memoryUsage();
+  }
+  for (const auto& surface : m_surfaces)
+  {
+    result += surface.memoryUsage();
+  }
+  return result;
+}
+
 kdl_reflect_impl(EntityModel);
 
 EntityModel::EntityModel(
@@ -629,4 +700,10 @@ const EntityModelDataResource& EntityModel::dataResource() const
   return *m_dataResource;
 }
 
+size_t EntityModel::memoryUsage() const
+{
+  const auto* modelData = data();
+  return modelData ? modelData->memoryUsage() : 0;
+}
+
 } // namespace tb::mdl
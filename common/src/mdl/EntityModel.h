@@ -21,23 +21,17 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 
 #include "mdl/EntityModelDataResource.h"
 #include "mdl/EntityModel_Forward.h"
-#include "octree.h"
 
 #include "kdl/reflection_decl.h"
 
 #include "vm/bbox.h"
+#include "vm/ray.h"
 
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
-namespace tb
-{
-template <typename T, typename U>
-class octree;
-}
-
 namespace tb::render
 {
 enum class PrimType;
@@ -51,6 +45,7 @@ namespace tb::mdl
 {
 class Material;
 class MaterialCollection;
+class TriangleBvh;
 
 enum class PitchType
 {
@@ -94,11 +89,17 @@ private:
   vm::bbox3f m_bounds;
   size_t m_skinOffset = 0;
 
-  // For hit testing
-  std::vector<vm::vec3f> m_tris;
-  using TriNum = size_t;
-  using SpacialTree = octree<float, TriNum>;
-  SpacialTree m_spacialTree;
+  // For hit testing, the primitives are recorded when a mesh is added and the BVH is
+  // built when the frame is first intersected
+  struct Primitives
+  {
+    const std::vector<EntityModelVertex>* vertices;
+    render::PrimType primType;
+    size_t index;
+    size_t count;
+  };
+  std::vector<Primitives> m_primitives;
+  mutable std::unique_ptr<TriangleBvh> m_bvh;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
 
@@ -110,6 +111,10 @@ public:
    */
   explicit EntityModelFrame(size_t index, std::string name, const vm::bbox3f& bounds);
 
+  moveOnly(EntityModelFrame);
+
+  ~EntityModelFrame();
+
   /**
    * Returns the index of this frame.
    *
@@ -144,6 +149,8 @@ public:
   /**
    * Intersects this frame with the given ray and returns the point of intersection.
    *
+   * The BVH used to accelerate this is built on the first call.
+   *
    * @param ray the ray to intersect
    * @return the distance to the point of intersection or nullopt if the given ray does
    * not intersect this frame
@@ -151,7 +158,18 @@ public:
   std::optional<float> intersect(const vm::ray3f& ray) const;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Indicates whether the BVH of this frame has been built.
+   */
+  bool hasBvh() const;
+
+  /**
+   * Returns the number of bytes allocated for hit testing this frame.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Records the given primitives for hit testing this frame. The given vertices must
+   * remain valid until they are removed from this frame by calling removePrimitives.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -159,11 +177,19 @@ public:
    * array
    * @param count the number of vertices that make up the primitive(s)
    */
-  void addToSpacialTree(
+  void addPrimitives(
     const std::vector<EntityModelVertex>& vertices,
     render::PrimType primType,
     size_t index,
     size_t count);
+
+  /**
+   * Removes all primitives that were recorded for the given vertices. The BVH is rebuilt
+   * when this frame is intersected next.
+   *
+   * @param vertices the vertices
+   */
+  void removePrimitives(const std::vector<EntityModelVertex>& vertices);
 };
 
 class EntityModelMesh;
@@ -279,6 +305,12 @@ public:
 
   std::unique_ptr<render::MaterialIndexRangeRenderer> buildRenderer(
     size_t skinIndex, size_t frameIndex) const;
+
+  /**
+   * Returns the number of bytes allocated for the meshes of this surface and for the
+   * loaded skin textures.
+   */
+  size_t memoryUsage() const;
 };
 
 /**
@@ -435,6 +467,13 @@ public:
    * @return the surface with the given name or null if no such surface was found
    */
   const EntityModelSurface* surface(const std::string& name) const;
+
+  /**
+   * Returns the number of bytes allocated for the frames and surfaces of this model,
+   * including any frame BVHs that have been built and any skin textures that have been
+   * loaded.
+   */
+  size_t memoryUsage() const;
 };
 
 class EntityModel
@@ -457,6 +496,12 @@ public:
   EntityModelData* data();
 
   const EntityModelDataResource& dataResource() const;
+
+  /**
+   * Returns the number of bytes allocated for this model's data, or 0 if the data is not
+   * loaded.
+   */
+  size_t memoryUsage() const;
 };
 
 } // namespace tb::mdl
@@ -47,6 +47,7 @@ void GameFileSystem::initialize(
   Logger& logger)
 {
   unmountAll();
+  io::Disk::clearDirectoryCache();
 
   addDefaultAssetPaths(config, logger);
 
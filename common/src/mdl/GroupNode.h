@@ -128,6 +128,7 @@ private: // implement methods inherited from Object
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdDidChange(const std::string& oldLinkId) override;
 
 private:
   void invalidateBounds();
@@ -67,7 +67,7 @@ IssueQuickFix makeResetUVScaleQuickFix()
 } // namespace
 
 InvalidUVScaleValidator::InvalidUVScaleValidator()
-  : Validator{Type, "Invalid UV scale"}
+  : Validator{Type, "Invalid UV scale", true}
 {
   addQuickFix(makeResetUVScaleQuickFix());
 }
@@ -34,7 +34,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 LinkSourceValidator::LinkSourceValidator()
-  : Validator{Type, "Missing entity link source"}
+  : Validator{Type, "Missing entity link source", true}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
@@ -32,15 +32,61 @@
 #include "kdl/task_manager.h"
 #include "kdl/zip_iterator.h"
 
+#include <algorithm>
 #include <string_view>
 #include <unordered_map>
 
 namespace tb::mdl
 {
 
+namespace
+{
+
+/**
+ * Returns the world node that contains all of the given nodes, or nullptr if there is no
+ * such node.
+ */
+const WorldNode* findContainingWorld(const std::vector<Node*>& nodes)
+{
+  const WorldNode* result = nullptr;
+  for (const auto* node : nodes)
+  {
+    while (node->parent())
+    {
+      node = node->parent();
+    }
+
+    const auto* worldNode = dynamic_cast<const WorldNode*>(node);
+    if (!worldNode || (result && worldNode != result))
+    {
+      return nullptr;
+    }
+    result = worldNode;
+  }
+  return result;
+}
+
+} // namespace
+
 std::vector<Node*> collectNodesWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
+  if (const auto* worldNode = findContainingWorld(nodes))
+  {
+    // Look up the linked nodes in the world's link ID index and keep those that are
+    // contained in the given nodes.
+    const auto& linkedNodes = worldNode->nodesWithLinkId(linkId);
+    if (std::ranges::find(nodes, worldNode) != nodes.end())
+    {
+      return linkedNodes;
+    }
+
+    return kdl::vec_filter(linkedNodes, [&](const auto* linkedNode) {
+      return std::ranges::find(nodes, linkedNode) != nodes.end()
+             || linkedNode->isDescendantOf(nodes);
+    });
+  }
+
   return collectNodesAndDescendants(
     nodes,
     kdl::overload(
@@ -53,10 +99,18 @@ std::vector<Node*> collectNodesWithLinkId(
 std::vector<GroupNode*> collectGroupsWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
-  return kdl::vec_static_cast<GroupNode*>(
-    collectNodesAndDescendants(nodes, kdl::overload([&](const GroupNode* groupNode) {
-                                 return groupNode->linkId() == linkId;
-                               })));
+  auto result = std::vector<GroupNode*>{};
+  for (auto* node : collectNodesWithLinkId(nodes, linkId))
+  {
+    node->accept(kdl::overload(
+      [](WorldNode*) {},
+      [](LayerNode*) {},
+      [&](GroupNode* groupNode) { result.push_back(groupNode); },
+      [](EntityNode*) {},
+      [](BrushNode*) {},
+      [](PatchNode*) {}));
+  }
+  return result;
 }
 
 std::vector<std::string> collectLinkedGroupIds(const std::vector<Node*>& nodes)
@@ -278,45 +332,43 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
 
   // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
   // `nodesToClone`
-  auto tasks =
-    nodesToClone | std::views::transform([&](const auto& nodeToTransform) {
-      return std::function{[&]() {
-        return nodeToTransform->accept(kdl::overload(
-          [](const WorldNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [](const LayerNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [&](const GroupNode* groupNode) -> TransformResult {
-            auto group = groupNode->group();
-            group.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-          },
-          [&](const EntityNode* entityNode) -> TransformResult {
-            const auto updateAngleProperty =
-              entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
-            auto entity = entityNode->entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-          },
-          [&](const BrushNode* brushNode) -> TransformResult {
-            auto brush = brushNode->brush();
-            return brush.transform(worldBounds, transformation, true)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         nodeToTransform, NodeContents{std::move(brush)});
-                     });
-          },
-          [&](const PatchNode* patchNode) -> TransformResult {
-            auto patch = patchNode->patch();
-            patch.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-          }));
-      }};
+  auto transformResults =
+    taskManager.parallel_transform(nodesToClone, [&](const auto& nodeToTransform) {
+      return nodeToTransform->accept(kdl::overload(
+        [](const WorldNode*) -> TransformResult {
+          ensure(false, "Linked group structure is valid");
+        },
+        [](const LayerNode*) -> TransformResult {
+          ensure(false, "Linked group structure is valid");
+        },
+        [&](const GroupNode* groupNode) -> TransformResult {
+          auto group = groupNode->group();
+          group.transform(transformation);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
+        },
+        [&](const EntityNode* entityNode) -> TransformResult {
+          const auto updateAngleProperty =
+            entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
+          auto entity = entityNode->entity();
+          entity.transform(transformation, updateAngleProperty);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
+        },
+        [&](const BrushNode* brushNode) -> TransformResult {
+          auto brush = brushNode->brush();
+          return brush.transform(worldBounds, transformation, true)
+                 | kdl::and_then([&]() -> TransformResult {
+                     return std::make_pair(
+                       nodeToTransform, NodeContents{std::move(brush)});
+                   });
+        },
+        [&](const PatchNode* patchNode) -> TransformResult {
+          auto patch = patchNode->patch();
+          patch.transform(transformation);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
+        }));
     });
 
-  return taskManager.run_tasks_and_wait(tasks) | kdl::fold
+  return std::move(transformResults) | kdl::fold
          | kdl::or_else(
            [](const auto&) -> Result<std::vector<std::pair<const Node*, NodeContents>>> {
              return Error{"Failed to transform a linked node"};
@@ -35,7 +35,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 LongPropertyKeyValidator::LongPropertyKeyValidator(const size_t maxLength)
-  : Validator{Type, "Long entity property keys"}
+  : Validator{Type, "Long entity property keys", true}
   , m_maxLength{maxLength}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
@@ -24,6 +24,8 @@
 
 #include "kdl/reflection_impl.h"
 
+#include "vm/vec_io.h" // IWYU pragma: keep
+
 #include <cassert>
 #include <ostream>
 
@@ -105,6 +107,7 @@ Material::Material(Material&& other)
   , m_absolutePath{std::move(other.m_absolutePath)}
   , m_relativePath{std::move(other.m_relativePath)}
   , m_textureResource{std::move(other.m_textureResource)}
+  , m_textureSize{std::move(other.m_textureSize)}
   , m_usageCount{static_cast<size_t>(other.m_usageCount)}
   , m_surfaceParms{std::move(other.m_surfaceParms)}
   , m_culling{std::move(other.m_culling)}
@@ -119,6 +122,7 @@ Material& Material::operator=(Material&& other)
   m_absolutePath = std::move(other.m_absolutePath);
   m_relativePath = std::move(other.m_relativePath);
   m_textureResource = std::move(other.m_textureResource);
+  m_textureSize = std::move(other.m_textureSize);
   m_usageCount = static_cast<size_t>(other.m_usageCount);
   m_surfaceParms = std::move(other.m_surfaceParms);
   m_culling = std::move(other.m_culling);
@@ -176,6 +180,25 @@ const TextureResource& Material::textureResource() const
   return *m_textureResource;
 }
 
+void Material::requestTexture() const
+{
+  m_textureResource->requestLoading();
+}
+
+std::optional<vm::vec2s> Material::textureSize() const
+{
+  if (const auto* texture = m_textureResource->get())
+  {
+    return vm::vec2s{texture->width(), texture->height()};
+  }
+  return m_textureSize;
+}
+
+void Material::setTextureSize(const vm::vec2s& textureSize)
+{
+  m_textureSize = textureSize;
+}
+
 const std::set<std::string>& Material::surfaceParms() const
 {
   return m_surfaceParms;
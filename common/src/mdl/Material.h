@@ -24,9 +24,12 @@
 
 #include "kdl/reflection_decl.h"
 
+#include "vm/vec.h"
+
 #include <atomic>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -91,6 +94,7 @@ private:
   std::filesystem::path m_relativePath;
 
   std::shared_ptr<TextureResource> m_textureResource;
+  std::optional<vm::vec2s> m_textureSize;
 
   std::atomic<size_t> m_usageCount = 0;
 
@@ -112,6 +116,7 @@ private:
     m_absolutePath,
     m_relativePath,
     m_textureResource,
+    m_textureSize,
     m_usageCount,
     m_surfaceParms,
     m_culling,
@@ -150,6 +155,19 @@ public:
 
   const TextureResource& textureResource() const;
 
+  /**
+   * Requests loading the texture if its resource is loaded on demand. This must be called
+   * whenever the material is rendered.
+   */
+  void requestTexture() const;
+
+  /**
+   * Returns the size of the texture if it is loaded. Otherwise, returns the size that was
+   * read from the texture file's header, if any.
+   */
+  std::optional<vm::vec2s> textureSize() const;
+  void setTextureSize(const vm::vec2s& textureSize);
+
   const std::set<std::string>& surfaceParms() const;
   void setSurfaceParms(std::set<std::string> surfaceParms);
 
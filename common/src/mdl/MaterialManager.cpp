@@ -27,7 +27,6 @@
 
 #include "kdl/map_utils.h"
 #include "kdl/result.h"
-#include "kdl/string_format.h"
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
@@ -49,10 +48,12 @@ void MaterialManager::reload(
   const io::FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const CreateTextureResource& createResource,
-  kdl::task_manager& taskManager)
+  kdl::task_manager& taskManager,
+  std::shared_ptr<const io::TextureCache> textureCache)
 {
   clear();
-  io::loadMaterialCollections(fs, materialConfig, createResource, taskManager, m_logger)
+  io::loadMaterialCollections(
+    fs, materialConfig, createResource, taskManager, m_logger, std::move(textureCache))
     | kdl::transform([&](auto materialCollections) {
         for (auto& collection : materialCollections)
         {
@@ -91,13 +92,13 @@ void MaterialManager::clear()
   // Remove logging because it might fail when the document is already destroyed.
 }
 
-const Material* MaterialManager::material(const std::string& name) const
+const Material* MaterialManager::material(const std::string_view name) const
 {
-  auto it = m_materialsByName.find(kdl::str_to_lower(name));
+  auto it = m_materialsByName.find(name);
   return it != m_materialsByName.end() ? it->second : nullptr;
 }
 
-Material* MaterialManager::material(const std::string& name)
+Material* MaterialManager::material(const std::string_view name)
 {
   return const_cast<Material*>(const_cast<const MaterialManager*>(this)->material(name));
 }
@@ -131,17 +132,7 @@ void MaterialManager::updateMaterials()
   {
     for (auto& material : collection.materials())
     {
-      const auto key = kdl::str_to_lower(material.name());
-
-      auto mIt = m_materialsByName.find(key);
-      if (mIt != m_materialsByName.end())
-      {
-        mIt->second = &material;
-      }
-      else
-      {
-        m_materialsByName.insert(std::make_pair(key, &material));
-      }
+      m_materialsByName.insert_or_assign(material.name(), &material);
     }
   }
 
@@ -22,7 +22,11 @@
 #include "mdl/MaterialCollection.h"
 #include "mdl/TextureResource.h"
 
+#include "kdl/string_compare.h"
+
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -38,6 +42,7 @@ class Logger;
 namespace io
 {
 class FileSystem;
+class TextureCache;
 } // namespace io
 
 namespace mdl
@@ -58,7 +63,8 @@ private:
 
   std::vector<MaterialCollection> m_collections;
 
-  std::unordered_map<std::string, Material*> m_materialsByName;
+  std::unordered_map<std::string, Material*, kdl::ci::string_hash, kdl::ci::string_equal>
+    m_materialsByName;
   std::vector<const Material*> m_materials;
 
 public:
@@ -69,7 +75,8 @@ public:
     const io::FileSystem& fs,
     const mdl::MaterialConfig& materialConfig,
     const CreateTextureResource& createResource,
-    kdl::task_manager& taskManager);
+    kdl::task_manager& taskManager,
+    std::shared_ptr<const io::TextureCache> textureCache);
 
   // for testing
   void setMaterialCollections(std::vector<MaterialCollection> collections);
@@ -80,8 +87,8 @@ private:
 public:
   void clear();
 
-  const Material* material(const std::string& name) const;
-  Material* material(const std::string& name);
+  const Material* material(std::string_view name) const;
+  Material* material(std::string_view name);
 
   const std::vector<const Material*> findMaterialsByTextureResourceId(
     const std::vector<ResourceId>& textureResourceIds) const;
@@ -35,7 +35,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 MissingClassnameValidator::MissingClassnameValidator()
-  : Validator{Type, "Missing entity classname"}
+  : Validator{Type, "Missing entity classname", true}
 {
   addQuickFix(makeDeleteNodesQuickFix());
 }
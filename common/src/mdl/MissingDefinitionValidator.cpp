@@ -35,7 +35,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 MissingDefinitionValidator::MissingDefinitionValidator()
-  : Validator{Type, "Missing entity definition"}
+  : Validator{Type, "Missing entity definition", true}
 {
   addQuickFix(makeDeleteNodesQuickFix());
 }
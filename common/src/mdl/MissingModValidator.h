@@ -32,6 +32,7 @@ class Game;
 class MissingModValidator : public Validator
 {
   std::weak_ptr<Game> m_game;
+  // this cache makes the validator unsafe to use from multiple threads
   mutable std::vector<std::string> m_lastMods;
 
 public:
@@ -35,7 +35,7 @@ const auto Type = freeIssueType();
 } // namespace
 
 MixedBrushContentsValidator::MixedBrushContentsValidator()
-  : Validator{Type, "Mixed brush content flags"}
+  : Validator{Type, "Mixed brush content flags", true}
 {
 }
 
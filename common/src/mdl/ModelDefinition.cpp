@@ -33,6 +33,8 @@
 #include "vm/scalar.h"
 #include "vm/vec_io.h"
 
+#include <algorithm>
+
 namespace tb::mdl
 {
 
@@ -48,6 +50,7 @@ ModelDefinition::ModelDefinition(const FileLocation& location)
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_variableNames{m_expression.variableNames()}
 {
 }
 
@@ -57,6 +60,12 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_variableNames = m_expression.variableNames();
+}
+
+bool ModelDefinition::dependsOnVariable(const std::string& name) const
+{
+  return std::ranges::binary_search(m_variableNames, name);
 }
 
 static std::filesystem::path path(const el::Value& value)
@@ -27,6 +27,8 @@
 #include "vm/vec.h"
 
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace tb
 {
@@ -48,6 +50,7 @@ class ModelDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  std::vector<std::string> m_variableNames;
 
 public:
   ModelDefinition();
@@ -57,6 +60,13 @@ public:
 
   void append(ModelDefinition other);
 
+  /**
+   * Indicates whether evaluating the model expression reads the variable with the given
+   * name. If this returns false, then changing the variable does not change the model
+   * specification.
+   */
+  bool dependsOnVariable(const std::string& name) const;
+
   /**
    * Evaluates the model expresion, using the given variable store to interpolate
    * variables.
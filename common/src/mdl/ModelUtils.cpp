@@ -27,6 +27,8 @@
 
 #include "kdl/vector_utils.h"
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -168,18 +170,25 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
  * brush in the given vector of brushes such that the predicate evaluates to true for that
  * pair of node and brush.
  *
+ * The given function maps a node to the brushes that it must be tested against. It allows
+ * the caller to skip the predicate for brushes that cannot possibly match the node.
+ *
  * The given predicate must be a function that maps a node and a brush to true or false.
  */
-template <typename P>
+template <typename C, typename P>
 static std::vector<Node*> collectMatchingNodes(
   const std::vector<Node*>& nodes,
   const std::vector<BrushNode*>& brushes,
+  const C& getCandidateBrushes,
   const P& predicate)
 {
   auto result = std::vector<Node*>{};
 
+  const auto brushSet =
+    std::unordered_set<const BrushNode*>{brushes.begin(), brushes.end()};
+
   const auto collectIfMatching = [&](auto* node) {
-    for (const auto* brush : brushes)
+    for (const auto* brush : getCandidateBrushes(node))
     {
       if (predicate(node, brush))
       {
@@ -216,7 +225,7 @@ static std::vector<Node*> collectMatchingNodes(
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
-        if (!kdl::vec_contains(brushes, brush))
+        if (!brushSet.contains(brush))
         {
           collectIfMatching(brush);
         }
@@ -230,6 +239,54 @@ static std::vector<Node*> collectMatchingNodes(
   return result;
 }
 
+template <typename P>
+static std::vector<Node*> collectMatchingNodes(
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  const P& predicate)
+{
+  return collectMatchingNodes(
+    nodes,
+    brushes,
+    [&](const auto*) -> const std::vector<BrushNode*>& { return brushes; },
+    predicate);
+}
+
+/**
+ * Like collectMatchingNodes, but uses the node tree of the given world to find the
+ * brushes that each entity, brush or patch must be tested against.
+ *
+ * The node tree contains the physical bounds of every entity, brush and patch, and the
+ * given predicate must only hold for a node and a brush if the brush's bounds intersect
+ * the node's physical bounds. Groups are not contained in the node tree, so they are
+ * tested against all brushes.
+ */
+template <typename P>
+static std::vector<Node*> collectMatchingNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes, const P& predicate)
+{
+  auto candidateBrushes = std::unordered_map<const Node*, std::vector<BrushNode*>>{};
+  const auto& nodeTree = worldNode.nodeTree();
+  for (auto* brush : brushes)
+  {
+    for (const auto* node : nodeTree.find_intersectors(brush->logicalBounds()))
+    {
+      candidateBrushes[node].push_back(brush);
+    }
+  }
+
+  static const auto noBrushes = std::vector<BrushNode*>{};
+  const auto getCandidateBrushes = kdl::overload(
+    [&](const GroupNode*) -> const std::vector<BrushNode*>& { return brushes; },
+    [&](const Node* node) -> const std::vector<BrushNode*>& {
+      const auto iCandidates = candidateBrushes.find(node);
+      return iCandidates != candidateBrushes.end() ? iCandidates->second : noBrushes;
+    });
+
+  return collectMatchingNodes(
+    std::vector<Node*>{&worldNode}, brushes, getCandidateBrushes, predicate);
+}
+
 std::vector<Node*> collectTouchingNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
 {
@@ -238,6 +295,15 @@ std::vector<Node*> collectTouchingNodes(
   });
 }
 
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes)
+{
+  return collectMatchingNodes(
+    worldNode, brushes, [](const auto* node, const auto* brush) {
+      return brush->intersects(node);
+    });
+}
+
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
 {
@@ -246,6 +312,15 @@ std::vector<Node*> collectContainedNodes(
   });
 }
 
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes)
+{
+  return collectMatchingNodes(
+    worldNode, brushes, [](const auto* node, const auto* brush) {
+      return brush->contains(node);
+    });
+}
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes)
 {
   return collectNodesAndDescendants(
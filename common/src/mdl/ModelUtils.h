@@ -36,6 +36,7 @@ class BrushNode;
 class EntityNode;
 class LayerNode;
 class EditorContext;
+class WorldNode;
 
 HitType::Type nodeHitType();
 
@@ -63,6 +64,16 @@ std::vector<Node*> collectTouchingNodes(
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 
+/**
+ * Returns the same nodes as the corresponding overloads that take a vector of nodes when
+ * called with the given world node, but uses the world's node tree to avoid testing every
+ * node against every brush.
+ */
+std::vector<Node*> collectTouchingNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes);
+std::vector<Node*> collectContainedNodes(
+  WorldNode& worldNode, const std::vector<BrushNode*>& brushes);
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
 std::vector<Node*> collectSelectableNodes(
@@ -32,6 +32,7 @@
 #include <cassert>
 #include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -807,8 +808,7 @@ bool Node::containsLine(const size_t lineNumber) const
 std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& validators)
 {
   validateIssues(validators);
-  return kdl::vec_transform(
-    m_issues, [](const auto& issue) { return const_cast<const Issue*>(issue.get()); });
+  return cachedIssues();
 }
 
 bool Node::issueHidden(const IssueType type) const
@@ -828,24 +828,46 @@ void Node::setIssueHidden(const IssueType type, const bool hidden)
   }
 }
 
+bool Node::issuesValid() const
+{
+  return m_issuesValid;
+}
+
+void Node::invalidateIssues()
+{
+  if (m_issuesValid)
+  {
+    m_issuesValid = false;
+    issuesWereInvalidated(this);
+  }
+}
+
+std::vector<const Issue*> Node::cachedIssues() const
+{
+  return kdl::vec_transform(
+    m_issues, [](const auto& issue) { return const_cast<const Issue*>(issue.get()); });
+}
+
+std::vector<std::unique_ptr<Issue>> Node::setIssues(
+  std::vector<std::unique_ptr<Issue>> issues)
+{
+  m_issuesValid = true;
+  return std::exchange(m_issues, std::move(issues));
+}
+
 void Node::validateIssues(const std::vector<const Validator*>& validators)
 {
   if (!m_issuesValid)
   {
+    auto issues = std::vector<std::unique_ptr<Issue>>{};
     for (const auto* validator : validators)
     {
-      validator->validate(*this, m_issues);
+      validator->validate(*this, issues);
     }
-    m_issuesValid = true;
+    setIssues(std::move(issues));
   }
 }
 
-void Node::invalidateIssues() const
-{
-  m_issues.clear();
-  m_issuesValid = false;
-}
-
 const EntityPropertyConfig& Node::entityPropertyConfig() const
 {
   return doGetEntityPropertyConfig();
@@ -879,6 +901,17 @@ void Node::removeFromIndex(
   doRemoveFromIndex(node, key, value);
 }
 
+void Node::updateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  doUpdateLinkIdIndex(node, oldLinkId, newLinkId);
+}
+
+void Node::issuesWereInvalidated(Node* node)
+{
+  doIssuesWereInvalidated(node);
+}
+
 Node* Node::doCloneRecursively(const vm::bbox3d& worldBounds) const
 {
   auto* clone = Node::clone(worldBounds);
@@ -967,4 +1000,21 @@ void Node::doRemoveFromIndex(
   }
 }
 
+void Node::doUpdateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  if (m_parent)
+  {
+    m_parent->updateLinkIdIndex(node, oldLinkId, newLinkId);
+  }
+}
+
+void Node::doIssuesWereInvalidated(Node* node)
+{
+  if (m_parent)
+  {
+    m_parent->issuesWereInvalidated(node);
+  }
+}
+
 } // namespace tb::mdl
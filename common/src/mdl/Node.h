@@ -355,7 +355,22 @@ public: // issue management
   void setIssueHidden(IssueType type, bool hidden);
 
 public: // should only be called from this and from the world
-  void invalidateIssues() const;
+  bool issuesValid() const;
+  void invalidateIssues();
+
+  /**
+   * Returns the issues of this node without validating it. If the issues are not valid,
+   * these are the issues that were found when this node was last validated.
+   */
+  std::vector<const Issue*> cachedIssues() const;
+
+  /**
+   * Replaces the issues of this node with the given issues and marks them as valid.
+   *
+   * Returns the previous issues of this node.
+   */
+  std::vector<std::unique_ptr<Issue>> setIssues(
+    std::vector<std::unique_ptr<Issue>> issues);
 
 private:
   void validateIssues(const std::vector<const Validator*>& validators);
@@ -502,6 +517,11 @@ protected: // index management
   void removeFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  void updateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId);
+
+  void issuesWereInvalidated(Node* node);
+
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
   virtual const vm::bbox3d& doGetLogicalBounds() const = 0;
@@ -567,6 +587,11 @@ private: // subclassing interface
     EntityNodeBase* node, const std::string& key, const std::string& value);
   virtual void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
+
+  virtual void doUpdateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId);
+
+  virtual void doIssuesWereInvalidated(Node* node);
 };
 
 } // namespace tb::mdl
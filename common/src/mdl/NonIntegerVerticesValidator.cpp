@@ -41,7 +41,7 @@ IssueQuickFix makeSnapVerticesQuickFix()
 } // namespace
 
 NonIntegerVerticesValidator::NonIntegerVerticesValidator()
-  : Validator{Type, "Non-integer vertices"}
+  : Validator{Type, "Non-integer vertices", true}
 {
   addQuickFix(makeSnapVerticesQuickFix());
 }
@@ -34,6 +34,9 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -73,47 +76,81 @@ bool Palette::indexedToRgba(
 {
   ensure(rgbaImage.size() == 4 * pixelCount, "incorrect destination buffer size");
 
-  const unsigned char* paletteData = (transparency == PaletteTransparency::Opaque)
-                                       ? m_data->opaqueData.data()
-                                       : m_data->index255TransparentData.data();
-
-  // Write rgba pixels
+  const auto& paletteData = (transparency == PaletteTransparency::Opaque)
+                              ? m_data->opaqueData
+                              : m_data->index255TransparentData;
+
+  // Copy the palette into a table of 256 entries so that malformed images cannot index
+  // past the end of a short palette.
+  auto colors = std::array<uint32_t, 256>{};
+  std::memcpy(
+    colors.data(),
+    paletteData.data(),
+    std::min(paletteData.size(), colors.size() * sizeof(uint32_t)));
+
+  // Read the indices into the last quarter of the destination buffer. When pixel i is
+  // written to bytes [4i, 4i+3], the indices up to i have already been read, and the
+  // next index is stored at byte 3 * pixelCount + i + 1 > 4i + 3, so the expansion can
+  // run in place.
   auto* const rgbaData = rgbaImage.data();
-  for (size_t i = 0; i < pixelCount; ++i)
+  auto* const indices = rgbaData + 3 * pixelCount;
+  reader.read(indices, pixelCount);
+
+  // Count how often each index occurs. Using several histograms avoids stalling on long
+  // runs of the same index.
+  auto histograms = std::array<std::array<uint32_t, 256>, 4>{};
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
   {
-    const int index = reader.readInt<unsigned char>();
-
-    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+    const auto i0 = indices[i + 0];
+    const auto i1 = indices[i + 1];
+    const auto i2 = indices[i + 2];
+    const auto i3 = indices[i + 3];
+
+    ++histograms[0][i0];
+    ++histograms[1][i1];
+    ++histograms[2][i2];
+    ++histograms[3][i3];
+
+    std::memcpy(rgbaData + 4 * (i + 0), &colors[i0], 4);
+    std::memcpy(rgbaData + 4 * (i + 1), &colors[i1], 4);
+    std::memcpy(rgbaData + 4 * (i + 2), &colors[i2], 4);
+    std::memcpy(rgbaData + 4 * (i + 3), &colors[i3], 4);
+  }
+  for (; i < pixelCount; ++i)
+  {
+    const auto index = indices[i];
+    ++histograms[0][index];
+    std::memcpy(rgbaData + 4 * i, &colors[index], 4);
   }
 
-  // Check average color
-  uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
+  // Derive the average color and the transparency from the histogram instead of
+  // visiting every pixel again.
+  uint64_t colorSum[3] = {0, 0, 0};
+  unsigned char andAlpha = 0xFF;
+  for (size_t index = 0; index < colors.size(); ++index)
   {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+    const auto count = uint64_t(histograms[0][index]) + histograms[1][index]
+                       + histograms[2][index] + histograms[3][index];
+    if (count > 0)
+    {
+      unsigned char color[4];
+      std::memcpy(color, &colors[index], 4);
+
+      colorSum[0] += count * color[0];
+      colorSum[1] += count * color[1];
+      colorSum[2] += count * color[2];
+      andAlpha = static_cast<unsigned char>(andAlpha & color[3]);
+    }
   }
+
   averageColor = Color{
     float(colorSum[0]) / (255.0f * float(pixelCount)),
     float(colorSum[1]) / (255.0f * float(pixelCount)),
     float(colorSum[2]) / (255.0f * float(pixelCount)),
     1.0f};
 
-  // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
-
-  return hasTransparency;
+  return transparency == PaletteTransparency::Index255Transparent && andAlpha != 0xFF;
 }
 
 bool operator==(const Palette& lhs, const Palette& rhs)
@@ -476,6 +476,11 @@ GroupNode* PatchNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void PatchNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void PatchNode::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
@@ -62,7 +62,7 @@ IssueQuickFix makeMoveBrushesToWorldQuickFix()
 } // namespace
 
 PointEntityWithBrushesValidator::PointEntityWithBrushesValidator()
-  : Validator{Type, "Point entity with brushes"}
+  : Validator{Type, "Point entity with brushes", true}
 {
   addQuickFix(makeMoveBrushesToWorldQuickFix());
 }
@@ -28,6 +28,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -122,6 +123,13 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Vertices are allocated from a pool to avoid a heap allocation for every element of a
+   * polyhedron, see kdl::fixed_size_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the position of this vertex.
    */
@@ -274,6 +282,13 @@ private:
   explicit Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Edges are allocated from a pool to avoid a heap allocation for every element of a
+   * polyhedron, see kdl::fixed_size_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -595,6 +610,13 @@ private:
   explicit Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Half edges are allocated from a pool to avoid a heap allocation for every element of a
+   * polyhedron, see kdl::fixed_size_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -826,6 +848,13 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Faces are allocated from a pool to avoid a heap allocation for every element of a
+   * polyhedron, see kdl::fixed_size_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
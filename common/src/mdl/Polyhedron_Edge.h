@@ -22,6 +22,8 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/fixed_size_pool.h"
+
 #include "vm/distance.h"
 #include "vm/plane.h"
 #include "vm/scalar.h"
@@ -73,6 +75,21 @@ Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Edge));
+  using Pool = kdl::fixed_size_pool<sizeof(Polyhedron_Edge), alignof(Polyhedron_Edge)>;
+  return Pool::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr)
+{
+  using Pool = kdl::fixed_size_pool<sizeof(Polyhedron_Edge), alignof(Polyhedron_Edge)>;
+  Pool::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_Edge<T, FP, VP>::Vertex* Polyhedron_Edge<T, FP, VP>::firstVertex()
   const
@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/fixed_size_pool.h"
 #include "kdl/optional_utils.h"
 
 #include "vm/constants.h"
@@ -77,6 +78,21 @@ Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   countAndSetFace(m_boundary.front(), m_boundary.back(), this);
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Face));
+  using Pool = kdl::fixed_size_pool<sizeof(Polyhedron_Face), alignof(Polyhedron_Face)>;
+  return Pool::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr)
+{
+  using Pool = kdl::fixed_size_pool<sizeof(Polyhedron_Face), alignof(Polyhedron_Face)>;
+  Pool::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const typename Polyhedron_Face<T, FP, VP>::HalfEdgeList& Polyhedron_Face<T, FP, VP>::
   boundary() const
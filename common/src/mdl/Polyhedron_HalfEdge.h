@@ -21,6 +21,8 @@
 
 #include "Polyhedron.h"
 
+#include "kdl/fixed_size_pool.h"
+
 namespace tb::mdl
 {
 template <typename T, typename FP, typename VP>
@@ -59,6 +61,24 @@ Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   setAsLeaving();
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(
+  [[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_HalfEdge));
+  using Pool =
+    kdl::fixed_size_pool<sizeof(Polyhedron_HalfEdge), alignof(Polyhedron_HalfEdge)>;
+  return Pool::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr)
+{
+  using Pool =
+    kdl::fixed_size_pool<sizeof(Polyhedron_HalfEdge), alignof(Polyhedron_HalfEdge)>;
+  Pool::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_HalfEdge<T, FP, VP>::Vertex* Polyhedron_HalfEdge<T, FP, VP>::origin()
   const
@@ -21,6 +21,7 @@
 
 #include "Polyhedron.h"
 
+#include "kdl/fixed_size_pool.h"
 #include "kdl/intrusive_circular_list.h"
 
 namespace tb::mdl
@@ -63,6 +64,23 @@ Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
 {
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Vertex));
+  using Pool =
+    kdl::fixed_size_pool<sizeof(Polyhedron_Vertex), alignof(Polyhedron_Vertex)>;
+  return Pool::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr)
+{
+  using Pool =
+    kdl::fixed_size_pool<sizeof(Polyhedron_Vertex), alignof(Polyhedron_Vertex)>;
+  Pool::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const vm::vec<T, 3>& Polyhedron_Vertex<T, FP, VP>::position() const
 {
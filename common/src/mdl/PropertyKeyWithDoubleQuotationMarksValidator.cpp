@@ -38,7 +38,7 @@ const auto Type = freeIssueType();
 
 PropertyKeyWithDoubleQuotationMarksValidator::
   PropertyKeyWithDoubleQuotationMarksValidator()
-  : Validator{Type, "Invalid entity property keys"}
+  : Validator{Type, "Invalid entity property keys", true}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
   addQuickFix(makeTransformEntityPropertiesQuickFix(
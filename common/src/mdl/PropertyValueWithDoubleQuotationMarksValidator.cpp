@@ -38,7 +38,7 @@ const auto Type = freeIssueType();
 
 PropertyValueWithDoubleQuotationMarksValidator::
   PropertyValueWithDoubleQuotationMarksValidator()
-  : Validator{Type, "Invalid entity property values"}
+  : Validator{Type, "Invalid entity property values", true}
 {
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
   addQuickFix(makeTransformEntityPropertiesQuickFix(
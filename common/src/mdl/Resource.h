@@ -49,6 +49,19 @@ private:
 template <typename T>
 using ResourceLoader = std::function<Result<T>()>;
 
+enum class ResourceLoadMode
+{
+  /**
+   * The resource is loaded when it is processed for the first time.
+   */
+  Immediate,
+  /**
+   * The resource is not loaded until loading is requested by calling
+   * Resource::requestLoading.
+   */
+  OnDemand,
+};
+
 using ErrorHandler = std::function<void(const ResourceId&, const std::string&)>;
 
 struct ProcessContext
@@ -79,6 +92,14 @@ public:
 using Task = std::function<std::unique_ptr<TaskResult>()>;
 using TaskRunner = std::function<std::future<std::unique_ptr<TaskResult>>(Task)>;
 
+template <typename T>
+struct ResourceDeferred
+{
+  ResourceLoader<T> loader;
+
+  kdl_reflect_inline_empty(ResourceDeferred);
+};
+
 template <typename T>
 struct ResourceUnloaded
 {
@@ -133,6 +154,7 @@ struct ResourceFailed
 
 template <typename T>
 using ResourceState = std::variant<
+  ResourceDeferred<T>,
   ResourceUnloaded<T>,
   ResourceLoading<T>,
   ResourceLoaded<T>,
@@ -151,6 +173,18 @@ std::ostream& operator<<(std::ostream& lhs, const ResourceState<T>& rhs)
 namespace detail
 {
 
+template <typename T>
+ResourceState<T> load(const ResourceLoader<T>& loader)
+{
+  return loader() | kdl::transform([](auto value) -> ResourceState<T> {
+           return ResourceLoaded<T>{std::move(value)};
+         })
+         | kdl::transform_error([](auto error) -> ResourceState<T> {
+             return ResourceFailed{std::move(error.msg)};
+           })
+         | kdl::value();
+}
+
 template <typename T>
 ResourceState<T> triggerLoading(ResourceUnloaded<T> state, TaskRunner taskRunner)
 {
@@ -221,6 +255,7 @@ ResourceState<T> drop(ResourceDropping<T> state, const bool glContextAvailable)
  *
  * | State          | Transition       | New state       |
  * |----------------|------------------|-----------------|
+ * | Deferred       | requestLoading   | Unloaded        |
  * | Unloaded       | process          | Loading         |
  * | Loading        | process          | Loaded or Failed|
  * | Loaded         | process          | Ready           |
@@ -228,6 +263,9 @@ ResourceState<T> drop(ResourceDropping<T> state, const bool glContextAvailable)
  * | Dropping       | process          | Dropped         |
  * | Dropped        | -                | -               |
  * | Failed         | -                | -               |
+ *
+ * A resource that is created with ResourceLoadMode::OnDemand starts in the Deferred
+ * state and is not processed until loading is requested.
  */
 template <typename T>
 class Resource
@@ -239,8 +277,13 @@ private:
   kdl_reflect_inline(Resource, m_state);
 
 public:
-  explicit Resource(ResourceLoader<T> loader)
-    : m_state(ResourceUnloaded<T>{std::move(loader)})
+  explicit Resource(
+    ResourceLoader<T> loader,
+    const ResourceLoadMode loadMode = ResourceLoadMode::Immediate)
+    : m_state(
+        loadMode == ResourceLoadMode::OnDemand
+          ? ResourceState<T>{ResourceDeferred<T>{std::move(loader)}}
+          : ResourceState<T>{ResourceUnloaded<T>{std::move(loader)}})
   {
   }
 
@@ -277,12 +320,28 @@ public:
 
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
+  bool isDeferred() const { return std::holds_alternative<ResourceDeferred<T>>(m_state); }
+
   bool needsProcessing() const
   {
-    return !std::holds_alternative<ResourceReady<T>>(m_state)
+    return !std::holds_alternative<ResourceDeferred<T>>(m_state)
+           && !std::holds_alternative<ResourceReady<T>>(m_state)
            && !std::holds_alternative<ResourceFailed>(m_state);
   }
 
+  /**
+   * Requests loading a resource that was created with ResourceLoadMode::OnDemand. The
+   * resource will be loaded the next time it is processed. Has no effect if the resource
+   * is not in the Deferred state.
+   */
+  void requestLoading()
+  {
+    if (auto* deferredState = std::get_if<ResourceDeferred<T>>(&m_state))
+    {
+      m_state = ResourceUnloaded<T>{std::move(deferredState->loader)};
+    }
+  }
+
   bool process(TaskRunner taskRunner, const ProcessContext& context)
   {
     const auto previousStateIndex = m_state.index();
@@ -332,14 +391,11 @@ public:
   {
     m_state = std::visit(
       kdl::overload(
+        [&](ResourceDeferred<T> state) -> ResourceState<T> {
+          return detail::load(state.loader);
+        },
         [&](ResourceUnloaded<T> state) -> ResourceState<T> {
-          return state.loader() | kdl::transform([](auto value) -> ResourceState<T> {
-                   return ResourceLoaded<T>{std::move(value)};
-                 })
-                 | kdl::transform_error([](auto error) -> ResourceState<T> {
-                     return ResourceFailed{std::move(error.msg)};
-                   })
-                 | kdl::value();
+          return detail::load(state.loader);
         },
         [](auto state) -> ResourceState<T> { return state; }),
       std::move(m_state));
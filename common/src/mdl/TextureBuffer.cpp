@@ -21,7 +21,6 @@
 
 #include "Ensure.h"
 
-#include <FreeImage.h>
 #include <algorithm>
 #include <iostream>
 
@@ -128,38 +127,76 @@ void setMipBufferSize(
   }
 }
 
-void resizeMips(
-  TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize)
+namespace
 {
-  if (oldSize != newSize)
+
+/**
+ * Computes the next mip level by averaging blocks of 2*2 pixels. If a dimension of the
+ * source is odd, the last row or column of the source is ignored, and if it is 1, the
+ * source row or column is used twice.
+ */
+void downsample(
+  const unsigned char* source,
+  const size_t sourceWidth,
+  const size_t sourceHeight,
+  unsigned char* destination,
+  const size_t destinationWidth,
+  const size_t destinationHeight)
+{
+  const auto sourcePitch = 4 * sourceWidth;
+  const auto dx = sourceWidth > 1 ? size_t(4) : size_t(0);
+  const auto dy = sourceHeight > 1 ? sourcePitch : size_t(0);
+
+  for (size_t y = 0; y < destinationHeight; ++y)
   {
-    for (size_t i = 0; i < buffers.size(); ++i)
+    const auto* row0 = source + 2 * y * sourcePitch;
+    const auto* row1 = row0 + dy;
+    auto* out = destination + 4 * y * destinationWidth;
+
+    for (size_t x = 0; x < destinationWidth; ++x)
     {
-      const auto div = size_t(1) << i;
-      const auto oldWidth = int(oldSize.x() / div);
-      const auto oldHeight = int(oldSize.y() / div);
-      const auto oldPitch = oldWidth * 3;
-      auto* oldPtr = buffers[i].data();
-
-      auto* oldBitmap = FreeImage_ConvertFromRawBits(
-        oldPtr, oldWidth, oldHeight, oldPitch, 24, 0xFF0000, 0x00FF00, 0x0000FF, true);
-      ensure(oldBitmap != nullptr, "oldBitmap is null");
-
-      const auto newWidth = int(newSize.x() / div);
-      const auto newHeight = int(newSize.y() / div);
-      const auto newPitch = newWidth * 3;
-      auto* newBitmap = FreeImage_Rescale(oldBitmap, newWidth, newHeight, FILTER_BICUBIC);
-      ensure(newBitmap != nullptr, "newBitmap is null");
-
-      buffers[i] = TextureBuffer{3 * newSize.x() * newSize.y()};
-      auto* newPtr = buffers[i].data();
-
-      FreeImage_ConvertToRawBits(
-        newPtr, newBitmap, newPitch, 24, 0xFF0000, 0x00FF00, 0x0000FF, true);
-      FreeImage_Unload(oldBitmap);
-      FreeImage_Unload(newBitmap);
+      const auto* p00 = row0 + 8 * x;
+      const auto* p01 = p00 + dx;
+      const auto* p10 = row1 + 8 * x;
+      const auto* p11 = p10 + dx;
+
+      for (size_t c = 0; c < 4; ++c)
+      {
+        out[4 * x + c] = static_cast<unsigned char>(
+          (unsigned(p00[c]) + unsigned(p01[c]) + unsigned(p10[c]) + unsigned(p11[c]) + 2)
+          / 4);
+      }
     }
   }
 }
 
+} // namespace
+
+void generateMips(
+  TextureBufferList& buffers,
+  const size_t width,
+  const size_t height,
+  const GLenum format)
+{
+  ensure(format == GL_RGBA || format == GL_BGRA, "format is GL_RGBA or GL_BGRA");
+
+  for (size_t level = 1; level < buffers.size(); ++level)
+  {
+    const auto sourceSize = sizeAtMipLevel(width, height, level - 1);
+    const auto destinationSize = sizeAtMipLevel(width, height, level);
+    ensure(
+      buffers[level - 1].size() >= 4 * sourceSize.x() * sourceSize.y()
+        && buffers[level].size() >= 4 * destinationSize.x() * destinationSize.y(),
+      "mip buffers are large enough");
+
+    downsample(
+      buffers[level - 1].data(),
+      sourceSize.x(),
+      sourceSize.y(),
+      buffers[level].data(),
+      destinationSize.x(),
+      destinationSize.y());
+  }
+}
+
 } // namespace tb::mdl
@@ -60,7 +60,12 @@ void setMipBufferSize(
   size_t height,
   GLenum format);
 
-void resizeMips(
-  TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize);
+/**
+ * Computes the mip levels 1 to buffers.size() - 1 from mip level 0 using a box filter.
+ *
+ * The buffers must have the sizes set by setMipBufferSize, and the format must be GL_RGBA
+ * or GL_BGRA.
+ */
+void generateMips(TextureBufferList& buffers, size_t width, size_t height, GLenum format);
 
 } // namespace tb::mdl
@@ -0,0 +1,396 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TriangleBvh.h"
+
+#include "Ensure.h"
+
+#include "vm/scalar.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t BinCount = 16;
+
+// Beyond this depth, nodes are split at the median so that the depth of the tree stays
+// bounded even for degenerate inputs.
+constexpr size_t MaxSahDepth = 40;
+constexpr size_t MaxDepth = 80;
+
+size_t binIndex(const float value, const float min, const float extent)
+{
+  return std::min(BinCount - 1, size_t((value - min) / extent * float(BinCount)));
+}
+
+float surfaceArea(const vm::bbox3f& bounds)
+{
+  const auto size = bounds.size();
+  return 2.0f * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+}
+
+/**
+ * Returns the distance at which the given ray enters the given box, or nullopt if the
+ * ray misses the box or enters it after the given maximum distance.
+ */
+std::optional<float> entryDistance(
+  const vm::bbox3f& bounds,
+  const vm::ray3f& ray,
+  const vm::vec3f& invDirection,
+  const float maxDistance)
+{
+  auto tMin = 0.0f;
+  auto tMax = maxDistance;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (ray.direction[i] == 0.0f)
+    {
+      // the ray is parallel to the slab, avoid computing 0 * inf
+      if (ray.origin[i] < bounds.min[i] || ray.origin[i] > bounds.max[i])
+      {
+        return std::nullopt;
+      }
+    }
+    else
+    {
+      const auto t1 = (bounds.min[i] - ray.origin[i]) * invDirection[i];
+      const auto t2 = (bounds.max[i] - ray.origin[i]) * invDirection[i];
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+    }
+  }
+
+  return tMin <= tMax ? std::optional{tMin} : std::nullopt;
+}
+
+} // namespace
+
+struct TriangleBvh::BuildTriangle
+{
+  vm::bbox3f bounds;
+  vm::vec3f centroid;
+  size_t index;
+};
+
+TriangleBvh::TriangleBvh(const std::vector<vm::vec3f>& triangles)
+  : m_triangleCount{triangles.size() / 3}
+{
+  assert(triangles.size() % 3 == 0);
+
+  if (m_triangleCount == 0)
+  {
+    return;
+  }
+
+  auto buildTriangles = std::vector<BuildTriangle>{};
+  buildTriangles.reserve(m_triangleCount);
+  for (size_t i = 0; i < m_triangleCount; ++i)
+  {
+    auto bounds = vm::bbox3f::builder{};
+    bounds.add(triangles[i * 3 + 0]);
+    bounds.add(triangles[i * 3 + 1]);
+    bounds.add(triangles[i * 3 + 2]);
+    buildTriangles.push_back({bounds.bounds(), bounds.bounds().center(), i});
+  }
+
+  m_nodes.reserve(2 * (m_triangleCount + PacketSize - 1) / PacketSize);
+  m_packets.reserve((m_triangleCount + PacketSize - 1) / PacketSize);
+  build(buildTriangles, 0, buildTriangles.size(), 0, triangles);
+
+  m_nodes.shrink_to_fit();
+  m_packets.shrink_to_fit();
+}
+
+size_t TriangleBvh::triangleCount() const
+{
+  return m_triangleCount;
+}
+
+size_t TriangleBvh::memoryUsage() const
+{
+  return m_nodes.capacity() * sizeof(Node) + m_packets.capacity() * sizeof(Packet);
+}
+
+std::optional<float> TriangleBvh::intersect(const vm::ray3f& ray) const
+{
+  if (m_nodes.empty())
+  {
+    return std::nullopt;
+  }
+
+  const auto& o = ray.origin;
+  const auto& d = ray.direction;
+  const auto invDirection = vm::vec3f{1.0f / d.x(), 1.0f / d.y(), 1.0f / d.z()};
+
+  constexpr auto eps = vm::constants<float>::almost_zero();
+  constexpr auto noHit = std::numeric_limits<float>::max();
+  auto closestDistance = noHit;
+
+  struct StackEntry
+  {
+    uint32_t nodeIndex;
+    float entryDistance;
+  };
+  auto stack = std::array<StackEntry, MaxDepth + 2>{};
+  auto stackSize = size_t(0);
+
+  if (const auto rootEntry = entryDistance(m_nodes[0].bounds, ray, invDirection, noHit))
+  {
+    stack[stackSize++] = {0, *rootEntry};
+  }
+
+  while (stackSize > 0)
+  {
+    const auto [nodeIndex, nodeEntryDistance] = stack[--stackSize];
+    if (nodeEntryDistance > closestDistance)
+    {
+      continue;
+    }
+
+    const auto& node = m_nodes[nodeIndex];
+    if (node.leaf)
+    {
+      // Möller-Trumbore for all lanes of the packet, using the same tolerances as
+      // vm::intersect_ray_triangle. The loop has no early exits so that it can be
+      // vectorized.
+      const auto& packet = m_packets[node.offset];
+      auto distances = Packet::Lanes{};
+      for (size_t i = 0; i < PacketSize; ++i)
+      {
+        const auto px = d.y() * packet.e2z[i] - d.z() * packet.e2y[i];
+        const auto py = d.z() * packet.e2x[i] - d.x() * packet.e2z[i];
+        const auto pz = d.x() * packet.e2y[i] - d.y() * packet.e2x[i];
+        const auto a = px * packet.e1x[i] + py * packet.e1y[i] + pz * packet.e1z[i];
+
+        const auto tx = o.x() - packet.p0x[i];
+        const auto ty = o.y() - packet.p0y[i];
+        const auto tz = o.z() - packet.p0z[i];
+        const auto qx = ty * packet.e1z[i] - tz * packet.e1y[i];
+        const auto qy = tz * packet.e1x[i] - tx * packet.e1z[i];
+        const auto qz = tx * packet.e1y[i] - ty * packet.e1x[i];
+
+        const auto u = (qx * packet.e2x[i] + qy * packet.e2y[i] + qz * packet.e2z[i]) / a;
+        const auto v = (px * tx + py * ty + pz * tz) / a;
+        const auto w = (qx * d.x() + qy * d.y() + qz * d.z()) / a;
+
+        const auto hit = std::abs(a) > eps && u >= -eps && v >= -eps && w >= -eps
+                         && v + w - 1.0f <= eps;
+        distances[i] = hit ? u : noHit;
+      }
+
+      for (const auto distance : distances)
+      {
+        closestDistance = std::min(closestDistance, distance);
+      }
+    }
+    else
+    {
+      const auto leftIndex = nodeIndex + 1;
+      const auto rightIndex = node.offset;
+      const auto leftEntry =
+        entryDistance(m_nodes[leftIndex].bounds, ray, invDirection, closestDistance);
+      const auto rightEntry =
+        entryDistance(m_nodes[rightIndex].bounds, ray, invDirection, closestDistance);
+
+      // push the farther child first so that the nearer child is visited first
+      if (leftEntry && rightEntry)
+      {
+        if (*leftEntry <= *rightEntry)
+        {
+          stack[stackSize++] = {rightIndex, *rightEntry};
+          stack[stackSize++] = {leftIndex, *leftEntry};
+        }
+        else
+        {
+          stack[stackSize++] = {leftIndex, *leftEntry};
+          stack[stackSize++] = {rightIndex, *rightEntry};
+        }
+      }
+      else if (leftEntry)
+      {
+        stack[stackSize++] = {leftIndex, *leftEntry};
+      }
+      else if (rightEntry)
+      {
+        stack[stackSize++] = {rightIndex, *rightEntry};
+      }
+    }
+  }
+
+  return closestDistance != noHit ? std::optional{closestDistance} : std::nullopt;
+}
+
+uint32_t TriangleBvh::build(
+  std::vector<BuildTriangle>& buildTriangles,
+  const size_t first,
+  const size_t last,
+  const size_t depth,
+  const std::vector<vm::vec3f>& triangles)
+{
+  ensure(depth <= MaxDepth, "BVH depth is bounded");
+
+  const auto nodeIndex = uint32_t(m_nodes.size());
+  m_nodes.emplace_back();
+
+  auto boundsBuilder = vm::bbox3f::builder{};
+  auto centroidBoundsBuilder = vm::bbox3f::builder{};
+  for (size_t i = first; i < last; ++i)
+  {
+    boundsBuilder.add(buildTriangles[i].bounds);
+    centroidBoundsBuilder.add(buildTriangles[i].centroid);
+  }
+  const auto bounds = boundsBuilder.bounds();
+  const auto count = last - first;
+
+  if (count <= PacketSize)
+  {
+    // lanes without a triangle keep zero edges and are never hit
+    auto& packet = m_packets.emplace_back();
+    for (size_t lane = 0; lane < count; ++lane)
+    {
+      const auto triangleIndex = buildTriangles[first + lane].index;
+      const auto& p0 = triangles[triangleIndex * 3 + 0];
+      const auto e1 = triangles[triangleIndex * 3 + 1] - p0;
+      const auto e2 = triangles[triangleIndex * 3 + 2] - p0;
+      packet.p0x[lane] = p0.x();
+      packet.p0y[lane] = p0.y();
+      packet.p0z[lane] = p0.z();
+      packet.e1x[lane] = e1.x();
+      packet.e1y[lane] = e1.y();
+      packet.e1z[lane] = e1.z();
+      packet.e2x[lane] = e2.x();
+      packet.e2y[lane] = e2.y();
+      packet.e2z[lane] = e2.z();
+    }
+
+    m_nodes[nodeIndex] = {bounds, uint32_t(m_packets.size() - 1), true};
+    return nodeIndex;
+  }
+
+  const auto centroidBounds = centroidBoundsBuilder.bounds();
+  const auto begin = buildTriangles.begin() + std::ptrdiff_t(first);
+  const auto end = buildTriangles.begin() + std::ptrdiff_t(last);
+
+  auto mid = first;
+  if (depth < MaxSahDepth)
+  {
+    // find the bin boundary with the lowest surface area heuristic cost
+    auto bestCost = std::numeric_limits<float>::max();
+    auto bestAxis = size_t(0);
+    auto bestSplit = size_t(0);
+
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      const auto extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+      if (extent <= 0.0f)
+      {
+        continue;
+      }
+
+      auto binBounds = std::array<vm::bbox3f::builder, BinCount>{};
+      auto binCounts = std::array<size_t, BinCount>{};
+      for (auto it = begin; it != end; ++it)
+      {
+        const auto bin = binIndex(it->centroid[axis], centroidBounds.min[axis], extent);
+        binBounds[bin].add(it->bounds);
+        ++binCounts[bin];
+      }
+
+      // rightCosts[i] is the cost of the bins i..BinCount-1
+      auto rightCosts = std::array<float, BinCount>{};
+      auto rightBounds = vm::bbox3f::builder{};
+      auto rightCount = size_t(0);
+      for (size_t i = BinCount - 1; i > 0; --i)
+      {
+        if (binCounts[i] > 0)
+        {
+          rightBounds.add(binBounds[i].bounds());
+          rightCount += binCounts[i];
+        }
+        rightCosts[i] =
+          rightCount > 0 ? float(rightCount) * surfaceArea(rightBounds.bounds()) : 0.0f;
+      }
+
+      auto leftBounds = vm::bbox3f::builder{};
+      auto leftCount = size_t(0);
+      for (size_t i = 1; i < BinCount; ++i)
+      {
+        if (binCounts[i - 1] > 0)
+        {
+          leftBounds.add(binBounds[i - 1].bounds());
+          leftCount += binCounts[i - 1];
+        }
+
+        if (leftCount > 0 && leftCount < count)
+        {
+          const auto cost =
+            float(leftCount) * surfaceArea(leftBounds.bounds()) + rightCosts[i];
+          if (cost < bestCost)
+          {
+            bestCost = cost;
+            bestAxis = axis;
+            bestSplit = i;
+          }
+        }
+      }
+    }
+
+    if (bestSplit > 0)
+    {
+      const auto axisMin = centroidBounds.min[bestAxis];
+      const auto extent = centroidBounds.max[bestAxis] - axisMin;
+      const auto it = std::partition(begin, end, [&](const auto& buildTriangle) {
+        return binIndex(buildTriangle.centroid[bestAxis], axisMin, extent) < bestSplit;
+      });
+      mid = first + size_t(std::distance(begin, it));
+    }
+  }
+
+  if (mid == first || mid == last)
+  {
+    // split at the median along the longest axis of the centroid bounds
+    const auto size = centroidBounds.size();
+    const auto axis = size.x() >= size.y() && size.x() >= size.z() ? size_t(0)
+                      : size.y() >= size.z()                         ? size_t(1)
+                                                                     : size_t(2);
+    mid = first + count / 2;
+    std::nth_element(
+      begin,
+      buildTriangles.begin() + std::ptrdiff_t(mid),
+      end,
+      [&](const auto& lhs, const auto& rhs) {
+        return lhs.centroid[axis] < rhs.centroid[axis];
+      });
+  }
+
+  build(buildTriangles, first, mid, depth + 1, triangles);
+  const auto rightIndex = build(buildTriangles, mid, last, depth + 1, triangles);
+
+  m_nodes[nodeIndex] = {bounds, rightIndex, false};
+  return nodeIndex;
+}
+
+} // namespace tb::mdl
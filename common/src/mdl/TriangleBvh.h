@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace tb::mdl
+{
+
+/**
+ * A bounding volume hierarchy over a static set of triangles, used to find the closest
+ * intersection of a ray with a triangle mesh.
+ *
+ * The hierarchy is built using a binned surface area heuristic. The nodes are stored in
+ * depth first order so that the left child of an inner node directly follows its parent.
+ * Each leaf stores up to four triangles in a single packet laid out as a structure of
+ * arrays, so that a ray can be tested against all triangles of a leaf in one loop that
+ * the compiler can vectorize.
+ */
+class TriangleBvh
+{
+public:
+  static constexpr size_t PacketSize = 4;
+
+private:
+  struct Node
+  {
+    vm::bbox3f bounds;
+    // for leaves, the index of the leaf's packet, for inner nodes, the index of the
+    // right child
+    uint32_t offset = 0;
+    bool leaf = false;
+  };
+
+  struct Packet
+  {
+    using Lanes = std::array<float, PacketSize>;
+
+    // the first vertex of each triangle and the edges to the second and third vertex
+    Lanes p0x, p0y, p0z;
+    Lanes e1x, e1y, e1z;
+    Lanes e2x, e2y, e2z;
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<Packet> m_packets;
+  size_t m_triangleCount = 0;
+
+public:
+  /**
+   * Builds a hierarchy over the given triangles. Each consecutive triple of the given
+   * points forms one triangle.
+   *
+   * @param triangles the triangle vertices, the number of vertices must be a multiple of
+   * three
+   */
+  explicit TriangleBvh(const std::vector<vm::vec3f>& triangles);
+
+  /**
+   * Returns the number of triangles in this hierarchy.
+   */
+  size_t triangleCount() const;
+
+  /**
+   * Returns the number of bytes allocated by this hierarchy.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Intersects the given ray with the triangles in this hierarchy and returns the
+   * distance to the closest point of intersection. A triangle is hit if and only if
+   * vm::intersect_ray_triangle reports a hit for it.
+   *
+   * @param ray the ray to intersect
+   * @return the distance to the closest point of intersection or nullopt if the ray does
+   * not hit any triangle
+   */
+  std::optional<float> intersect(const vm::ray3f& ray) const;
+
+private:
+  struct BuildTriangle;
+
+  uint32_t build(
+    std::vector<BuildTriangle>& buildTriangles,
+    size_t first,
+    size_t last,
+    size_t depth,
+    const std::vector<vm::vec3f>& triangles);
+};
+
+} // namespace tb::mdl
@@ -0,0 +1,149 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ValidationEngine.h"
+
+#include "mdl/Issue.h"
+#include "mdl/Node.h"
+#include "mdl/Validator.h"
+
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr auto BatchSize = size_t(512);
+
+} // namespace
+
+bool IssueDelta::empty() const
+{
+  return addedIssues.empty() && removedIssues.empty();
+}
+
+ValidationEngine::ValidationEngine() = default;
+
+ValidationEngine::~ValidationEngine() = default;
+
+size_t ValidationEngine::invalidNodeCount() const
+{
+  const auto lock = std::lock_guard{m_invalidNodesMutex};
+  return m_invalidNodes.size();
+}
+
+void ValidationEngine::nodeIssuesWereInvalidated(Node& node)
+{
+  const auto lock = std::lock_guard{m_invalidNodesMutex};
+  m_invalidNodes.insert(&node);
+}
+
+void ValidationEngine::nodeWasRemoved(Node& node)
+{
+  {
+    const auto lock = std::lock_guard{m_invalidNodesMutex};
+    m_invalidNodes.erase(&node);
+  }
+  m_removedIssues = kdl::vec_concat(std::move(m_removedIssues), node.cachedIssues());
+}
+
+std::vector<Node*> ValidationEngine::takeInvalidNodes(const size_t maxCount)
+{
+  const auto lock = std::lock_guard{m_invalidNodesMutex};
+
+  auto result = std::vector<Node*>{};
+  result.reserve(std::min(maxCount, m_invalidNodes.size()));
+  while (!m_invalidNodes.empty() && result.size() < maxCount)
+  {
+    result.push_back(*m_invalidNodes.begin());
+    m_invalidNodes.erase(m_invalidNodes.begin());
+  }
+  return result;
+}
+
+IssueDelta ValidationEngine::validate(
+  const std::vector<const Validator*>& validators,
+  kdl::task_manager& taskManager,
+  const std::chrono::milliseconds timeBudget)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  // the consumer has processed the previous delta
+  m_retiredIssues.clear();
+
+  auto result = IssueDelta{{}, std::exchange(m_removedIssues, {})};
+
+  auto threadSafeValidators = std::vector<const Validator*>{};
+  auto otherValidators = std::vector<const Validator*>{};
+  std::ranges::partition_copy(
+    validators,
+    std::back_inserter(threadSafeValidators),
+    std::back_inserter(otherValidators),
+    [](const auto* validator) { return validator->threadSafe(); });
+
+  while (Clock::now() - start < timeBudget)
+  {
+    auto batch = takeInvalidNodes(BatchSize);
+    if (batch.empty())
+    {
+      break;
+    }
+
+    auto batchIssues = taskManager.parallel_transform(batch, [&](auto* node) {
+      auto issues = std::vector<std::unique_ptr<Issue>>{};
+      for (const auto* validator : threadSafeValidators)
+      {
+        validator->validate(*node, issues);
+      }
+      return issues;
+    });
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      auto& node = *batch[i];
+      auto& issues = batchIssues[i];
+      for (const auto* validator : otherValidators)
+      {
+        validator->validate(node, issues);
+      }
+
+      for (const auto& issue : issues)
+      {
+        result.addedIssues.push_back(issue.get());
+      }
+
+      for (auto& oldIssue : node.setIssues(std::move(issues)))
+      {
+        result.removedIssues.push_back(oldIssue.get());
+        m_retiredIssues.push_back(std::move(oldIssue));
+      }
+    }
+  }
+
+  return result;
+}
+
+} // namespace tb::mdl
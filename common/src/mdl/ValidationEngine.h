@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb::mdl
+{
+class Issue;
+class Node;
+class Validator;
+
+/**
+ * The changes to the issues of a world that result from validating its nodes.
+ */
+struct IssueDelta
+{
+  std::vector<const Issue*> addedIssues;
+  std::vector<const Issue*> removedIssues;
+
+  bool empty() const;
+};
+
+/**
+ * Keeps track of the nodes of a world whose issues have been invalidated and validates
+ * them incrementally.
+ *
+ * The world adds its nodes to this engine when they are added to the world or when their
+ * issues are invalidated, and removes them when they are removed from the world. Calling
+ * validate validates a bounded number of nodes and returns the resulting issue delta.
+ *
+ * The removed issues of a delta may already have been destroyed and must not be
+ * dereferenced. They only serve to identify issues that were added by earlier deltas.
+ * Since the engine cannot report issues that it did not see, the nodes of a world that is
+ * validated using this engine should not be validated by calling Node::issues.
+ *
+ * Nodes may invalidate their issues concurrently, e.g. when materials are assigned to
+ * brushes in parallel, so the set of invalid nodes is guarded by a mutex.
+ */
+class ValidationEngine
+{
+private:
+  mutable std::mutex m_invalidNodesMutex;
+  std::unordered_set<Node*> m_invalidNodes;
+  std::vector<const Issue*> m_removedIssues;
+  std::vector<std::unique_ptr<Issue>> m_retiredIssues;
+
+public:
+  ValidationEngine();
+  ~ValidationEngine();
+
+  size_t invalidNodeCount() const;
+
+  void nodeIssuesWereInvalidated(Node& node);
+  void nodeWasRemoved(Node& node);
+
+  /**
+   * Validates invalid nodes until all nodes are valid or until the given time budget is
+   * exhausted. At least one batch of nodes is validated unless the time budget is zero.
+   *
+   * The thread safe validators validate the nodes of a batch in parallel using the given
+   * task manager. The remaining validators are run on the calling thread.
+   *
+   * Returns the issues that were added and removed since the last call.
+   */
+  IssueDelta validate(
+    const std::vector<const Validator*>& validators,
+    kdl::task_manager& taskManager,
+    std::chrono::milliseconds timeBudget);
+
+private:
+  std::vector<Node*> takeInvalidNodes(size_t maxCount);
+};
+
+} // namespace tb::mdl
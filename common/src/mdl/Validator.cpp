@@ -51,6 +51,11 @@ std::vector<const IssueQuickFix*> Validator::quickFixes() const
   });
 }
 
+bool Validator::threadSafe() const
+{
+  return m_threadSafe;
+}
+
 void Validator::validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const
 {
   node.accept(kdl::overload(
@@ -62,9 +67,11 @@ void Validator::validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues
     [&](PatchNode* patchNode) { doValidate(*patchNode, issues); }));
 }
 
-Validator::Validator(const IssueType type, std::string description)
+Validator::Validator(
+  const IssueType type, std::string description, const bool threadSafe)
   : m_type{type}
   , m_description{std::move(description)}
+  , m_threadSafe{threadSafe}
 {
 }
 
@@ -43,6 +43,7 @@ class Validator
 private:
   IssueType m_type;
   std::string m_description;
+  bool m_threadSafe;
   std::vector<IssueQuickFix> m_quickFixes;
 
 public:
@@ -52,10 +53,17 @@ public:
   const std::string& description() const;
   std::vector<const IssueQuickFix*> quickFixes() const;
 
+  /**
+   * Indicates whether this validator can validate different nodes concurrently. This is
+   * only the case if validating a node reads nothing but that node and immutable data.
+   * Validators that are not thread safe are only ever called from one thread at a time.
+   */
+  bool threadSafe() const;
+
   void validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const;
 
 protected:
-  Validator(IssueType type, std::string description);
+  Validator(IssueType type, std::string description, bool threadSafe = false);
   void addQuickFix(IssueQuickFix quickFix);
 
 private:
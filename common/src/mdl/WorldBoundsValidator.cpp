@@ -46,7 +46,7 @@ void validateInternal(
 } // namespace
 
 WorldBoundsValidator::WorldBoundsValidator(const vm::bbox3d& bounds)
-  : Validator{Type, "Objects out of world bounds"}
+  : Validator{Type, "Objects out of world bounds", true}
   , m_bounds{bounds}
 {
   addQuickFix(makeDeleteNodesQuickFix());
@@ -20,17 +20,20 @@
 #include "WorldNode.h"
 
 #include "Ensure.h"
+#include "flat_octree.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityNodeIndex.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Hit.h"
 #include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
+#include "mdl/PickResult.h"
 #include "mdl/TagVisitor.h"
+#include "mdl/ValidationEngine.h"
 #include "mdl/Validator.h"
 #include "mdl/ValidatorRegistry.h"
-#include "octree.h"
 
 #include "kdl/k.h"
 #include "kdl/overload.h"
@@ -38,8 +41,11 @@
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -52,6 +58,7 @@ WorldNode::WorldNode(
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
+  , m_validationEngine{std::make_unique<ValidationEngine>()}
   , m_nodeTree{std::make_unique<NodeTree>(256.0)}
   , m_updateNodeTree{true}
 {
@@ -60,6 +67,7 @@ WorldNode::WorldNode(
   entity.setPointEntity(false);
   setEntity(std::move(entity));
   createDefaultLayer();
+  m_validationEngine->nodeIssuesWereInvalidated(*this);
 }
 
 WorldNode::WorldNode(
@@ -182,6 +190,14 @@ const EntityNodeIndex& WorldNode::entityNodeIndex() const
   return *m_entityNodeIndex;
 }
 
+const std::vector<Node*>& WorldNode::nodesWithLinkId(const std::string& linkId) const
+{
+  static const auto empty = std::vector<Node*>{};
+
+  const auto it = m_linkIdIndex.find(linkId);
+  return it != m_linkIdIndex.end() ? it->second : empty;
+}
+
 std::vector<const Validator*> WorldNode::registeredValidators() const
 {
   return m_validatorRegistry->registeredValidators();
@@ -204,6 +220,11 @@ void WorldNode::unregisterAllValidators()
   invalidateAllIssues();
 }
 
+ValidationEngine& WorldNode::validationEngine()
+{
+  return *m_validationEngine;
+}
+
 void WorldNode::disableNodeTreeUpdates()
 {
   m_updateNodeTree = false;
@@ -216,11 +237,21 @@ void WorldNode::enableNodeTreeUpdates()
 
 void WorldNode::rebuildNodeTree()
 {
-  auto nodes = std::vector<mdl::Node*>{};
+  m_nodeTree->build(collectNodeTreeItems());
+}
+
+void WorldNode::rebuildNodeTree(kdl::task_manager& taskManager)
+{
+  m_nodeTree->build(collectNodeTreeItems(), taskManager);
+}
+
+std::vector<std::pair<vm::bbox3d, Node*>> WorldNode::collectNodeTreeItems()
+{
+  auto nodes = std::vector<std::pair<vm::bbox3d, Node*>>{};
   const auto addNode = [&](auto* node) {
     if (node->shouldAddToSpacialIndex())
     {
-      nodes.push_back(node);
+      nodes.emplace_back(node->physicalBounds(), node);
     }
   };
 
@@ -244,10 +275,24 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
+  return nodes;
+}
+
+void WorldNode::addToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  m_linkIdIndex[linkId].push_back(node);
+}
+
+void WorldNode::removeFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (const auto it = m_linkIdIndex.find(linkId); it != m_linkIdIndex.end())
   {
-    m_nodeTree->insert(node->physicalBounds(), node);
+    auto& nodes = it->second;
+    nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+    if (nodes.empty())
+    {
+      m_linkIdIndex.erase(it);
+    }
   }
 }
 
@@ -387,10 +432,21 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
     [&](auto&& thisLambda, GroupNode* group) {
       group->visitChildren(thisLambda);
       updatePersistentId(group);
+      addToLinkIdIndex(group, group->linkId());
     },
-    [&](EntityNode*) {},
-    [&](BrushNode*) {},
-    [&](PatchNode*) {}));
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      addToLinkIdIndex(entity, entity->linkId());
+    },
+    [&](BrushNode* brush) { addToLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { addToLinkIdIndex(patch, patch->linkId()); }));
+
+  // the issues of nodes that were removed earlier were reported as removed, so they must
+  // be revalidated even if they are still valid
+  node->accept([&](auto&& thisLambda, Node* descendant) {
+    m_validationEngine->nodeIssuesWereInvalidated(*descendant);
+    descendant->visitChildren(thisLambda);
+  });
 }
 
 void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
@@ -418,6 +474,31 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
       [&](BrushNode* brush) { doRemove(brush); },
       [&](PatchNode* patch) { doRemove(patch); }));
   }
+
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      group->visitChildren(thisLambda);
+      removeFromLinkIdIndex(group, group->linkId());
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      removeFromLinkIdIndex(entity, entity->linkId());
+    },
+    [&](BrushNode* brush) { removeFromLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { removeFromLinkIdIndex(patch, patch->linkId()); }));
+}
+
+void WorldNode::doDescendantWasRemoved(
+  Node* /* oldParent */, Node* node, const size_t /* depth */)
+{
+  // the removed nodes are already detached, so invalidating their issues can no longer
+  // add them back to the validation engine
+  node->accept([&](auto&& thisLambda, Node* descendant) {
+    m_validationEngine->nodeWasRemoved(*descendant);
+    descendant->visitChildren(thisLambda);
+  });
 }
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
@@ -439,6 +520,40 @@ bool WorldNode::doSelectable() const
   return false;
 }
 
+namespace
+{
+
+/**
+ * Returns the distance up to which further hits can change the result of
+ * pickResult.first(filter). PickResult::first prefers the matching hit with the smallest
+ * error, so a farther hit can only replace a matching hit that has an error.
+ */
+double maxPickDistance(const PickResult& pickResult, const HitFilter& filter)
+{
+  for (const auto& hit : pickResult.all())
+  {
+    if (hit.error() == 0.0 && filter(hit))
+    {
+      return hit.distance();
+    }
+  }
+  return std::numeric_limits<double>::max();
+}
+
+} // namespace
+
+void WorldNode::pickClosest(
+  const EditorContext& editorContext,
+  const vm::ray3d& ray,
+  const HitFilter& filter,
+  PickResult& pickResult)
+{
+  m_nodeTree->visit_intersectors_in_order(ray, [&](Node* node) {
+    node->pick(editorContext, ray, pickResult);
+    return maxPickDistance(pickResult, filter);
+  });
+}
+
 void WorldNode::doPick(
   const EditorContext& editorContext, const vm::ray3d& ray, PickResult& pickResult)
 {
@@ -503,6 +618,18 @@ void WorldNode::doRemoveFromIndex(
   m_entityNodeIndex->removeProperty(node, key, value);
 }
 
+void WorldNode::doUpdateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  removeFromLinkIdIndex(node, oldLinkId);
+  addToLinkIdIndex(node, newLinkId);
+}
+
+void WorldNode::doIssuesWereInvalidated(Node* node)
+{
+  m_validationEngine->nodeIssuesWereInvalidated(*node);
+}
+
 void WorldNode::doPropertiesDidChange(const vm::bbox3d& /* oldBounds */) {}
 
 vm::vec3d WorldNode::doGetLinkSourceAnchor() const
@@ -20,15 +20,18 @@
 #pragma once
 
 #include "Macros.h"
+#include "flat_octree.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/HitFilter.h"
 #include "mdl/IdType.h"
 #include "mdl/MapFormat.h"
 #include "mdl/Node.h"
-#include "octree.h"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -37,6 +40,7 @@ class EntityNodeIndex;
 class IssueQuickFix;
 enum class MapFormat;
 class PickResult;
+class ValidationEngine;
 class Validator;
 class ValidatorRegistry;
 
@@ -47,9 +51,11 @@ private:
   MapFormat m_mapFormat;
   LayerNode* m_defaultLayer;
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
+  std::unordered_map<std::string, std::vector<Node*>> m_linkIdIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
+  std::unique_ptr<ValidationEngine> m_validationEngine;
 
-  using NodeTree = octree<double, Node*>;
+  using NodeTree = flat_octree<double, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
@@ -71,6 +77,21 @@ public:
 
   const NodeTree& nodeTree() const;
 
+public: // picking
+  /**
+   * Picks the nodes hit by the given ray like pick, but only tests as many nodes as are
+   * needed to determine the first hit that matches the given filter. The nodes are tested
+   * in the order in which the ray enters the cells of the node tree, and the search stops
+   * once the remaining nodes cannot change the result of pickResult.first(filter).
+   *
+   * The given pick result must order its hits by distance.
+   */
+  void pickClosest(
+    const EditorContext& editorContext,
+    const vm::ray3d& ray,
+    const HitFilter& filter,
+    PickResult& pickResult);
+
 public: // layer management
   LayerNode* defaultLayer();
 
@@ -124,18 +145,38 @@ private:
 public: // index
   const EntityNodeIndex& entityNodeIndex() const;
 
+  /**
+   * Returns the groups, entities, brushes and patches in this world that have the given
+   * link ID. The nodes are returned in the order in which they were added to the index.
+   */
+  const std::vector<Node*>& nodesWithLinkId(const std::string& linkId) const;
+
 public: // validator registration
   std::vector<const Validator*> registeredValidators() const;
   std::vector<const IssueQuickFix*> quickFixes(IssueType issueTypes) const;
   void registerValidator(std::unique_ptr<Validator> validator);
   void unregisterAllValidators();
 
+  /**
+   * Returns the engine that tracks which nodes of this world need to be validated.
+   */
+  ValidationEngine& validationEngine();
+
 public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Rebuilds the node tree like the overload above, but uses the given task manager to
+   * build the subtrees of the node tree in parallel.
+   */
+  void rebuildNodeTree(kdl::task_manager& taskManager);
+
 private:
+  std::vector<std::pair<vm::bbox3d, Node*>> collectNodeTreeItems();
+  void addToLinkIdIndex(Node* node, const std::string& linkId);
+  void removeFromLinkIdIndex(Node* node, const std::string& linkId);
   void invalidateAllIssues();
 
 private: // implement Node interface
@@ -151,6 +192,7 @@ private: // implement Node interface
 
   void doDescendantWasAdded(Node* node, size_t depth) override;
   void doDescendantWillBeRemoved(Node* node, size_t depth) override;
+  void doDescendantWasRemoved(Node* oldParent, Node* node, size_t depth) override;
   void doDescendantPhysicalBoundsDidChange(Node* node) override;
 
   bool doSelectable() const override;
@@ -174,6 +216,9 @@ private: // implement Node interface
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
   void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
+  void doUpdateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId) override;
+  void doIssuesWereInvalidated(Node* node) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3d& oldBounds) override;
@@ -209,12 +209,24 @@ AllocationTracker::Block* AllocationTracker::allocate(const size_t needed)
   block->nextOfSameSize = nullptr;
   block->prevOfSameSize = nullptr;
 
+  Block* newBlock = splitOff(block, needed);
+
+  checkInvariants();
+  return newBlock;
+}
+
+AllocationTracker::Block* AllocationTracker::splitOff(Block* block, const Index needed)
+{
+  assert(block->free);
+  assert(block->prevOfSameSize == nullptr);
+  assert(block->nextOfSameSize == nullptr);
+
+  m_usedSize += needed;
+
   if (block->size == needed)
   {
     // lucky case: exact size. we're done
     block->free = false;
-
-    checkInvariants();
     return block;
   }
 
@@ -250,7 +262,6 @@ AllocationTracker::Block* AllocationTracker::allocate(const size_t needed)
   block->size -= needed;
   linkToBinList(block);
 
-  checkInvariants();
   return newBlock;
 }
 
@@ -262,6 +273,8 @@ void AllocationTracker::free(Block* block)
   assert(block->prevOfSameSize == nullptr);
   assert(block->nextOfSameSize == nullptr);
 
+  m_usedSize -= block->size;
+
   Block* left = block->left;
   Block* right = block->right;
 
@@ -365,6 +378,56 @@ void AllocationTracker::free(Block* block)
   checkInvariants();
 }
 
+AllocationTracker::Block* AllocationTracker::relocate(Block* block)
+{
+  checkInvariants();
+
+  assert(!block->free);
+
+  const auto pos = block->pos;
+  const auto size = block->size;
+
+  // find the smallest free block before `block` that will fit the allocation
+  Block* target = nullptr;
+  for (auto it = findFirstLargerOrEqualBin(m_freeBlockSizeBins, size);
+       it != m_freeBlockSizeBins.end() && target == nullptr;
+       ++it)
+  {
+    for (Block* candidate = *it; candidate != nullptr;
+         candidate = candidate->nextOfSameSize)
+    {
+      if (candidate->pos < pos)
+      {
+        target = candidate;
+        break;
+      }
+    }
+  }
+
+  if (target == nullptr)
+  {
+    if (block->left == nullptr || !block->left->free)
+    {
+      return nullptr;
+    }
+
+    // slide the allocation into the free block to its left, which is kept when the
+    // allocation is freed and merged into it
+    target = block->left;
+  }
+
+  // freeing the block never affects the target block except for merging it with the
+  // target block if they are adjacent
+  free(block);
+
+  unlinkFromBinList(target);
+  Block* newBlock = splitOff(target, size);
+  assert(newBlock->pos < pos);
+
+  checkInvariants();
+  return newBlock;
+}
+
 AllocationTracker::AllocationTracker(const Index initial_capacity)
   : m_capacity(0)
   , m_leftmostBlock(nullptr)
@@ -477,6 +540,64 @@ void AllocationTracker::expand(const Index newCapacity)
   checkInvariants();
 }
 
+void AllocationTracker::shrink(const Index newCapacity)
+{
+  checkInvariants();
+
+  if (newCapacity >= m_capacity)
+  {
+    throw std::invalid_argument{"new capacity must be smaller"};
+  }
+
+  Block* lastBlock = m_rightmostBlock;
+  if (!lastBlock->free || lastBlock->pos > newCapacity)
+  {
+    throw std::invalid_argument{"cannot shrink over used blocks"};
+  }
+
+  unlinkFromBinList(lastBlock);
+
+  if (lastBlock->pos == newCapacity)
+  {
+    // remove the last block entirely
+    m_rightmostBlock = lastBlock->left;
+    if (m_rightmostBlock == nullptr)
+    {
+      m_leftmostBlock = nullptr;
+    }
+    else
+    {
+      m_rightmostBlock->right = nullptr;
+    }
+    recycle(lastBlock);
+  }
+  else
+  {
+    lastBlock->size = newCapacity - lastBlock->pos;
+    linkToBinList(lastBlock);
+  }
+
+  m_capacity = newCapacity;
+
+  checkInvariants();
+}
+
+AllocationTracker::Index AllocationTracker::usedSize() const
+{
+  return m_usedSize;
+}
+
+AllocationTracker::Block* AllocationTracker::lastUsedBlock() const
+{
+  if (m_rightmostBlock == nullptr)
+  {
+    return nullptr;
+  }
+
+  // adjacent free blocks are always merged, so the block left of a free block is used
+  return m_rightmostBlock->free ? m_rightmostBlock->left : m_rightmostBlock;
+}
+
 bool AllocationTracker::hasAllocations() const
 {
   // NOTE: this loop should execute at most 2 iterations, because adjacent free blocks are
@@ -73,6 +73,11 @@ private:
    */
   Index m_capacity;
 
+  /**
+   * The sum of `size` of all used Blocks.
+   */
+  Index m_usedSize = 0;
+
   /**
    * Points to the Block with pos 0. Used to free all of the blocks in the destructor
    */
@@ -107,6 +112,13 @@ private:
   void recycle(Block* block);
   Block* obtainBlock();
 
+  /**
+   * Marks the first `needed` elements of the given free block as used, splitting off the
+   * remainder into a new free block. The given block must already be unlinked from
+   * m_freeBlockSizeBins.
+   */
+  Block* splitOff(Block* block, Index needed);
+
 public:
   explicit AllocationTracker(Index initial_capacity);
   AllocationTracker();
@@ -124,8 +136,38 @@ public:
    */
   Block* allocate(size_t size);
   void free(Block* block);
+
+  /**
+   * Tries to move the given allocation to a lower position, either into the smallest
+   * free block before it that can hold it, or by sliding it into the free space directly
+   * to its left.
+   *
+   * Returns nullptr if the allocation cannot be moved, in which case the given block is
+   * unchanged. Otherwise, the given block must not be used anymore and the returned block
+   * holds the allocation. The returned block may overlap the old allocation, so the
+   * caller must copy the allocated data before calling this.
+   */
+  Block* relocate(Block* block);
+
   size_t capacity() const;
   void expand(Index newCapacity);
+
+  /**
+   * Reduces the capacity. The range between the new and the current capacity must be
+   * free.
+   */
+  void shrink(Index newCapacity);
+
+  /**
+   * Returns the sum of the sizes of all allocations. Constant time.
+   */
+  Index usedSize() const;
+
+  /**
+   * Returns the allocation with the highest position, or nullptr if there are no
+   * allocations. Constant time.
+   */
+  Block* lastUsedBlock() const;
   /**
    * @return whether there are any allocations. i.e. returns false iff the whole range
    * managed by the allocation tracker is free. Returns false if `capacity() == 0`.
@@ -31,8 +31,13 @@
 #include "render/BrushRendererBrushCache.h"
 #include "render/RenderContext.h"
 
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <tuple>
 #include <vector>
 
 namespace tb::render
@@ -173,6 +178,13 @@ BrushRenderer::BrushRenderer()
   clear();
 }
 
+BrushRenderer::BrushRenderer(kdl::task_manager& taskManager)
+  : m_filter{std::make_unique<NoFilter>()}
+  , m_taskManager{&taskManager}
+{
+  clear();
+}
+
 void BrushRenderer::invalidate()
 {
   for (auto* brushNode : m_allBrushes)
@@ -232,6 +244,9 @@ void BrushRenderer::clear()
   m_brushInfo.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
+  m_blockOwners.reset();
+  m_compacting = false;
+  m_compactionStalled = false;
 
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_edgeIndices = std::make_shared<BrushIndexArray>();
@@ -378,39 +393,88 @@ void BrushRenderer::renderEdges(RenderBatch& renderBatch)
   m_edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
+/**
+ * The vertex and index data of a brush, computed independently of all other brushes.
+ * The indices are relative to the brush's first vertex.
+ */
+struct BrushRenderer::BrushData
+{
+  struct FaceIndices
+  {
+    const mdl::Material* material;
+    bool transparent;
+    size_t offset;
+    size_t count;
+  };
+
+  const mdl::BrushNode* brushNode = nullptr;
+
+  // the edge indices, followed by the face indices for each material
+  std::vector<GLuint> indices;
+  size_t edgeIndexCount = 0;
+  std::vector<FaceIndices> faceIndices;
+};
+
 void BrushRenderer::validate()
 {
   assert(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
+  // Evaluating the filter marks the faces of each brush and may depend on state that is
+  // not safe to access concurrently, so this is done up front.
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  auto brushesToRender =
+    std::vector<std::tuple<const mdl::BrushNode*, Filter::RenderSettings>>{};
+  brushesToRender.reserve(m_invalidBrushes.size());
+  for (const auto* brushNode : m_invalidBrushes)
   {
-    validateBrush(*brushNode);
+    assert(m_allBrushes.find(brushNode) != std::end(m_allBrushes));
+    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
+
+    // evaluate filter. only evaluate the filter once per brush.
+    const auto settings = wrapper.markFaces(*brushNode);
+    const auto [facePolicy, edgePolicy] = settings;
+
+    // NOTE: this skips inserting the brush into m_brushInfo
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToRender.emplace_back(brushNode, settings);
+    }
   }
   m_invalidBrushes.clear();
   assert(valid());
 
+  const auto computeBrushData = [&](const auto& brushToRender) {
+    const auto& [brushNode, settings] = brushToRender;
+    return this->computeBrushData(*brushNode, settings);
+  };
+
+  const auto brushData =
+    m_taskManager ? m_taskManager->parallel_transform(brushesToRender, computeBrushData)
+                  : kdl::vec_transform(brushesToRender, computeBrushData);
+
+  for (const auto& data : brushData)
+  {
+    insertBrushData(data);
+  }
+
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
     FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
-static size_t triIndicesCountForPolygon(const size_t vertexCount)
-{
-  assert(vertexCount >= 3);
-  const size_t indexCount = 3 * (vertexCount - 2);
-  return indexCount;
-}
-
 static void addTriIndicesForPolygon(
-  GLuint* dest, const GLuint baseIndex, const size_t vertexCount)
+  std::vector<GLuint>& dest, const GLuint baseIndex, const size_t vertexCount)
 {
   assert(vertexCount >= 3);
   for (size_t i = 0; i < vertexCount - 2; ++i)
   {
-    *(dest++) = baseIndex;
-    *(dest++) = baseIndex + static_cast<GLuint>(i + 1);
-    *(dest++) = baseIndex + static_cast<GLuint>(i + 2);
+    dest.push_back(baseIndex);
+    dest.push_back(baseIndex + static_cast<GLuint>(i + 1));
+    dest.push_back(baseIndex + static_cast<GLuint>(i + 2));
   }
 }
 
@@ -436,32 +500,10 @@ static inline bool shouldRenderEdge(
   }
 }
 
-static size_t countMarkedEdgeIndices(
-  const mdl::BrushNode& brushNode, const BrushRenderer::Filter::EdgeRenderPolicy policy)
-{
-  using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
-
-  if (policy == EdgeRenderPolicy::RenderNone)
-  {
-    return 0;
-  }
-
-  size_t indexCount = 0;
-  for (const auto& edge : brushNode.brushRendererBrushCache().cachedEdges())
-  {
-    if (shouldRenderEdge(edge, policy))
-    {
-      indexCount += 2;
-    }
-  }
-  return indexCount;
-}
-
-static void getMarkedEdgeIndices(
+static void addMarkedEdgeIndices(
   const mdl::BrushNode& brushNode,
   const BrushRenderer::Filter::EdgeRenderPolicy policy,
-  const GLuint brushVerticesStartIndex,
-  GLuint* dest)
+  std::vector<GLuint>& dest)
 {
   using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
 
@@ -470,15 +512,12 @@ static void getMarkedEdgeIndices(
     return;
   }
 
-  size_t i = 0;
   for (const auto& edge : brushNode.brushRendererBrushCache().cachedEdges())
   {
     if (shouldRenderEdge(edge, policy))
     {
-      dest[i++] =
-        static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex1RelativeToBrush);
-      dest[i++] =
-        static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex2RelativeToBrush);
+      dest.push_back(static_cast<GLuint>(edge.vertexIndex1RelativeToBrush));
+      dest.push_back(static_cast<GLuint>(edge.vertexIndex2RelativeToBrush));
     }
   }
 }
@@ -508,64 +547,27 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
+BrushRenderer::BrushData BrushRenderer::computeBrushData(
+  const mdl::BrushNode& brushNode, const Filter::RenderSettings& settings) const
 {
-  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
-  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
-
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
-  {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
-  }
-
-  BrushInfo& info = m_brushInfo[&brushNode];
+  const auto edgePolicy = std::get<Filter::EdgeRenderPolicy>(settings);
 
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
   brushCache.validateVertexCache(brushNode);
-  const auto& cachedVertices = brushCache.cachedVertices();
-  ensure(!cachedVertices.empty(), "Brush must have cached vertices");
-
-  assert(m_vertexArray != nullptr);
-  auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-  info.vertexHolderKey = vertBlock;
-
-  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+  ensure(!brushCache.cachedVertices().empty(), "Brush must have cached vertices");
 
-  // insert edge indices into VBO
-  {
-    const auto edgeIndexCount = countMarkedEdgeIndices(brushNode, edgePolicy);
-    if (edgeIndexCount > 0)
-    {
-      auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
-      info.edgeIndicesKey = key;
-      getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
-    }
-    else
-    {
-      // it's possible to have no edges to render
-      // e.g. select all faces of a brush, and the unselected brush renderer
-      // will hit this branch.
-      ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
-    }
-  }
+  auto result = BrushData{&brushNode, {}, 0, {}};
+  result.indices.reserve(
+    brushCache.cachedEdges().size() * 2 + brushCache.cachedVertices().size() * 3);
 
-  // insert face indices
+  // collect edge indices, it's possible to have no edges to render, e.g. select all faces
+  // of a brush, and the unselected brush renderer will have no edges
+  addMarkedEdgeIndices(brushNode, edgePolicy, result.indices);
+  result.edgeIndexCount = result.indices.size();
 
-  auto& facesSortedByMaterial = brushCache.cachedFacesSortedByMaterial();
+  // collect face indices
+  const auto& facesSortedByMaterial = brushCache.cachedFacesSortedByMaterial();
   const auto facesSortedByMaterialCount = facesSortedByMaterial.size();
 
   size_t nextI;
@@ -573,9 +575,6 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
   {
     const auto* material = facesSortedByMaterial[i].material;
 
-    size_t opaqueIndexCount = 0;
-    size_t transparentIndexCount = 0;
-
     // find the i value for the next material
     for (nextI = i + 1; nextI < facesSortedByMaterialCount
                         && facesSortedByMaterial[nextI].material == material;
@@ -584,92 +583,94 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
     }
 
     // process all faces with this material (they'll be consecutive)
-    for (size_t j = i; j < nextI; ++j)
-    {
-      const auto& cache = facesSortedByMaterial[j];
-      if (cache.face->isMarked())
-      {
-        assert(cache.material == material);
-        if (shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount);
-        }
-        else
-        {
-          opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-    }
-
-    if (transparentIndexCount > 0)
-    {
-      auto& faceVboMap = *m_transparentFaces;
-      auto& holderPtr = faceVboMap[material];
-      if (holderPtr == nullptr)
-      {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
-      }
-
-      auto [key, insertDest] =
-        holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
-      info.transparentFaceIndicesKeys.emplace_back(material, key);
-
-      // process all faces with this material (they'll be consecutive)
-      auto* currentDest = insertDest;
+    const auto addFaceIndices = [&](const bool transparent) {
+      const auto offset = result.indices.size();
       for (size_t j = i; j < nextI; ++j)
       {
         const auto& cache = facesSortedByMaterial[j];
         if (
           cache.face->isMarked()
-          && shouldDrawFaceInTransparentPass(brushNode, *cache.face))
+          && shouldDrawFaceInTransparentPass(brushNode, *cache.face) == transparent)
         {
+          assert(cache.material == material);
           addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
+            result.indices,
+            static_cast<GLuint>(cache.indexOfFirstVertexRelativeToBrush),
             cache.vertexCount);
-
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
         }
       }
-      assert(currentDest == (insertDest + transparentIndexCount));
-    }
 
-    if (opaqueIndexCount > 0)
-    {
-      auto& faceVboMap = *m_opaqueFaces;
-      auto& holderPtr = faceVboMap[material];
-      if (holderPtr == nullptr)
+      if (const auto count = result.indices.size() - offset; count > 0)
       {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
+        result.faceIndices.push_back({material, transparent, offset, count});
       }
+    };
 
-      auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
-      info.opaqueFaceIndicesKeys.emplace_back(material, key);
+    addFaceIndices(true);
+    addFaceIndices(false);
+  }
 
-      // process all faces with this material (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByMaterial[j];
-        if (
-          cache.face->isMarked()
-          && !shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
+  return result;
+}
 
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
+void BrushRenderer::insertBrushData(const BrushData& brushData)
+{
+  const auto& brushNode = *brushData.brushNode;
+  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
+
+  BrushInfo& info = m_brushInfo[&brushNode];
+
+  // insert vertices into VBO
+  const auto& cachedVertices = brushNode.brushRendererBrushCache().cachedVertices();
+
+  assert(m_vertexArray != nullptr);
+  auto [vertBlock, dest] =
+    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+  info.vertexHolderKey = vertBlock;
+
+  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+  const auto copyIndices =
+    [&](GLuint* insertDest, const size_t offset, const size_t count) {
+      for (size_t i = 0; i < count; ++i)
+      {
+        insertDest[i] = brushVerticesStartIndex + brushData.indices[offset + i];
       }
-      assert(currentDest == (insertDest + opaqueIndexCount));
+    };
+
+  // insert edge indices into VBO
+  if (brushData.edgeIndexCount > 0)
+  {
+    auto [key, insertDest] =
+      m_edgeIndices->getPointerToInsertElementsAt(brushData.edgeIndexCount);
+    info.edgeIndicesKey = key;
+    copyIndices(insertDest, 0, brushData.edgeIndexCount);
+  }
+  else
+  {
+    ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
+  }
+
+  // insert face indices
+  for (const auto& [material, transparent, offset, count] : brushData.faceIndices)
+  {
+    auto& faceVboMap = transparent ? *m_transparentFaces : *m_opaqueFaces;
+    auto& holderPtr = faceVboMap[material];
+    if (holderPtr == nullptr)
+    {
+      // inserts into map!
+      holderPtr = std::make_shared<BrushIndexArray>();
     }
+
+    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(count);
+    copyIndices(insertDest, offset, count);
+
+    auto& keys =
+      transparent ? info.transparentFaceIndicesKeys : info.opaqueFaceIndicesKeys;
+    keys.emplace_back(material, key);
   }
+
+  addBlockOwners(brushNode, info);
 }
 
 void BrushRenderer::addBrush(const mdl::BrushNode* brushNode)
@@ -698,6 +699,275 @@ void BrushRenderer::removeBrush(const mdl::BrushNode* brushNode)
   removeBrushFromVbo(*brushNode);
 }
 
+BrushArrayStats BrushRenderer::vertexArrayStats() const
+{
+  return m_vertexArray->stats();
+}
+
+BrushArrayStats BrushRenderer::indexArrayStats() const
+{
+  auto result = m_edgeIndices->stats();
+  for (const auto* faces : {m_opaqueFaces.get(), m_transparentFaces.get()})
+  {
+    for (const auto& [material, indexArray] : *faces)
+    {
+      const auto stats = indexArray->stats();
+      result.liveBytes += stats.liveBytes;
+      result.freeBytes += stats.freeBytes;
+      result.largestFreeBlockBytes =
+        std::max(result.largestFreeBlockBytes, stats.largestFreeBlockBytes);
+    }
+  }
+  return result;
+}
+
+namespace
+{
+
+// small arrays are not worth compacting since they would grow again soon
+constexpr auto MinFreeBytesToCompact = size_t(1024 * 1024);
+
+bool isFragmented(const BrushArrayStats& stats)
+{
+  return stats.freeBytes > MinFreeBytesToCompact && stats.freeBytes > 2 * stats.liveBytes;
+}
+
+} // namespace
+
+bool BrushRenderer::needsCompaction() const
+{
+  return isFragmented(vertexArrayStats()) || isFragmented(indexArrayStats());
+}
+
+bool BrushRenderer::compact(const std::chrono::nanoseconds budget)
+{
+  if (!m_compacting)
+  {
+    if (m_compactionStalled || !needsCompaction())
+    {
+      return true;
+    }
+    m_compacting = true;
+  }
+
+  const auto deadline = Clock::now() + budget;
+  if (!buildBlockOwners(deadline))
+  {
+    return false;
+  }
+
+  auto done = compactVertices(deadline) && compactIndices(*m_edgeIndices, deadline);
+  for (const auto* faces : {m_opaqueFaces.get(), m_transparentFaces.get()})
+  {
+    for (const auto& [material, indexArray] : *faces)
+    {
+      done = done && compactIndices(*indexArray, deadline);
+    }
+  }
+
+  if (done)
+  {
+    m_blockOwners.reset();
+    m_compacting = false;
+
+    // every array ends with a brush that cannot be moved, so another pass would not make
+    // any progress until the arrays change
+    m_compactionStalled = needsCompaction();
+  }
+  return done;
+}
+
+const BrushVertexArray& BrushRenderer::vertexArray() const
+{
+  return *m_vertexArray;
+}
+
+const BrushIndexArray& BrushRenderer::edgeIndexArray() const
+{
+  return *m_edgeIndices;
+}
+
+const BrushIndexArray* BrushRenderer::opaqueFaceIndexArray(
+  const mdl::Material* material) const
+{
+  const auto it = m_opaqueFaces->find(material);
+  return it != m_opaqueFaces->end() ? it->second.get() : nullptr;
+}
+
+const BrushIndexArray* BrushRenderer::transparentFaceIndexArray(
+  const mdl::Material* material) const
+{
+  const auto it = m_transparentFaces->find(material);
+  return it != m_transparentFaces->end() ? it->second.get() : nullptr;
+}
+
+namespace
+{
+
+template <typename BrushInfo, typename F>
+void forEachBlock(const BrushInfo& info, const F& f)
+{
+  f(info.vertexHolderKey);
+  if (info.edgeIndicesKey != nullptr)
+  {
+    f(info.edgeIndicesKey);
+  }
+  for (const auto& [material, key] : info.opaqueFaceIndicesKeys)
+  {
+    f(key);
+  }
+  for (const auto& [material, key] : info.transparentFaceIndicesKeys)
+  {
+    f(key);
+  }
+}
+
+} // namespace
+
+void BrushRenderer::addBlockOwners(const mdl::BrushNode& brushNode, const BrushInfo& info)
+{
+  m_compactionStalled = false;
+
+  if (m_blockOwners && m_blockOwners->complete)
+  {
+    forEachBlock(info, [&](const auto* key) { m_blockOwners->owners[key] = &brushNode; });
+  }
+  else
+  {
+    // adding to m_brushInfo invalidates the next brush info to add to the block owners
+    m_blockOwners.reset();
+  }
+}
+
+void BrushRenderer::removeBlockOwners(const BrushInfo& info)
+{
+  m_compactionStalled = false;
+
+  if (m_blockOwners && m_blockOwners->complete)
+  {
+    forEachBlock(info, [&](const auto* key) { m_blockOwners->owners.erase(key); });
+  }
+  else
+  {
+    // removing from m_brushInfo may invalidate the next brush info to add to the block
+    // owners
+    m_blockOwners.reset();
+  }
+}
+
+bool BrushRenderer::buildBlockOwners(const Clock::time_point deadline)
+{
+  if (!m_blockOwners)
+  {
+    m_blockOwners = BlockOwners{{}, m_brushInfo.begin()};
+  }
+
+  auto& [owners, next, complete] = *m_blockOwners;
+  for (; next != m_brushInfo.end(); ++next)
+  {
+    if (Clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    const auto& [brushNode, info] = *next;
+    forEachBlock(info, [&](const auto* key) { owners[key] = brushNode; });
+  }
+
+  complete = true;
+  return true;
+}
+
+bool BrushRenderer::compactVertices(const Clock::time_point deadline)
+{
+  for (auto* key = m_vertexArray->lastKey(); key != nullptr;
+       key = m_vertexArray->lastKey())
+  {
+    if (Clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    const auto* brushNode = m_blockOwners->owners.at(key);
+    const auto oldBase = static_cast<GLuint>(key->pos);
+
+    auto* newKey = m_vertexArray->moveVerticesWithKey(key);
+    if (newKey == nullptr)
+    {
+      break;
+    }
+
+    // the new key may reuse the old key's memory
+    m_blockOwners->owners.erase(key);
+    m_blockOwners->owners[newKey] = brushNode;
+
+    auto& info = m_brushInfo.at(brushNode);
+    info.vertexHolderKey = newKey;
+
+    // the indices of the brush refer to the old location of its vertices
+    const auto newBase = static_cast<GLuint>(newKey->pos);
+    if (info.edgeIndicesKey != nullptr)
+    {
+      m_edgeIndices->rebaseElementsWithKey(info.edgeIndicesKey, oldBase, newBase);
+    }
+    for (const auto& [material, indicesKey] : info.opaqueFaceIndicesKeys)
+    {
+      m_opaqueFaces->at(material)->rebaseElementsWithKey(indicesKey, oldBase, newBase);
+    }
+    for (const auto& [material, indicesKey] : info.transparentFaceIndicesKeys)
+    {
+      m_transparentFaces->at(material)->rebaseElementsWithKey(
+        indicesKey, oldBase, newBase);
+    }
+  }
+
+  m_vertexArray->shrinkToFit();
+  return true;
+}
+
+bool BrushRenderer::compactIndices(
+  BrushIndexArray& indexArray, const Clock::time_point deadline)
+{
+  for (auto* key = indexArray.lastKey(); key != nullptr; key = indexArray.lastKey())
+  {
+    if (Clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    const auto* brushNode = m_blockOwners->owners.at(key);
+
+    auto* newKey = indexArray.moveElementsWithKey(key);
+    if (newKey == nullptr)
+    {
+      break;
+    }
+
+    // the new key may reuse the old key's memory
+    m_blockOwners->owners.erase(key);
+    m_blockOwners->owners[newKey] = brushNode;
+
+    auto& info = m_brushInfo.at(brushNode);
+    if (info.edgeIndicesKey == key)
+    {
+      info.edgeIndicesKey = newKey;
+    }
+    for (auto* keys : {&info.opaqueFaceIndicesKeys, &info.transparentFaceIndicesKeys})
+    {
+      for (auto& [material, indicesKey] : *keys)
+      {
+        if (indicesKey == key)
+        {
+          indicesKey = newKey;
+        }
+      }
+    }
+  }
+
+  indexArray.shrinkToFit();
+  return true;
+}
+
 void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
 {
   auto it = m_brushInfo.find(&brushNode);
@@ -710,6 +980,7 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
   }
 
   const auto& info = it->second;
+  removeBlockOwners(info);
 
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
@@ -26,12 +26,19 @@
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 class BrushNode;
@@ -41,6 +48,7 @@ class EditorContext;
 
 namespace tb::render
 {
+struct BrushArrayStats;
 
 class BrushRenderer
 {
@@ -119,6 +127,11 @@ public:
 private:
   std::unique_ptr<Filter> m_filter;
 
+  /**
+   * If set, the vertices and indices of invalid brushes are computed in parallel.
+   */
+  kdl::task_manager* m_taskManager = nullptr;
+
   struct BrushInfo
   {
     AllocationTracker::Block* vertexHolderKey;
@@ -128,11 +141,13 @@ private:
     std::vector<std::pair<const mdl::Material*, AllocationTracker::Block*>>
       transparentFaceIndicesKeys;
   };
+  using BrushInfoMap = std::unordered_map<const mdl::BrushNode*, BrushInfo>;
+
   /**
    * Tracks all brushes that are stored in the VBO, with the information necessary to
    * remove them from the VBO later.
    */
-  std::unordered_map<const mdl::BrushNode*, BrushInfo> m_brushInfo;
+  BrushInfoMap m_brushInfo;
 
   /**
    * If a brush is in the VBO, it's always valid.
@@ -151,6 +166,27 @@ private:
   std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
   std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
 
+  /**
+   * Maps the allocations in the vertex and index arrays to the brushes that own them.
+   * Only built for compaction. The map is built incrementally, and until it is complete,
+   * it is discarded whenever a brush is added to or removed from the arrays. Once it is
+   * complete, it is updated instead.
+   */
+  struct BlockOwners
+  {
+    std::unordered_map<const AllocationTracker::Block*, const mdl::BrushNode*> owners;
+    BrushInfoMap::const_iterator next;
+    bool complete = false;
+  };
+  std::optional<BlockOwners> m_blockOwners;
+  bool m_compacting = false;
+
+  /**
+   * Set if compaction finished, but the arrays still need compaction. Another pass would
+   * not move anything, so compaction is not attempted again until the arrays change.
+   */
+  bool m_compactionStalled = false;
+
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
@@ -176,8 +212,18 @@ public:
     clear();
   }
 
+  template <typename FilterT>
+  BrushRenderer(FilterT filter, kdl::task_manager& taskManager)
+    : m_filter{std::make_unique<FilterT>(std::move(filter))}
+    , m_taskManager{&taskManager}
+  {
+    clear();
+  }
+
   BrushRenderer();
 
+  explicit BrushRenderer(kdl::task_manager& taskManager);
+
   /**
    * Remove all brushes.
    */
@@ -282,14 +328,23 @@ private:
 
 public:
   /**
+   * Validates all invalid brushes in two phases. First, the vertices and the per material
+   * indices of every brush are computed independently of each other, in parallel if a
+   * task manager was given. Then, the results are copied into the vertex and index arrays
+   * in a single pass.
+   *
    * Only exposed for benchmarking.
    */
   void validate();
 
 private:
+  struct BrushData;
+
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
-  void validateBrush(const mdl::BrushNode& brushNode);
+  BrushData computeBrushData(
+    const mdl::BrushNode& brushNode, const Filter::RenderSettings& settings) const;
+  void insertBrushData(const BrushData& brushData);
 
 public:
   /**
@@ -302,7 +357,89 @@ public:
    */
   void removeBrush(const mdl::BrushNode* brushNode);
 
+public: // compaction
+  /**
+   * Returns how the space of the vertex array is used.
+   */
+  BrushArrayStats vertexArrayStats() const;
+
+  /**
+   * Returns how the space of the edge and face index arrays is used. The live and free
+   * bytes are summed over all index arrays.
+   */
+  BrushArrayStats indexArrayStats() const;
+
+  /**
+   * Returns true if less than a third of the vertex array or of the index arrays is used.
+   */
+  bool needsCompaction() const;
+
+  /**
+   * Incrementally compacts the vertex and index arrays once they need compaction.
+   *
+   * The brushes stored at the end of each array are moved into free space closer to its
+   * start until the last brush cannot be moved anymore, and then the array is shrunk. The
+   * brush infos are updated to refer to the new locations.
+   *
+   * Stops when the given time budget is exceeded. The next call resumes compaction until
+   * it is finished. Finding the brushes that own the stored allocations counts against
+   * the budget, too.
+   *
+   * If the arrays still need compaction after it has finished, then it is not attempted
+   * again until brushes are added to or removed from the arrays.
+   *
+   * @return true if compaction is finished or not needed
+   */
+  bool compact(std::chrono::nanoseconds budget);
+
+  /**
+   * Returns the vertex array. Only exposed for testing.
+   */
+  const BrushVertexArray& vertexArray() const;
+
+  /**
+   * Returns the edge index array. Only exposed for testing.
+   */
+  const BrushIndexArray& edgeIndexArray() const;
+
+  /**
+   * Returns the opaque face index array for the given material, or nullptr if there is
+   * none. Only exposed for testing.
+   */
+  const BrushIndexArray* opaqueFaceIndexArray(const mdl::Material* material) const;
+
+  /**
+   * Returns the transparent face index array for the given material, or nullptr if there
+   * is none. Only exposed for testing.
+   */
+  const BrushIndexArray* transparentFaceIndexArray(const mdl::Material* material) const;
+
 private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Adds the allocations of the given brush to the block owners, unless they are being
+   * built. Discards them in that case.
+   */
+  void addBlockOwners(const mdl::BrushNode& brushNode, const BrushInfo& info);
+
+  /**
+   * Removes the allocations of the given brush from the block owners, unless they are
+   * being built. Discards them in that case.
+   */
+  void removeBlockOwners(const BrushInfo& info);
+
+  /**
+   * Continues building the block owners until they are complete or the given deadline is
+   * exceeded.
+   *
+   * @return true if the block owners are complete
+   */
+  bool buildBlockOwners(Clock::time_point deadline);
+
+  bool compactVertices(Clock::time_point deadline);
+  bool compactIndices(BrushIndexArray& indexArray, Clock::time_point deadline);
+
   /**
    * If the given brush is not currently in the VBO, it's silently ignored.
    * Otherwise, it's removed from the VBO (having its indices zeroed out, causing it to no
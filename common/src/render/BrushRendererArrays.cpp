@@ -19,9 +19,12 @@
 
 #include "render/BrushRendererArrays.h"
 
+#include "kdl/reflection_impl.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 
 // BrushIndexArray
@@ -50,6 +53,24 @@ void DirtyRangeTracker::expand(const size_t newcap)
   markDirty(oldcap, newcap - oldcap);
 }
 
+void DirtyRangeTracker::shrink(const size_t newcap)
+{
+  if (newcap >= m_capacity)
+  {
+    throw std::invalid_argument{"new capacity must be smaller"};
+  }
+
+  m_capacity = newcap;
+
+  auto it = m_ranges.lower_bound(newcap);
+  m_ranges.erase(it, m_ranges.end());
+  if (!m_ranges.empty())
+  {
+    auto& last = *m_ranges.rbegin();
+    last.second = std::min(last.second, newcap);
+  }
+}
+
 size_t DirtyRangeTracker::capacity() const
 {
   return m_capacity;
@@ -63,18 +84,62 @@ void DirtyRangeTracker::markDirty(const size_t pos, const size_t size)
     throw std::invalid_argument{"markDirty provided range out of bounds"};
   }
 
-  const auto newPos = std::min(pos, m_dirtyPos);
-  const auto newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+  if (size == 0)
+  {
+    return;
+  }
+
+  auto newPos = pos;
+  auto newEnd = pos + size;
+
+  // merge with the preceding range if it overlaps or touches the new range
+  auto it = m_ranges.upper_bound(newPos);
+  if (it != m_ranges.begin())
+  {
+    const auto prev = std::prev(it);
+    if (prev->second >= newPos)
+    {
+      newPos = prev->first;
+      newEnd = std::max(newEnd, prev->second);
+      it = m_ranges.erase(prev);
+    }
+  }
 
-  m_dirtyPos = newPos;
-  m_dirtySize = newEnd - newPos;
+  // merge with all following ranges that overlap or touch the new range
+  while (it != m_ranges.end() && it->first <= newEnd)
+  {
+    newEnd = std::max(newEnd, it->second);
+    it = m_ranges.erase(it);
+  }
+
+  m_ranges.emplace_hint(it, newPos, newEnd);
 }
 
 bool DirtyRangeTracker::clean() const
 {
-  return m_dirtySize == 0;
+  return m_ranges.empty();
+}
+
+std::vector<DirtyRangeTracker::Range> DirtyRangeTracker::uploadRanges(
+  const size_t maxGap) const
+{
+  auto result = std::vector<Range>{};
+  for (const auto& [pos, end] : m_ranges)
+  {
+    if (!result.empty() && result.back().pos + result.back().size + maxGap >= pos)
+    {
+      result.back().size = end - result.back().pos;
+    }
+    else
+    {
+      result.push_back(Range{pos, end - pos});
+    }
+  }
+  return result;
 }
 
+kdl_reflect_impl(DirtyRangeTracker::Range);
+
 // IndexHolder
 
 IndexHolder::IndexHolder()
@@ -151,6 +216,77 @@ void BrushIndexArray::zeroElementsWithKey(AllocationTracker::Block* key)
   m_indexHolder.zeroRange(pos, size);
 }
 
+AllocationTracker::Block* BrushIndexArray::moveElementsWithKey(
+  AllocationTracker::Block* key)
+{
+  const auto oldPos = key->pos;
+  const auto size = key->size;
+
+  // the new allocation may overlap the old one, so copy the indices first
+  const auto* first = m_indexHolder.getPointerToReadElementsFrom(oldPos);
+  const auto indices = std::vector<GLuint>(first, first + size);
+
+  auto* newKey = m_allocationTracker.relocate(key);
+  if (newKey == nullptr)
+  {
+    return nullptr;
+  }
+
+  m_indexHolder.zeroRange(oldPos, size);
+
+  auto* dest = m_indexHolder.getPointerToWriteElementsTo(newKey->pos, size);
+  std::copy(indices.begin(), indices.end(), dest);
+  return newKey;
+}
+
+void BrushIndexArray::rebaseElementsWithKey(
+  AllocationTracker::Block* key, const GLuint oldBase, const GLuint newBase)
+{
+  auto* indices = m_indexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+  for (size_t i = 0; i < key->size; ++i)
+  {
+    indices[i] = indices[i] - oldBase + newBase;
+  }
+}
+
+AllocationTracker::Block* BrushIndexArray::lastKey() const
+{
+  return m_allocationTracker.lastUsedBlock();
+}
+
+void BrushIndexArray::shrinkToFit()
+{
+  if (const auto* lastBlock = m_allocationTracker.lastUsedBlock())
+  {
+    const auto newSize = lastBlock->pos + lastBlock->size;
+    if (newSize < m_allocationTracker.capacity())
+    {
+      m_allocationTracker.shrink(newSize);
+      m_indexHolder.resize(newSize);
+    }
+  }
+}
+
+size_t BrushIndexArray::size() const
+{
+  return m_indexHolder.size();
+}
+
+const GLuint* BrushIndexArray::getPointerToReadElementsFrom(const size_t offset) const
+{
+  return m_indexHolder.getPointerToReadElementsFrom(offset);
+}
+
+BrushArrayStats BrushIndexArray::stats() const
+{
+  const auto usedSize = m_allocationTracker.usedSize();
+  return {
+    usedSize * sizeof(GLuint),
+    (m_allocationTracker.capacity() - usedSize) * sizeof(GLuint),
+    m_allocationTracker.largestPossibleAllocation() * sizeof(GLuint),
+  };
+}
+
 void BrushIndexArray::render(const PrimType primType) const
 {
   assert(m_indexHolder.prepared());
@@ -216,6 +352,66 @@ void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
   // us to re-use the space later
 }
 
+AllocationTracker::Block* BrushVertexArray::moveVerticesWithKey(
+  AllocationTracker::Block* key)
+{
+  const auto oldPos = key->pos;
+  const auto size = key->size;
+
+  // the new allocation may overlap the old one, so copy the vertices first
+  const auto* first = m_vertexHolder.getPointerToReadElementsFrom(oldPos);
+  const auto vertices = std::vector<Vertex>(first, first + size);
+
+  auto* newKey = m_allocationTracker.relocate(key);
+  if (newKey == nullptr)
+  {
+    return nullptr;
+  }
+
+  auto* dest = m_vertexHolder.getPointerToWriteElementsTo(newKey->pos, size);
+  std::copy(vertices.begin(), vertices.end(), dest);
+  return newKey;
+}
+
+AllocationTracker::Block* BrushVertexArray::lastKey() const
+{
+  return m_allocationTracker.lastUsedBlock();
+}
+
+void BrushVertexArray::shrinkToFit()
+{
+  if (const auto* lastBlock = m_allocationTracker.lastUsedBlock())
+  {
+    const auto newSize = lastBlock->pos + lastBlock->size;
+    if (newSize < m_allocationTracker.capacity())
+    {
+      m_allocationTracker.shrink(newSize);
+      m_vertexHolder.resize(newSize);
+    }
+  }
+}
+
+size_t BrushVertexArray::size() const
+{
+  return m_vertexHolder.size();
+}
+
+const BrushVertexArray::Vertex* BrushVertexArray::getPointerToReadVerticesFrom(
+  const size_t offset) const
+{
+  return m_vertexHolder.getPointerToReadElementsFrom(offset);
+}
+
+BrushArrayStats BrushVertexArray::stats() const
+{
+  const auto usedSize = m_allocationTracker.usedSize();
+  return {
+    usedSize * sizeof(Vertex),
+    (m_allocationTracker.capacity() - usedSize) * sizeof(Vertex),
+    m_allocationTracker.largestPossibleAllocation() * sizeof(Vertex),
+  };
+}
+
 bool BrushVertexArray::setupVertices()
 {
   return m_vertexHolder.setupVertices();
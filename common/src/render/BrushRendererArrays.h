@@ -28,18 +28,41 @@
 #include "render/Vbo.h"
 #include "render/VboManager.h"
 
+#include "kdl/reflection_decl.h"
+
 #include <cassert>
+#include <map>
 #include <memory>
 #include <vector>
 
 namespace tb::render
 {
-struct DirtyRangeTracker
+/**
+ * Tracks the ranges of a buffer that were modified since it was last uploaded.
+ *
+ * The dirty ranges are kept as a set of disjoint intervals so that modifications to
+ * distant parts of the buffer don't cause the space between them to be uploaded.
+ */
+class DirtyRangeTracker
 {
-  size_t m_dirtyPos = 0;
-  size_t m_dirtySize = 0;
+public:
+  struct Range
+  {
+    size_t pos;
+    size_t size;
+
+    kdl_reflect_decl(Range, pos, size);
+  };
+
+private:
+  /**
+   * Maps the start of each dirty range to its end. The ranges are neither overlapping
+   * nor adjacent.
+   */
+  std::map<size_t, size_t> m_ranges;
   size_t m_capacity = 0;
 
+public:
   /**
    * New trackers are initially clean.
    */
@@ -50,9 +73,24 @@ struct DirtyRangeTracker
    * Expanding marks the new range as dirty.
    */
   void expand(size_t newcap);
+
+  /**
+   * Shrinking discards the dirty ranges beyond the new capacity.
+   */
+  void shrink(size_t newcap);
   size_t capacity() const;
   void markDirty(size_t pos, size_t size);
   bool clean() const;
+
+  /**
+   * Returns the ranges that must be uploaded to make the buffer clean, ordered by their
+   * position.
+   *
+   * Dirty ranges that are separated by at most `maxGap` clean elements are merged into a
+   * single range since uploading a few clean elements is cheaper than issuing another
+   * upload.
+   */
+  std::vector<Range> uploadRanges(size_t maxGap) const;
 };
 
 /**
@@ -61,16 +99,21 @@ struct DirtyRangeTracker
  * Non-copyable; meant to be held in a std::shared_ptr.
  * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
  *
- * Currently uses a single range to track the modified region which might upload much more
- * than necessary; it might be worth mapping the VBO and editing it directly.
+ * Uses a DirtyRangeTracker to track the modified regions as a set of disjoint intervals
+ * and uploads only those regions, merging ranges that are separated by small gaps.
  */
 template <typename T>
 class VboHolder
 {
 protected:
+  /**
+   * Dirty ranges that are separated by at most this many bytes are uploaded together.
+   */
+  static constexpr size_t MaxUploadGap = 4096;
+
   VboType m_type;
   std::vector<T> m_snapshot;
-  DirtyRangeTracker m_dirtyRange;
+  DirtyRangeTracker m_dirtyRanges;
   VboManager* m_vboManager;
   Vbo* m_vbo;
 
@@ -100,18 +143,18 @@ private:
       m_type, m_snapshot.size() * sizeof(T), VboUsage::DynamicDraw);
     assert(m_vbo != nullptr);
 
-    m_vbo->writeElements(0, m_snapshot);
+    m_vboManager->recordUpload(m_vbo->writeElements(0, m_snapshot));
 
-    m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
-    assert(m_dirtyRange.clean());
-    assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRange.capacity());
+    m_dirtyRanges = DirtyRangeTracker(m_snapshot.size());
+    assert(m_dirtyRanges.clean());
+    assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRanges.capacity());
   }
 
 public:
   explicit VboHolder(const VboType type)
     : m_type(type)
     , m_snapshot()
-    , m_dirtyRange(0)
+    , m_dirtyRanges(0)
     , m_vboManager(nullptr)
     , m_vbo(nullptr)
   {
@@ -123,13 +166,13 @@ public:
   VboHolder(const VboType type, std::vector<T>& elements)
     : m_type(type)
     , m_snapshot()
-    , m_dirtyRange(elements.size())
+    , m_dirtyRanges(elements.size())
     , m_vboManager(nullptr)
     , m_vbo(nullptr)
   {
 
     const size_t elementsCount = elements.size();
-    m_dirtyRange.markDirty(0, elementsCount);
+    m_dirtyRanges.markDirty(0, elementsCount);
 
     elements.swap(m_snapshot);
 
@@ -151,8 +194,15 @@ public:
 
   void resize(const size_t newSize)
   {
+    if (newSize > m_snapshot.size())
+    {
+      m_dirtyRanges.expand(newSize);
+    }
+    else
+    {
+      m_dirtyRanges.shrink(newSize);
+    }
     m_snapshot.resize(newSize);
-    m_dirtyRange.expand(newSize);
   }
 
   T* getPointerToWriteElementsTo(
@@ -161,15 +211,22 @@ public:
     assert(offsetWithinBlock + elementCount <= m_snapshot.size());
 
     // mark dirty range
-    m_dirtyRange.markDirty(offsetWithinBlock, elementCount);
+    m_dirtyRanges.markDirty(offsetWithinBlock, elementCount);
+
+    return m_snapshot.data() + offsetWithinBlock;
+  }
 
+  const T* getPointerToReadElementsFrom(const size_t offsetWithinBlock) const
+  {
+    assert(offsetWithinBlock <= m_snapshot.size());
     return m_snapshot.data() + offsetWithinBlock;
   }
 
   bool prepared() const
   {
     // NOTE: this returns true if the capacity is 0
-    return m_dirtyRange.clean();
+    return m_dirtyRanges.clean()
+           && (m_vbo == nullptr || m_vbo->capacity() == m_snapshot.size() * sizeof(T));
   }
 
   void prepare(VboManager& vboManager)
@@ -193,7 +250,7 @@ public:
     }
 
     // resize?
-    if (m_dirtyRange.capacity() != (m_vbo->capacity() / sizeof(T)))
+    if (m_dirtyRanges.capacity() != (m_vbo->capacity() / sizeof(T)))
     {
       freeBlock();
       allocateBlock(vboManager);
@@ -203,16 +260,16 @@ public:
 
     // otherwise, it's an incremental update of the dirty ranges.
 
-    if (!m_dirtyRange.clean())
+    auto uploadedBytes = size_t(0);
+    for (const auto& range : m_dirtyRanges.uploadRanges(MaxUploadGap / sizeof(T)))
     {
-      const size_t pos = m_dirtyRange.m_dirtyPos;
-      const size_t size = m_dirtyRange.m_dirtySize;
-
-      const size_t bytesFromStart = pos * sizeof(T);
-      m_vbo->writeArray(bytesFromStart, m_snapshot.data() + pos, size);
+      const size_t bytesFromStart = range.pos * sizeof(T);
+      uploadedBytes +=
+        m_vbo->writeArray(bytesFromStart, m_snapshot.data() + range.pos, range.size);
     }
+    m_vboManager->recordUpload(uploadedBytes);
 
-    m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+    m_dirtyRanges = DirtyRangeTracker(m_snapshot.size());
     assert(prepared());
   }
 
@@ -241,6 +298,16 @@ public:
   static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
 };
 
+/**
+ * Describes how the space of a brush vertex or index array is used, in bytes.
+ */
+struct BrushArrayStats
+{
+  size_t liveBytes = 0;
+  size_t freeBytes = 0;
+  size_t largestFreeBlockBytes = 0;
+};
+
 /**
  * VboBlock handle that supports dynamically allocating ranges of indices, grows as
  * needed, and also supports freeing allocations and zeroing the corresponding indicies so
@@ -278,6 +345,44 @@ public:
    */
   void zeroElementsWithKey(AllocationTracker::Block* key);
 
+  /**
+   * Tries to move the indices with the given key closer to the start of the array.
+   *
+   * Returns the new key, or nullptr if the indices cannot be moved. In the latter case,
+   * the given key remains valid.
+   */
+  AllocationTracker::Block* moveElementsWithKey(AllocationTracker::Block* key);
+
+  /**
+   * Updates the indices with the given key after the vertices they refer to were moved
+   * from `oldBase` to `newBase`.
+   */
+  void rebaseElementsWithKey(
+    AllocationTracker::Block* key, GLuint oldBase, GLuint newBase);
+
+  /**
+   * Returns the key of the indices stored at the highest position, or nullptr if this
+   * array is empty.
+   */
+  AllocationTracker::Block* lastKey() const;
+
+  /**
+   * Shrinks this array so that it ends with the last stored indices.
+   */
+  void shrinkToFit();
+
+  /**
+   * Returns the number of indices in this array, including free and zeroed indices.
+   */
+  size_t size() const;
+
+  /**
+   * Returns a pointer to the indices starting at the given offset.
+   */
+  const GLuint* getPointerToReadElementsFrom(size_t offset) const;
+
+  BrushArrayStats stats() const;
+
   void render(PrimType primType) const;
   bool prepared() const;
   void prepare(VboManager& vboManager);
@@ -369,6 +474,38 @@ public:
 
   void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+  /**
+   * Tries to move the vertices with the given key closer to the start of the array. The
+   * indices referring to the vertices must be rebased by the caller.
+   *
+   * Returns the new key, or nullptr if the vertices cannot be moved. In the latter case,
+   * the given key remains valid.
+   */
+  AllocationTracker::Block* moveVerticesWithKey(AllocationTracker::Block* key);
+
+  /**
+   * Returns the key of the vertices stored at the highest position, or nullptr if this
+   * array is empty.
+   */
+  AllocationTracker::Block* lastKey() const;
+
+  /**
+   * Shrinks this array so that it ends with the last stored vertices.
+   */
+  void shrinkToFit();
+
+  /**
+   * Returns the number of vertices in this array, including free vertices.
+   */
+  size_t size() const;
+
+  /**
+   * Returns a pointer to the vertices starting at the given offset.
+   */
+  const Vertex* getPointerToReadVerticesFrom(size_t offset) const;
+
+  BrushArrayStats stats() const;
+
   // setting up GL attributes
   bool setupVertices();
   void cleanupVertices();
@@ -72,6 +72,10 @@ public:
     }
     else
     {
+      if (material)
+      {
+        material->requestTexture();
+      }
       m_shader.set("ApplyMaterial", false);
       m_shader.set("Color", m_defaultColor);
     }
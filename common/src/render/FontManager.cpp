@@ -38,6 +38,7 @@ FontManager::~FontManager() = default;
 void FontManager::clearCache()
 {
   m_cache.clear();
+  m_layoutCache.clear();
 }
 
 TextureFont& FontManager::font(const FontDescriptor& fontDescriptor)
@@ -51,6 +52,12 @@ TextureFont& FontManager::font(const FontDescriptor& fontDescriptor)
   return *it->second;
 }
 
+std::shared_ptr<const TextLayout> FontManager::layout(
+  const FontDescriptor& fontDescriptor, const AttrString& string)
+{
+  return m_layoutCache.layout(fontDescriptor, font(fontDescriptor), string);
+}
+
 FontDescriptor FontManager::selectFontSize(
   const FontDescriptor& fontDescriptor,
   const std::string& string,
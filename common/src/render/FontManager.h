@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "render/TextLayoutCache.h"
 
 #include <map>
 #include <memory>
@@ -36,12 +37,15 @@ class FontManager
 private:
   std::unique_ptr<FontFactory> m_factory;
   std::map<FontDescriptor, std::unique_ptr<TextureFont>> m_cache;
+  TextLayoutCache m_layoutCache;
 
 public:
   FontManager();
   ~FontManager();
 
   TextureFont& font(const FontDescriptor& fontDescriptor);
+  std::shared_ptr<const TextLayout> layout(
+    const FontDescriptor& fontDescriptor, const AttrString& string);
   FontDescriptor selectFontSize(
     const FontDescriptor& fontDescriptor,
     const std::string& string,
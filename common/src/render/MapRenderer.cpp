@@ -49,6 +49,7 @@
 #include "kdl/overload.h"
 #include "kdl/path_utils.h"
 
+#include <chrono>
 #include <vector>
 
 namespace tb::render
@@ -56,6 +57,11 @@ namespace tb::render
 namespace
 {
 
+/**
+ * The time spent compacting the brush vertex and index arrays per frame.
+ */
+constexpr auto CompactionBudget = std::chrono::milliseconds{1};
+
 class SelectedBrushRendererFilter : public BrushRenderer::DefaultFilter
 {
 public:
@@ -166,7 +172,8 @@ std::unique_ptr<ObjectRenderer> createDefaultRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<ObjectRenderer> createSelectionRenderer(
@@ -176,7 +183,8 @@ std::unique_ptr<ObjectRenderer> createSelectionRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    SelectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    SelectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<ObjectRenderer> createLockRenderer(
@@ -186,7 +194,8 @@ std::unique_ptr<ObjectRenderer> createLockRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    LockedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    LockedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<EntityDecalRenderer> createEntityDecalRenderer(
@@ -246,6 +255,8 @@ void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
   renderDefaultTransparent(renderContext, renderBatch);
   renderLockedTransparent(renderContext, renderBatch);
   renderSelectionTransparent(renderContext, renderBatch);
+
+  compactBrushArrays();
 }
 
 void MapRenderer::clear()
@@ -344,6 +355,22 @@ void MapRenderer::renderGroupLinks(RenderContext& renderContext, RenderBatch& re
   m_groupLinkRenderer->render(renderContext, renderBatch);
 }
 
+void MapRenderer::compactBrushArrays()
+{
+  // the render batch uploads the modified arrays when it is rendered
+  const auto deadline = std::chrono::steady_clock::now() + CompactionBudget;
+  for (auto* renderer :
+       {m_defaultRenderer.get(), m_selectionRenderer.get(), m_lockedRenderer.get()})
+  {
+    const auto budget = deadline - std::chrono::steady_clock::now();
+    if (budget <= std::chrono::nanoseconds::zero())
+    {
+      break;
+    }
+    renderer->compact(budget);
+  }
+}
+
 void MapRenderer::setupRenderers()
 {
   setupDefaultRenderer(*m_defaultRenderer);
@@ -107,6 +107,7 @@ private:
   void renderEntityDecals(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderGroupLinks(RenderContext& renderContext, RenderBatch& renderBatch);
+  void compactBrushArrays();
 
   void setupRenderers();
   void setupDefaultRenderer(ObjectRenderer& renderer);
@@ -221,4 +221,9 @@ void ObjectRenderer::renderTransparent(
   m_brushRenderer.renderTransparent(renderContext, renderBatch);
 }
 
+bool ObjectRenderer::compact(const std::chrono::nanoseconds budget)
+{
+  return m_brushRenderer.compact(budget);
+}
+
 } // namespace tb::render
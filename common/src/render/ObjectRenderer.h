@@ -25,8 +25,14 @@
 #include "render/GroupRenderer.h"
 #include "render/PatchRenderer.h"
 
+#include <chrono>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb
 {
 class Color;
@@ -64,10 +70,11 @@ public:
     Logger& logger,
     mdl::EntityModelManager& entityModelManager,
     const mdl::EditorContext& editorContext,
-    const BrushFilterT& brushFilter)
+    const BrushFilterT& brushFilter,
+    kdl::task_manager& taskManager)
     : m_groupRenderer{editorContext}
     , m_entityRenderer{logger, entityModelManager, editorContext}
-    , m_brushRenderer{brushFilter}
+    , m_brushRenderer{brushFilter, taskManager}
     , m_patchRenderer{editorContext}
   {
   }
@@ -115,6 +122,13 @@ public: // rendering
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Incrementally compacts the brush vertex and index arrays.
+   *
+   * @see BrushRenderer::compact
+   */
+  bool compact(std::chrono::nanoseconds budget);
+
   deleteCopy(ObjectRenderer);
 };
 
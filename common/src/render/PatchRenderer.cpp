@@ -347,6 +347,10 @@ struct RenderFunc : public MaterialRenderFunc
     }
     else
     {
+      if (material)
+      {
+        material->requestTexture();
+      }
       shader.set("ApplyMaterial", false);
       shader.set("Color", defaultColor);
     }
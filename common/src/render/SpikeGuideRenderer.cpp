@@ -49,12 +49,11 @@ void SpikeGuideRenderer::add(
 {
   using namespace mdl::HitFilters;
 
+  const auto filter = type(mdl::BrushNode::BrushHitType) && minDistance(1.0);
   auto pickResult = mdl::PickResult::byDistance();
-  document->pick(ray, pickResult);
+  document->pickClosest(ray, filter, pickResult);
 
-  if (const auto& hit =
-        pickResult.first(type(mdl::BrushNode::BrushHitType) && minDistance(1.0));
-      hit.isMatch())
+  if (const auto& hit = pickResult.first(filter); hit.isMatch())
   {
     if (hit.distance() <= length)
     {
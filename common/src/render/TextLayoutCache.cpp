@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextLayoutCache.h"
+
+#include "Ensure.h"
+#include "Macros.h"
+#include "render/TextureFont.h"
+
+#include <cassert>
+
+namespace tb::render
+{
+
+const size_t TextLayoutCache::DefaultCapacity = 8192;
+
+TextLayoutCache::TextLayoutCache(const size_t capacity)
+  : m_capacity{capacity}
+{
+  ensure(m_capacity > 0, "capacity must be positive");
+}
+
+size_t TextLayoutCache::capacity() const
+{
+  return m_capacity;
+}
+
+size_t TextLayoutCache::size() const
+{
+  return m_entries.size();
+}
+
+size_t TextLayoutCache::hits() const
+{
+  return m_hits;
+}
+
+size_t TextLayoutCache::misses() const
+{
+  return m_misses;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::layout(
+  const FontDescriptor& fontDescriptor,
+  const TextureFont& font,
+  const AttrString& string)
+{
+  if (const auto it = m_entries.find(KeyRef{fontDescriptor, string});
+      it != m_entries.end())
+  {
+    ++m_hits;
+    auto& entry = it->second;
+    m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+    return entry.layout;
+  }
+
+  ++m_misses;
+  if (m_entries.size() == m_capacity)
+  {
+    m_entries.erase(*m_lru.back());
+    m_lru.pop_back();
+  }
+
+  auto layout = std::make_shared<const TextLayout>(
+    TextLayout{font.quads(string, true), font.measure(string)});
+
+  const auto [it, inserted] =
+    m_entries.emplace(Key{fontDescriptor, string}, Entry{layout, {}});
+  assert(inserted);
+  unused(inserted);
+
+  m_lru.push_front(&it->first);
+  it->second.lruPosition = m_lru.begin();
+
+  return layout;
+}
+
+void TextLayoutCache::clear()
+{
+  m_entries.clear();
+  m_lru.clear();
+}
+
+} // namespace tb::render
@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "render/AttrString.h"
+#include "render/FontDescriptor.h"
+
+#include "vm/vec.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace tb::render
+{
+class TextureFont;
+
+/**
+ * The laid out quads of a string, as returned by TextureFont::quads with clockwise
+ * winding and without an offset, and the size of the string as returned by
+ * TextureFont::measure.
+ */
+struct TextLayout
+{
+  std::vector<vm::vec2f> vertices;
+  vm::vec2f size;
+};
+
+/**
+ * Caches the layouts of strings rendered with a font so that repeatedly rendered strings
+ * such as entity class names need not be laid out again on every frame.
+ *
+ * The cache holds at most a given number of layouts and evicts the least recently used
+ * layout when it is full. Returned layouts are shared and remain valid after eviction.
+ */
+class TextLayoutCache
+{
+private:
+  struct Key
+  {
+    FontDescriptor fontDescriptor;
+    AttrString string;
+  };
+
+  struct KeyRef
+  {
+    const FontDescriptor& fontDescriptor;
+    const AttrString& string;
+  };
+
+  struct KeyCompare
+  {
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const
+    {
+      const auto result = lhs.fontDescriptor.compare(rhs.fontDescriptor);
+      return result != 0 ? result < 0 : lhs.string.compare(rhs.string) < 0;
+    }
+  };
+
+  using LruList = std::list<const Key*>;
+
+  struct Entry
+  {
+    std::shared_ptr<const TextLayout> layout;
+    LruList::iterator lruPosition;
+  };
+
+  size_t m_capacity;
+
+  std::map<Key, Entry, KeyCompare> m_entries;
+  // the keys of m_entries, most recently used first
+  LruList m_lru;
+
+  size_t m_hits = 0;
+  size_t m_misses = 0;
+
+public:
+  static const size_t DefaultCapacity;
+
+  explicit TextLayoutCache(size_t capacity = DefaultCapacity);
+
+  size_t capacity() const;
+  size_t size() const;
+  size_t hits() const;
+  size_t misses() const;
+
+  /**
+   * Returns the layout of the given string rendered with the given font, which must have
+   * been created for the given font descriptor. The layout is computed and cached if it
+   * is not cached yet.
+   */
+  std::shared_ptr<const TextLayout> layout(
+    const FontDescriptor& fontDescriptor,
+    const TextureFont& font,
+    const AttrString& string);
+
+  void clear();
+};
+
+} // namespace tb::render
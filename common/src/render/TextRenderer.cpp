@@ -28,6 +28,7 @@
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
 #include "render/TextAnchor.h"
+#include "render/TextLayoutCache.h"
 #include "render/TextureFont.h"
 
 #include "vm/mat_ext.h"
@@ -84,53 +85,34 @@ void TextRenderer::renderString(
   const TextAnchor& position,
   const bool onTop)
 {
-
   const auto& camera = renderContext.camera();
   const auto distance = camera.perpendicularDistanceTo(position.position(camera));
-  if (distance <= 0.0f || !isVisible(renderContext, string, position, distance, onTop))
+  if (distance <= 0.0f || !isInViewRange(renderContext, distance, onTop))
   {
     return;
   }
 
   auto& fontManager = renderContext.fontManager();
-  auto& font = fontManager.font(m_fontDescriptor);
-
-  auto vertices = font.quads(string, true);
-  const auto alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-  const auto size = font.measure(string);
-  const auto offset = position.offset(camera, size);
-
-  if (onTop)
+  auto layout = fontManager.layout(m_fontDescriptor, string);
+  if (!isVisible(renderContext, layout->size, position))
   {
-    addEntry(
-      m_entriesOnTop,
-      Entry{
-        std::move(vertices),
-        size,
-        offset,
-        Color{textColor, alphaFactor * textColor.a()},
-        Color{backgroundColor, alphaFactor * backgroundColor.a()},
-      });
-  }
-  else
-  {
-    addEntry(
-      m_entries,
-      Entry{
-        std::move(vertices),
-        size,
-        offset,
-        Color{textColor, alphaFactor * textColor.a()},
-        Color{backgroundColor, alphaFactor * backgroundColor.a()}});
+    return;
   }
+
+  const auto alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+  const auto offset = position.offset(camera, layout->size);
+
+  addEntry(
+    onTop ? m_entriesOnTop : m_entries,
+    Entry{
+      std::move(layout),
+      offset,
+      Color{textColor, alphaFactor * textColor.a()},
+      Color{backgroundColor, alphaFactor * backgroundColor.a()}});
 }
 
-bool TextRenderer::isVisible(
-  RenderContext& renderContext,
-  const AttrString& string,
-  const TextAnchor& position,
-  const float distance,
-  const bool onTop) const
+bool TextRenderer::isInViewRange(
+  const RenderContext& renderContext, const float distance, const bool onTop) const
 {
   if (!onTop)
   {
@@ -143,13 +125,20 @@ bool TextRenderer::isVisible(
       return false;
     }
   }
+  return true;
+}
 
+bool TextRenderer::isVisible(
+  const RenderContext& renderContext,
+  const vm::vec2f& size,
+  const TextAnchor& position) const
+{
   const auto& camera = renderContext.camera();
   const auto& viewport = camera.viewport();
 
-  const auto size = stringSize(renderContext, string);
-  const auto offset = vm::vec2f{position.offset(camera, size)} - m_inset;
-  const auto actualSize = size + 2.0f * m_inset;
+  const auto roundedSize = vm::round(size);
+  const auto offset = vm::vec2f{position.offset(camera, roundedSize)} - m_inset;
+  const auto actualSize = roundedSize + 2.0f * m_inset;
 
   return viewport.contains(offset.x(), offset.y(), actualSize.x(), actualSize.y());
 }
@@ -176,18 +165,10 @@ float TextRenderer::computeAlphaFactor(
 void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry)
 {
   collection.entries.push_back(entry);
-  collection.textVertexCount += entry.vertices.size();
+  collection.textVertexCount += entry.layout->vertices.size();
   collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
 }
 
-vm::vec2f TextRenderer::stringSize(
-  RenderContext& renderContext, const AttrString& string) const
-{
-  auto& fontManager = renderContext.fontManager();
-  auto& font = fontManager.font(m_fontDescriptor);
-  return vm::round(font.measure(string));
-}
-
 void TextRenderer::doPrepareVertices(VboManager& vboManager)
 {
   prepare(m_entries, false, vboManager);
@@ -221,8 +202,8 @@ void TextRenderer::addEntry(
   std::vector<TextVertex>& textVertices,
   std::vector<RectVertex>& rectVertices)
 {
-  const auto& stringVertices = entry.vertices;
-  const auto& stringSize = entry.size;
+  const auto& stringVertices = entry.layout->vertices;
+  const auto& stringSize = entry.layout->size;
 
   const auto& offset = entry.offset;
 
@@ -98,6 +98,16 @@ size_t VboManager::currentVboSize() const
   return m_currentVboSize;
 }
 
+void VboManager::recordUpload(const size_t bytes)
+{
+  m_uploadedBytes += bytes;
+}
+
+size_t VboManager::uploadedBytes() const
+{
+  return m_uploadedBytes;
+}
+
 ShaderManager& VboManager::shaderManager()
 {
   return m_shaderManager;
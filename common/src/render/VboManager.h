@@ -44,6 +44,7 @@ private:
   size_t m_peakVboCount = 0;
   size_t m_currentVboCount = 0;
   size_t m_currentVboSize = 0;
+  size_t m_uploadedBytes = 0;
   ShaderManager& m_shaderManager;
 
 public:
@@ -59,6 +60,16 @@ public:
   size_t currentVboCount() const;
   size_t currentVboSize() const;
 
+  /**
+   * Records that the given number of bytes were uploaded to a buffer.
+   */
+  void recordUpload(size_t bytes);
+
+  /**
+   * Returns the total number of bytes recorded by recordUpload().
+   */
+  size_t uploadedBytes() const;
+
   ShaderManager& shaderManager();
 };
 
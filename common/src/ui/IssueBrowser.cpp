@@ -106,22 +106,23 @@ void IssueBrowser::documentWasSaved(MapDocument*)
 
 void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>&)
 {
-  m_view->reload();
+  m_view->scheduleValidation();
 }
 
 void IssueBrowser::nodesWereRemoved(const std::vector<mdl::Node*>&)
 {
-  m_view->reload();
+  m_view->removeIssuesOfRemovedNodes();
+  m_view->scheduleValidation();
 }
 
 void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>&)
 {
-  m_view->reload();
+  m_view->scheduleValidation();
 }
 
 void IssueBrowser::brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>&)
 {
-  m_view->reload();
+  m_view->scheduleValidation();
 }
 
 void IssueBrowser::issueIgnoreChanged(mdl::Issue*)
@@ -24,32 +24,37 @@
 #include <QItemSelectionModel>
 #include <QMenu>
 #include <QTableView>
+#include <QTimer>
 
-#include "mdl/BrushNode.h"
-#include "mdl/EntityNode.h"
-#include "mdl/GroupNode.h"
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
-#include "mdl/LayerNode.h"
-#include "mdl/PatchNode.h"
+#include "mdl/ValidationEngine.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
 #include "ui/QtUtils.h"
 #include "ui/Transaction.h"
 
 #include "kdl/memory_utils.h"
-#include "kdl/overload.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <unordered_set>
 #include <vector>
 
 namespace tb::ui
 {
+namespace
+{
+
+// the time spent validating issues per event loop iteration
+constexpr auto ValidationTimeBudget = std::chrono::milliseconds{8};
+
+} // namespace
 
 IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
   , m_document{std::move(document)}
+  , m_validationTimer{new QTimer{this}}
 {
   createGui();
   bindEvents();
@@ -85,19 +90,45 @@ void IssueBrowserView::setHiddenIssueTypes(const int hiddenIssueTypes)
   if (hiddenIssueTypes != m_hiddenIssueTypes)
   {
     m_hiddenIssueTypes = hiddenIssueTypes;
-    invalidate();
+    updateVisibleIssues();
   }
 }
 
 void IssueBrowserView::setShowHiddenIssues(const bool show)
 {
   m_showHiddenIssues = show;
-  invalidate();
+  updateVisibleIssues();
 }
 
 void IssueBrowserView::reload()
 {
-  invalidate();
+  m_issues.clear();
+  m_tableModel->setIssues({});
+
+  auto document = kdl::mem_lock(m_document);
+  if (auto* world = document->world())
+  {
+    // discard the issues removed before the world was loaded
+    world->validationEngine().validate(
+      world->registeredValidators(),
+      document->taskManager(),
+      std::chrono::milliseconds{0});
+  }
+
+  scheduleValidation();
+}
+
+void IssueBrowserView::scheduleValidation()
+{
+  if (!m_validationTimer->isActive())
+  {
+    m_validationTimer->start(0);
+  }
+}
+
+void IssueBrowserView::removeIssuesOfRemovedNodes()
+{
+  updateIssues(std::chrono::milliseconds{0});
 }
 
 void IssueBrowserView::deselectAll()
@@ -126,53 +157,69 @@ void IssueBrowserView::updateSelection()
   document->selectNodes(nodes);
 }
 
-void IssueBrowserView::updateIssues()
+void IssueBrowserView::updateIssues(const std::chrono::milliseconds timeBudget)
 {
   auto document = kdl::mem_lock(m_document);
-  if (document->world() != nullptr)
+  if (auto* world = document->world())
   {
-    const auto validators = document->world()->registeredValidators();
+    auto& validationEngine = world->validationEngine();
+    applyIssueDelta(validationEngine.validate(
+      world->registeredValidators(), document->taskManager(), timeBudget));
 
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
+    if (validationEngine.invalidNodeCount() == 0)
+    {
+      m_validationTimer->stop();
+    }
+  }
+  else
+  {
+    m_validationTimer->stop();
+  }
+}
+
+void IssueBrowserView::applyIssueDelta(mdl::IssueDelta delta)
+{
+  if (!delta.removedIssues.empty())
+  {
+    const auto removedIssues = std::unordered_set<const mdl::Issue*>{
+      delta.removedIssues.begin(), delta.removedIssues.end()};
+    m_issues = kdl::vec_erase_if(std::move(m_issues), [&](const auto* issue) {
+      return removedIssues.contains(issue);
     });
-    m_tableModel->setIssues(std::move(issues));
+    m_tableModel->removeIssues(removedIssues);
+  }
+
+  if (!delta.addedIssues.empty())
+  {
+    m_issues = kdl::vec_concat(std::move(m_issues), delta.addedIssues);
+
+    auto visibleIssues =
+      kdl::vec_filter(std::move(delta.addedIssues), [&](const auto* issue) {
+        return issueVisible(*issue);
+      });
+    visibleIssues = kdl::vec_sort(
+      std::move(visibleIssues),
+      [](const auto* lhs, const auto* rhs) { return lhs->seqId() > rhs->seqId(); });
+    m_tableModel->addIssues(std::move(visibleIssues));
   }
 }
 
+bool IssueBrowserView::issueVisible(const mdl::Issue& issue) const
+{
+  return m_showHiddenIssues
+         || (!issue.hidden() && (issue.type() & m_hiddenIssueTypes) == 0);
+}
+
+void IssueBrowserView::updateVisibleIssues()
+{
+  auto visibleIssues =
+    kdl::vec_filter(m_issues, [&](const auto* issue) { return issueVisible(*issue); });
+  visibleIssues = kdl::vec_sort(
+    std::move(visibleIssues),
+    [](const auto* lhs, const auto* rhs) { return lhs->seqId() > rhs->seqId(); });
+  m_tableModel->setIssues(std::move(visibleIssues));
+}
+
 void IssueBrowserView::applyQuickFix(const mdl::IssueQuickFix& quickFix)
 {
   auto document = kdl::mem_lock(m_document);
@@ -246,7 +293,7 @@ void IssueBrowserView::setIssueVisibility(const bool show)
     document->setIssueHidden(*issue, !show);
   }
 
-  invalidate();
+  updateVisibleIssues();
 }
 
 QList<QModelIndex> IssueBrowserView::getSelection() const
@@ -256,6 +303,10 @@ QList<QModelIndex> IssueBrowserView::getSelection() const
 
 void IssueBrowserView::bindEvents()
 {
+  connect(m_validationTimer, &QTimer::timeout, this, [&]() {
+    updateIssues(ValidationTimeBudget);
+  });
+
   m_tableView->setContextMenuPolicy(Qt::CustomContextMenu);
   connect(
     m_tableView,
@@ -320,23 +371,6 @@ void IssueBrowserView::hideIssues()
   setIssueVisibility(false);
 }
 
-void IssueBrowserView::invalidate()
-{
-  m_valid = false;
-  m_tableModel->setIssues({});
-
-  QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
-}
-
-void IssueBrowserView::validate()
-{
-  if (!m_valid)
-  {
-    updateIssues();
-    m_valid = true;
-  }
-}
-
 // IssueBrowserModel
 
 IssueBrowserModel::IssueBrowserModel(QObject* parent)
@@ -351,6 +385,45 @@ void IssueBrowserModel::setIssues(std::vector<const mdl::Issue*> issues)
   endResetModel();
 }
 
+void IssueBrowserModel::addIssues(std::vector<const mdl::Issue*> issues)
+{
+  if (!issues.empty())
+  {
+    beginInsertRows(QModelIndex{}, 0, static_cast<int>(issues.size()) - 1);
+    m_issues = kdl::vec_concat(std::move(issues), std::move(m_issues));
+    endInsertRows();
+  }
+}
+
+void IssueBrowserModel::removeIssues(const std::unordered_set<const mdl::Issue*>& issues)
+{
+  // remove contiguous ranges of rows, starting at the end so that the indices of the
+  // remaining rows don't change
+  auto end = m_issues.size();
+  while (end > 0)
+  {
+    if (!issues.contains(m_issues[end - 1]))
+    {
+      --end;
+      continue;
+    }
+
+    auto begin = end - 1;
+    while (begin > 0 && issues.contains(m_issues[begin - 1]))
+    {
+      --begin;
+    }
+
+    beginRemoveRows(QModelIndex{}, static_cast<int>(begin), static_cast<int>(end - 1));
+    m_issues.erase(
+      m_issues.begin() + static_cast<std::ptrdiff_t>(begin),
+      m_issues.begin() + static_cast<std::ptrdiff_t>(end));
+    endRemoveRows();
+
+    end = begin;
+  }
+}
+
 const std::vector<const mdl::Issue*>& IssueBrowserModel::issues()
 {
   return m_issues;
@@ -24,11 +24,14 @@
 
 #include "mdl/IssueType.h"
 
+#include <chrono>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
-class QWidget;
 class QTableView;
+class QTimer;
+class QWidget;
 
 namespace tb
 {
@@ -36,6 +39,7 @@ namespace mdl
 {
 class Issue;
 class IssueQuickFix;
+struct IssueDelta;
 } // namespace mdl
 
 namespace ui
@@ -52,10 +56,12 @@ private:
   int m_hiddenIssueTypes = 0;
   bool m_showHiddenIssues = false;
 
-  bool m_valid = false;
+  // all issues of the world, including hidden and filtered issues
+  std::vector<const mdl::Issue*> m_issues;
 
   QTableView* m_tableView = nullptr;
   IssueBrowserModel* m_tableModel = nullptr;
+  QTimer* m_validationTimer = nullptr;
 
 public:
   explicit IssueBrowserView(
@@ -68,11 +74,31 @@ public:
   int hiddenIssueTypes() const;
   void setHiddenIssueTypes(int hiddenIssueTypes);
   void setShowHiddenIssues(bool show);
+
+  /**
+   * Discards all issues and validates the entire world.
+   */
   void reload();
+
+  /**
+   * Validates the invalid nodes of the world incrementally, using a time budget per
+   * event loop iteration.
+   */
+  void scheduleValidation();
+
+  /**
+   * Removes the issues of nodes that were removed from the world. Must be called before
+   * the removed nodes can be deleted.
+   */
+  void removeIssuesOfRemovedNodes();
+
   void deselectAll();
 
 private:
-  void updateIssues();
+  void updateIssues(std::chrono::milliseconds timeBudget);
+  void applyIssueDelta(mdl::IssueDelta delta);
+  bool issueVisible(const mdl::Issue& issue) const;
+  void updateVisibleIssues();
 
   std::vector<const mdl::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
   std::vector<const mdl::IssueQuickFix*> collectQuickFixes(
@@ -90,16 +116,11 @@ private:
   void showIssues();
   void hideIssues();
   void applyQuickFix(const mdl::IssueQuickFix& quickFix);
-
-private:
-  void invalidate();
-public slots:
-  void validate();
 };
 
 /**
- * Trivial QAbstractTableModel subclass, when the issues list changes,
- * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Trivial QAbstractTableModel subclass. Issues can be added and removed incrementally, or
+ * the entire list can be replaced with beginResetModel()/endResetModel().
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
@@ -111,6 +132,13 @@ public:
   explicit IssueBrowserModel(QObject* parent);
 
   void setIssues(std::vector<const mdl::Issue*> issues);
+
+  /**
+   * Inserts the given issues at the top of the list.
+   */
+  void addIssues(std::vector<const mdl::Issue*> issues);
+  void removeIssues(const std::unordered_set<const mdl::Issue*>& issues);
+
   const std::vector<const mdl::Issue*>& issues();
 
 public: // QAbstractTableModel overrides
@@ -35,6 +35,7 @@
 #include "io/PathInfo.h"
 #include "io/SimpleParserStatus.h"
 #include "io/SystemPaths.h"
+#include "io/TextureCache.h"
 #include "io/WorldReader.h"
 #include "mdl/AssetUtils.h"
 #include "mdl/BezierPatch.h"
@@ -1421,8 +1422,7 @@ void MapDocument::selectSiblings()
 void MapDocument::selectTouching(const bool del)
 {
   const auto nodes = kdl::vec_filter(
-    mdl::collectTouchingNodes(
-      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+    mdl::collectTouchingNodes(*m_world, m_selectedNodes.brushes()),
     [&](mdl::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Touching"};
@@ -1441,8 +1441,7 @@ void MapDocument::selectTouching(const bool del)
 void MapDocument::selectInside(const bool del)
 {
   const auto nodes = kdl::vec_filter(
-    mdl::collectContainedNodes(
-      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+    mdl::collectContainedNodes(*m_world, m_selectedNodes.brushes()),
     [&](mdl::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Inside"};
@@ -1662,7 +1661,7 @@ void MapDocument::selectTall(const vm::axis::type cameraAxis)
 
         const auto nodesToSelect = kdl::vec_filter(
           mdl::collectContainedNodes(
-            {world()},
+            *world(),
             kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); })),
           [&](const auto* node) { return editorContext().selectable(node); });
         selectNodes(nodesToSelect);
@@ -3117,48 +3116,47 @@ bool MapDocument::transformObjects(
   const auto updateAngleProperty =
     m_world->entityPropertyConfig().updateAnglePropertyAfterTransform;
 
-  auto tasks =
-    nodesToTransform | std::views::transform([&](auto& node) {
-      return std::function{[&]() {
-        return node->accept(kdl::overload(
-          [&](mdl::WorldNode*) -> TransformResult {
-            ensure(false, "Unexpected world node");
-          },
-          [&](mdl::LayerNode*) -> TransformResult {
-            ensure(false, "Unexpected layer node");
-          },
-          [&](mdl::GroupNode* groupNode) -> TransformResult {
-            auto group = groupNode->group();
-            group.transform(transformation);
-            return std::make_pair(groupNode, mdl::NodeContents{std::move(group)});
-          },
-          [&](mdl::EntityNode* entityNode) -> TransformResult {
-            auto entity = entityNode->entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(entityNode, mdl::NodeContents{std::move(entity)});
-          },
-          [&](mdl::BrushNode* brushNode) -> TransformResult {
-            const auto* containingGroup = brushNode->containingGroup();
-            const bool lockAlignment =
+  auto transformResults =
+    m_taskManager.parallel_transform(nodesToTransform, [&](auto& node) {
+      return node->accept(kdl::overload(
+        [&](mdl::WorldNode*) -> TransformResult {
+          ensure(false, "Unexpected world node");
+        },
+        [&](mdl::LayerNode*) -> TransformResult {
+          ensure(false, "Unexpected layer node");
+        },
+        [&](mdl::GroupNode* groupNode) -> TransformResult {
+          auto group = groupNode->group();
+          group.transform(transformation);
+          return std::make_pair(groupNode, mdl::NodeContents{std::move(group)});
+        },
+        [&](mdl::EntityNode* entityNode) -> TransformResult {
+          auto entity = entityNode->entity();
+          entity.transform(transformation, updateAngleProperty);
+          return std::make_pair(entityNode, mdl::NodeContents{std::move(entity)});
+        },
+        [&](mdl::BrushNode* brushNode) -> TransformResult {
+          const auto* containingGroup = brushNode->containingGroup();
+          const bool lockAlignment =
             alignmentLock
-            || (containingGroup && containingGroup->closed() && mdl::collectLinkedNodes({m_world.get()}, *brushNode).size() > 1);
-
-            auto brush = brushNode->brush();
-            return brush.transform(m_worldBounds, transformation, lockAlignment)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         brushNode, mdl::NodeContents{std::move(brush)});
-                     });
-          },
-          [&](mdl::PatchNode* patchNode) -> TransformResult {
-            auto patch = patchNode->patch();
-            patch.transform(transformation);
-            return std::make_pair(patchNode, mdl::NodeContents{std::move(patch)});
-          }));
-      }};
+            || (containingGroup && containingGroup->closed()
+                && mdl::collectLinkedNodes({m_world.get()}, *brushNode).size() > 1);
+
+          auto brush = brushNode->brush();
+          return brush.transform(m_worldBounds, transformation, lockAlignment)
+                 | kdl::and_then([&]() -> TransformResult {
+                     return std::make_pair(
+                       brushNode, mdl::NodeContents{std::move(brush)});
+                   });
+        },
+        [&](mdl::PatchNode* patchNode) -> TransformResult {
+          auto patch = patchNode->patch();
+          patch.transform(transformation);
+          return std::make_pair(patchNode, mdl::NodeContents{std::move(patch)});
+        }));
     });
 
-  return m_taskManager.run_tasks_and_wait(tasks) | kdl::fold
+  return std::move(transformResults) | kdl::fold
          | kdl::and_then([&](auto nodesToUpdate) -> Result<bool> {
              const auto success = swapNodeContents(
                commandName,
@@ -4515,6 +4513,17 @@ void MapDocument::pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) co
   }
 }
 
+void MapDocument::pickClosest(
+  const vm::ray3d& pickRay,
+  const mdl::HitFilter& filter,
+  mdl::PickResult& pickResult) const
+{
+  if (m_world)
+  {
+    m_world->pickClosest(*m_editorContext, pickRay, filter, pickResult);
+  }
+}
+
 std::vector<mdl::Node*> MapDocument::findNodesContaining(const vm::vec3d& point) const
 {
   auto result = std::vector<mdl::Node*>{};
@@ -4735,15 +4744,35 @@ void MapDocument::loadMaterials()
       [](const auto& str) { return std::filesystem::path{str}; });
     m_game->reloadWads(path(), wadPaths, logger());
   }
+
+  auto textureCache =
+    pref(Preferences::EnableTextureCache)
+      ? std::make_shared<const io::TextureCache>(
+          io::SystemPaths::userDataDirectory() / "TextureCache" / m_game->config().name)
+      : nullptr;
+
+  if (textureCache)
+  {
+    textureCache->evictEntries() | kdl::transform_error([&](auto e) {
+      warn() << "Could not evict texture cache entries: " << e.msg;
+    });
+  }
+
+  const auto loadMode = pref(Preferences::LoadTexturesOnDemand)
+                          ? mdl::ResourceLoadMode::OnDemand
+                          : mdl::ResourceLoadMode::Immediate;
+
   m_materialManager->reload(
     m_game->gameFileSystem(),
     m_game->config().materialConfig,
     [&](auto resourceLoader) {
-      auto resource = std::make_shared<mdl::TextureResource>(std::move(resourceLoader));
+      auto resource =
+        std::make_shared<mdl::TextureResource>(std::move(resourceLoader), loadMode);
       m_resourceManager->addResource(resource);
       return resource;
     },
-    m_taskManager);
+    m_taskManager,
+    std::move(textureCache));
 }
 
 void MapDocument::unloadMaterials()
@@ -4752,26 +4781,44 @@ void MapDocument::unloadMaterials()
   m_materialManager->clear();
 }
 
-static auto makeSetMaterialsVisitor(mdl::MaterialManager& manager)
+static void assignMaterials(
+  const std::vector<mdl::Node*>& nodes,
+  mdl::MaterialManager& manager,
+  kdl::task_manager& taskManager)
 {
-  return kdl::overload(
-    [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
-    [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
-    [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
-    [](auto&& thisLambda, mdl::EntityNode* entity) { entity->visitChildren(thisLambda); },
-    [&](mdl::BrushNode* brushNode) {
-      const mdl::Brush& brush = brushNode->brush();
-      for (size_t i = 0u; i < brush.faceCount(); ++i)
-      {
-        const mdl::BrushFace& face = brush.face(i);
-        mdl::Material* material = manager.material(face.attributes().materialName());
-        brushNode->setFaceMaterial(i, material);
-      }
-    },
-    [&](mdl::PatchNode* patchNode) {
-      auto* material = manager.material(patchNode->patch().materialName());
-      patchNode->setMaterial(material);
-    });
+  auto brushNodes = std::vector<mdl::BrushNode*>{};
+  auto patchNodes = std::vector<mdl::PatchNode*>{};
+  mdl::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
+      [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
+      [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
+      [](auto&& thisLambda, mdl::EntityNode* entity) {
+        entity->visitChildren(thisLambda);
+      },
+      [&](mdl::BrushNode* brushNode) { brushNodes.push_back(brushNode); },
+      [&](mdl::PatchNode* patchNode) { patchNodes.push_back(patchNode); }));
+
+  // The given nodes may contain each other, but every node must be updated by only one
+  // task. Material lookups don't modify the material manager, and material usage counts
+  // are atomic.
+  brushNodes = kdl::vec_sort_and_remove_duplicates(std::move(brushNodes));
+  patchNodes = kdl::vec_sort_and_remove_duplicates(std::move(patchNodes));
+
+  taskManager.parallel_for(brushNodes, [&](mdl::BrushNode* brushNode) {
+    const mdl::Brush& brush = brushNode->brush();
+    for (size_t i = 0u; i < brush.faceCount(); ++i)
+    {
+      const mdl::BrushFace& face = brush.face(i);
+      mdl::Material* material = manager.material(face.attributes().materialName());
+      brushNode->setFaceMaterial(i, material);
+    }
+  });
+  taskManager.parallel_for(patchNodes, [&](mdl::PatchNode* patchNode) {
+    auto* material = manager.material(patchNode->patch().materialName());
+    patchNode->setMaterial(material);
+  });
 }
 
 static auto makeUnsetMaterialsVisitor()
@@ -4793,13 +4840,13 @@ static auto makeUnsetMaterialsVisitor()
 
 void MapDocument::setMaterials()
 {
-  m_world->accept(makeSetMaterialsVisitor(*m_materialManager));
+  assignMaterials({m_world.get()}, *m_materialManager, m_taskManager);
   materialUsageCountsDidChangeNotifier();
 }
 
 void MapDocument::setMaterials(const std::vector<mdl::Node*>& nodes)
 {
-  mdl::Node::visitAll(nodes, makeSetMaterialsVisitor(*m_materialManager));
+  assignMaterials(nodes, *m_materialManager, m_taskManager);
   materialUsageCountsDidChangeNotifier();
 }
 
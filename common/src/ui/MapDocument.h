@@ -25,6 +25,7 @@
 #include "io/ExportOptions.h"
 #include "mdl/ColorRange.h"
 #include "mdl/Game.h"
+#include "mdl/HitFilter.h"
 #include "mdl/MapFacade.h"
 #include "mdl/NodeCollection.h"
 #include "mdl/NodeContents.h"
@@ -698,6 +699,15 @@ public: // asset state management
 
 public: // picking
   void pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) const;
+
+  /**
+   * Picks only as many nodes as needed to determine pickResult.first(filter). See
+   * WorldNode::pickClosest.
+   */
+  void pickClosest(
+    const vm::ray3d& pickRay,
+    const mdl::HitFilter& filter,
+    mdl::PickResult& pickResult) const;
   std::vector<mdl::Node*> findNodesContaining(const vm::vec3d& point) const;
 
 private: // world management
@@ -196,9 +196,9 @@ void MaterialBrowserView::addMaterialToLayout(
   const auto titleHeight = fontManager().font(font).measure(materialName).y();
 
   const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
-  const auto* texture = material.texture();
-  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
-  const auto scaledTextureSize = vm::round(scaleFactor * textureSize);
+  const auto textureSize = material.textureSize();
+  const auto textureSizef = textureSize ? vm::vec2f{*textureSize} : vm::vec2f{64, 64};
+  const auto scaledTextureSize = vm::round(scaleFactor * textureSizef);
 
   layout.addItem(
     &material,
@@ -402,6 +402,7 @@ void MaterialBrowserView::renderMaterials(
               Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
             });
 
+            material.requestTexture();
             material.activate(
               pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
 
@@ -436,9 +437,9 @@ QString MaterialBrowserView::tooltip(const Cell& cell)
   auto ss = QTextStream{&tooltip};
   ss << QString::fromStdString(material.name()) << "\n";
 
-  if (const auto* texture = material.texture())
+  if (const auto textureSize = material.textureSize())
   {
-    ss << texture->width() << "x" << texture->height();
+    ss << textureSize->x() << "x" << textureSize->y();
   }
   else
   {
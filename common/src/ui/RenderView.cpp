@@ -33,6 +33,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 /*
  * - glew requires it is included before <OpenGL/gl.h>
  *
@@ -98,18 +100,23 @@ RenderView::RenderView(GLContextManager& contextManager, QWidget* parent)
     const int64_t fpsCounterPeriod = currentTime - m_lastFPSCounterUpdate;
     const double avgFps =
       double(framesRenderedInPeriod) / (double(fpsCounterPeriod) / 1000.0);
+    const size_t uploadedBytes = m_glContext->vboManager().uploadedBytes();
+    const size_t avgUploadedBytes =
+      (uploadedBytes - m_lastUploadedBytes) / size_t(std::max(framesRenderedInPeriod, 1));
 
     m_framesRendered = 0;
     m_maxFrameTimeMsecs = 0;
     m_lastFPSCounterUpdate = currentTime;
+    m_lastUploadedBytes = uploadedBytes;
 
     m_currentFPS = fmt::format(
-      R"(Avg FPS: {} Max time between frames: {}ms. {} currentVBOS({} peak) totalling {} KiB)",
+      R"(Avg FPS: {} Max time between frames: {}ms. {} currentVBOS({} peak) totalling {} KiB. Avg {} KiB uploaded per frame)",
       avgFps,
       maxFrameTime,
       m_glContext->vboManager().currentVboCount(),
       m_glContext->vboManager().peakVboCount(),
-      m_glContext->vboManager().currentVboSize() / 1024u);
+      m_glContext->vboManager().currentVboSize() / 1024u,
+      avgUploadedBytes / 1024u);
   });
 
   fpsCounter->start(1000);
@@ -58,6 +58,7 @@ private: // FPS counter
   int m_maxFrameTimeMsecs = 0;
   // other
   int64_t m_lastFPSCounterUpdate = 0;
+  size_t m_lastUploadedBytes = 0;
   QElapsedTimer m_timeSinceLastFrame;
 
 protected:
@@ -17,9 +17,11 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "FileLocation.h"
 #include "el/ELExceptions.h"
 #include "el/ELTestUtils.h"
 #include "el/EvaluationContext.h"
+#include "el/EvaluationTrace.h"
 #include "el/Expression.h"
 #include "el/Value.h"
 #include "el/VariableStore.h"
@@ -1207,6 +1209,30 @@ TEST_CASE("Expression")
     CHECK(io::ELParser::parseStrict(expression).value().optimize() == expectedExpression);
   }
 
+  SECTION("variableNames")
+  {
+    using T = std::tuple<std::string, std::vector<std::string>>;
+
+    // clang-format off
+    const auto
+    [expression,                    expectedVariableNames] = GENERATE(values<T>({
+    {"1",                           {}},
+    {"a",                           {"a"}},
+    {"[a, 1, b]",                   {"a", "b"}},
+    {"{x: b, y: a}",                {"a", "b"}},
+    {"-a + b * a",                  {"a", "b"}},
+    {"a[b]",                        {"a", "b"}},
+    {"{{ x == 1 -> y, z }}",        {"x", "y", "z"}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    CHECK(
+      io::ELParser::parseStrict(expression).value().variableNames()
+      == expectedVariableNames);
+  }
+
   SECTION("accept")
   {
     CHECK(preorderVisit("1") == std::vector<std::string>{"1"});
@@ -1222,6 +1248,30 @@ TEST_CASE("Expression")
       preorderVisit("{{ x -> 1 }}")
       == std::vector<std::string>{"{{ x -> 1 }}", "x -> 1", "x", "1"});
   }
+
+  SECTION("evaluate with trace")
+  {
+    const auto expression = io::ELParser::parseStrict(R"([1, 1, "a", "a"])").value();
+
+    auto trace = EvaluationTrace{};
+    const auto value = expression.evaluate(EvaluationContext{}, trace);
+    const auto& elements = value.arrayValue();
+    REQUIRE(elements.size() == 4);
+
+    // equal values are traced to the expressions that produced them
+    CHECK(trace.getLocation(value) == FileLocation{1, 1});
+    CHECK(trace.getLocation(elements[0]) == FileLocation{1, 2});
+    CHECK(trace.getLocation(elements[1]) == FileLocation{1, 5});
+    CHECK(trace.getLocation(elements[2]) == FileLocation{1, 8});
+    CHECK(trace.getLocation(elements[3]) == FileLocation{1, 13});
+
+    // copies of a value share its identity
+    const auto copy = elements[1];
+    CHECK(trace.getLocation(copy) == FileLocation{1, 5});
+
+    // values that were not produced by the evaluation are not traced
+    CHECK(trace.getLocation(Value{1}) == std::nullopt);
+  }
 }
 
 } // namespace tb::el
@@ -110,6 +110,21 @@ TEST_CASE("DiskIO")
     }
   }
 
+  SECTION("fixPath finds files created after a directory was listed")
+  {
+    if (Disk::isCaseSensitive())
+    {
+      auto newEnv = makeTestEnvironment();
+      CHECK(Disk::fixPath(newEnv.dir() / "NEW.txt") == newEnv.dir() / "NEW.txt");
+
+      newEnv.createFile("new.txt", "some content");
+      CHECK(Disk::fixPath(newEnv.dir() / "NEW.txt") == newEnv.dir() / "new.txt");
+
+      Disk::clearDirectoryCache();
+      CHECK(Disk::fixPath(newEnv.dir() / "NEW.txt") == newEnv.dir() / "new.txt");
+    }
+  }
+
   SECTION("pathInfo")
   {
     CHECK(Disk::pathInfo("asdf/bleh") == PathInfo::Unknown);
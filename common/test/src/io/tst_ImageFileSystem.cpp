@@ -26,6 +26,10 @@
 #include "io/WadFileSystem.h"
 #include "io/ZipFileSystem.h"
 
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
 #include <filesystem>
 
 #include "catch/Matchers.h"
@@ -984,6 +988,48 @@ TEST_CASE("Flat ImageFileSystems")
   }
 }
 
+TEST_CASE("ZipFileSystem")
+{
+  SECTION("Files can be extracted concurrently")
+  {
+    const auto fs = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(
+      std::filesystem::current_path() / "fixture/test/io/Zip/zip.zip")};
+
+    const auto paths =
+      fs->find("", TraversalMode::Recursive)
+      | kdl::transform([&](auto foundPaths) {
+          return kdl::vec_filter(std::move(foundPaths), [&](const auto& path) {
+            return fs->pathInfo(path) == PathInfo::File;
+          });
+        })
+      | kdl::value();
+    REQUIRE(!paths.empty());
+
+    const auto readContents = [&](const auto& path) {
+      const auto file = fs->openFile(path) | kdl::value();
+      auto reader = file->reader();
+      return reader.readString(reader.size());
+    };
+
+    const auto expectedContents = kdl::vec_transform(paths, readContents);
+
+    // extract every file many times so that extractions overlap
+    auto repeatedPaths = std::vector<std::filesystem::path>{};
+    for (size_t i = 0; i < 32; ++i)
+    {
+      repeatedPaths = kdl::vec_concat(std::move(repeatedPaths), paths);
+    }
+
+    auto taskManager = kdl::task_manager{8};
+    const auto contents = taskManager.parallel_transform(repeatedPaths, readContents);
+
+    for (size_t i = 0; i < contents.size(); ++i)
+    {
+      CHECK(contents[i] == expectedContents[i % paths.size()]);
+    }
+  }
+}
+
 TEST_CASE("WadFileSystem")
 {
   SECTION("Wad files can be replaced while wad file system exists")
@@ -0,0 +1,196 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/MapFormatDetection.h"
+#include "mdl/MapFormat.h"
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("rankMapFormats")
+{
+  using F = mdl::MapFormat;
+
+  SECTION("Map without brushes")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Valve, F::Standard}) == std::vector{F::Valve, F::Standard});
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Valve}) == std::vector{F::Standard, F::Valve});
+  }
+
+  SECTION("Standard")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0 -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0 -0 ) "quoted tex" 0 0 0 1 1 // comment
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Valve, F::Standard}) == std::vector{F::Standard, F::Valve});
+    CHECK(
+      rankMapFormats(str, {F::Valve, F::Quake2, F::Standard})
+      == std::vector{F::Quake2, F::Standard, F::Valve});
+  }
+
+  SECTION("Valve")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0 -0 ) ( 64 -0 -16 ) tex1 [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0 -0 ) tex2 [ 1 0 0 16.5 ] [ 0 0 -1 -8 ] 90 0.5 0.5
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Valve}) == std::vector{F::Valve, F::Standard});
+    CHECK(
+      rankMapFormats(str, {F::Quake2, F::Quake2_Valve})
+      == std::vector{F::Quake2_Valve, F::Quake2});
+  }
+
+  SECTION("Quake 2")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -712 1280 -448 ) ( -904 1280 -448 ) ( -904 992 -448 ) attribsExplicit 56 -32 0 1 1 8 9 700
+( -904 992 -416 ) ( -904 1280 -416 ) ( -712 1280 -416 ) attribsOmitted 32 32 0 1 1
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Hexen2, F::Quake2})
+      == std::vector{F::Quake2, F::Standard, F::Hexen2});
+  }
+
+  SECTION("Daikatana")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -712 1280 -448 ) ( -904 1280 -448 ) ( -904 992 -448 ) rtz/c_mf_v3cw 0 0 0 1 1 0 0 0 255 0 0
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Quake2, F::Daikatana})
+      == std::vector{F::Daikatana, F::Quake2});
+  }
+
+  SECTION("Hexen 2")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -712 1280 -448 ) ( -904 1280 -448 ) ( -904 992 -448 ) tex 0 0 0 1 1 0
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Hexen2})
+      == std::vector{F::Hexen2, F::Standard});
+  }
+
+  SECTION("Quake 3")
+  {
+    const auto brushPrimitive = R"(
+{
+"classname" "worldspawn"
+{
+brushDef
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) ( ( 0.03125 0 0 ) ( 0 0.03125 0 ) ) tex 0 0 0
+}
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(brushPrimitive, {F::Quake3_Legacy, F::Quake3_Valve, F::Quake3})
+      == std::vector{F::Quake3, F::Quake3_Legacy, F::Quake3_Valve});
+
+    const auto patch = R"(
+{
+"classname" "worldspawn"
+{
+patchDef2
+{
+common/caulk
+( 5 3 0 0 0 )
+(
+( ( -64 -64 4 0 0 ) ( -64 0 4 0 -0.25 ) ( -64 64 4 0 -0.5 ) )
+)
+}
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(patch, {F::Standard, F::Quake3_Legacy, F::Quake3})
+      == std::vector{F::Quake3_Legacy, F::Quake3, F::Standard});
+  }
+
+  SECTION("Only a bounded number of samples is examined")
+  {
+    const auto str = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0 -0 ) ( 64 -0 -16 ) tex1 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0 -0 ) tex2 0 0 0 1 1 1 2 3
+}
+}
+)";
+
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Quake2}, 1)
+      == std::vector{F::Standard, F::Quake2});
+    CHECK(
+      rankMapFormats(str, {F::Standard, F::Quake2}, 2)
+      == std::vector{F::Quake2, F::Standard});
+  }
+}
+
+} // namespace tb::io
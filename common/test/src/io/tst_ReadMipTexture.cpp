@@ -28,6 +28,8 @@
 
 #include "kdl/result.h"
 
+#include "vm/vec_io.h" // IWYU pragma: keep
+
 #include <filesystem>
 #include <string>
 
@@ -85,6 +87,9 @@ TEST_CASE("readIdMipTexture")
 
   CHECK(texture.width() == width);
   CHECK(texture.height() == height);
+
+  auto sizeReader = file->reader();
+  CHECK((readMipTextureSize(sizeReader) | kdl::value()) == vm::vec2s{width, height});
 }
 
 TEST_CASE("readHlMipTexture")
@@ -114,6 +119,9 @@ TEST_CASE("readHlMipTexture")
   CHECK(logger.countMessages(LogLevel::Warn) == 0);
   CHECK(texture.width() == width);
   CHECK(texture.height() == height);
+
+  auto sizeReader = file->reader();
+  CHECK((readMipTextureSize(sizeReader) | kdl::value()) == vm::vec2s{width, height});
 }
 
 } // namespace tb::io
@@ -24,6 +24,8 @@
 
 #include "kdl/result.h"
 
+#include "vm/vec_io.h" // IWYU pragma: keep
+
 #include <filesystem>
 
 #include "Catch2.h"
@@ -72,6 +74,9 @@ TEST_CASE("readWalTexture")
   CHECK(texture.width() == width);
   CHECK(texture.height() == height);
   CHECK(texture.embeddedDefaults() == embeddedDefaults);
+
+  auto sizeReader = file->reader();
+  CHECK((readWalTextureSize(sizeReader) | kdl::value()) == vm::vec2s{width, height});
 }
 
 } // namespace tb::io
@@ -229,4 +229,43 @@ TEST_CASE("FileReaderTest.subReader")
 {
   subReader(file()->reader());
 }
+
+TEST_CASE("FileReaderTest.mappedFile")
+{
+  SECTION("Empty files are not mapped")
+  {
+    const auto emptyFile =
+      Disk::openFile(std::filesystem::current_path() / "fixture/test/io/Reader/empty")
+      | kdl::value();
+    CHECK_FALSE(emptyFile->isMapped());
+  }
+
+  SECTION("Readers remain valid after the file is destroyed")
+  {
+    auto mappedFile =
+      Disk::openFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+      | kdl::value();
+    REQUIRE(mappedFile->isMapped());
+
+    auto reader = mappedFile->reader();
+    auto subReader = reader.subReaderFromBegin(5, 3);
+    const auto bufferedReader = reader.buffer();
+    mappedFile.reset();
+
+    CHECK(reader.readString(10) == "abcdefghij");
+    CHECK(subReader.readString(3) == "fgh");
+    CHECK(bufferedReader.stringView() == "abcdefghij");
+  }
+
+  SECTION("Files are not mapped if not requested")
+  {
+    const auto unmappedFile =
+      Disk::openFile(
+        std::filesystem::current_path() / "fixture/test/io/Reader/10byte",
+        FileMapping::Unmapped)
+      | kdl::value();
+    CHECK_FALSE(unmappedFile->isMapped());
+    CHECK(unmappedFile->reader().readString(10) == "abcdefghij");
+  }
+}
 } // namespace tb::io
@@ -0,0 +1,263 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/DiskFileSystem.h"
+#include "io/Reader.h"
+#include "io/TestEnvironment.h"
+#include "io/TestFileSystem.h"
+#include "io/TextureCache.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/result.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+namespace
+{
+
+mdl::Texture makeTexture()
+{
+  auto mip0 = mdl::TextureBuffer{4 * 4 * 4};
+  auto mip1 = mdl::TextureBuffer{2 * 2 * 4};
+  std::fill_n(mip0.data(), mip0.size(), 0x7F);
+  std::fill_n(mip1.data(), mip1.size(), 0x3F);
+
+  auto buffers = mdl::TextureBufferList{};
+  buffers.push_back(std::move(mip0));
+  buffers.push_back(std::move(mip1));
+
+  return mdl::Texture{
+    4,
+    4,
+    Color{0.5f, 0.25f, 0.125f, 1.0f},
+    GL_RGBA,
+    mdl::TextureMask::On,
+    mdl::Q2EmbeddedDefaults{1, 2, 3},
+    std::move(buffers)};
+}
+
+void checkTexture(const mdl::Texture& actual, const mdl::Texture& expected)
+{
+  CHECK(actual.width() == expected.width());
+  CHECK(actual.height() == expected.height());
+  CHECK(actual.averageColor() == expected.averageColor());
+  CHECK(actual.format() == expected.format());
+  CHECK(actual.mask() == expected.mask());
+  CHECK(actual.embeddedDefaults() == expected.embeddedDefaults());
+
+  const auto& actualBuffers = actual.buffersIfLoaded();
+  const auto& expectedBuffers = expected.buffersIfLoaded();
+  REQUIRE(actualBuffers.size() == expectedBuffers.size());
+  for (size_t i = 0; i < actualBuffers.size(); ++i)
+  {
+    REQUIRE(actualBuffers[i].size() == expectedBuffers[i].size());
+    CHECK(std::equal(
+      actualBuffers[i].data(),
+      actualBuffers[i].data() + actualBuffers[i].size(),
+      expectedBuffers[i].data()));
+  }
+}
+
+} // namespace
+
+TEST_CASE("writeCachedTexture")
+{
+  const auto texture = makeTexture();
+  const auto key = TextureCacheKey{"/some/file.wad:texture.d", 1234, 5678};
+
+  auto stream = std::stringstream{};
+  REQUIRE(writeCachedTexture(stream, key, texture).is_success());
+
+  const auto data = stream.str();
+  auto reader = Reader::from(data.data(), data.data() + data.size());
+
+  SECTION("same key")
+  {
+    const auto cachedTexture = readCachedTexture(reader, key);
+    REQUIRE(cachedTexture.is_success());
+    checkTexture(cachedTexture.value(), texture);
+  }
+
+  SECTION("different location")
+  {
+    CHECK(readCachedTexture(reader, {"/some/file.wad:other.d", 1234, 5678}).is_error());
+  }
+
+  SECTION("different size")
+  {
+    CHECK(readCachedTexture(reader, {key.location, 1235, 5678}).is_error());
+  }
+
+  SECTION("different modification time")
+  {
+    CHECK(readCachedTexture(reader, {key.location, 1234, 5679}).is_error());
+  }
+
+  SECTION("truncated data")
+  {
+    auto truncatedReader = Reader::from(data.data(), data.data() + data.size() - 1);
+    CHECK(readCachedTexture(truncatedReader, key).is_error());
+  }
+}
+
+TEST_CASE("makeTextureCacheKey")
+{
+  auto env = TestEnvironment{};
+  env.createFile("textures/test.png", "some content");
+
+  const auto fs = DiskFileSystem{env.dir()};
+
+  SECTION("file on disk")
+  {
+    const auto key = makeTextureCacheKey(fs, "textures/test.png", "");
+    REQUIRE(key);
+    CHECK(key->location == (env.dir() / "textures/test.png").generic_string());
+    CHECK(key->size == 12);
+  }
+
+  SECTION("context is part of the location")
+  {
+    CHECK(
+      makeTextureCacheKey(fs, "textures/test.png", "palette")->location
+      != makeTextureCacheKey(fs, "textures/test.png", "")->location);
+  }
+
+  SECTION("missing file")
+  {
+    CHECK_FALSE(makeTextureCacheKey(fs, "textures/missing.png", ""));
+  }
+
+  SECTION("file that is not on disk")
+  {
+    const auto testFs = TestFileSystem{
+      DirectoryEntry{"", {FileEntry{"test.png", makeObjectFile(1)}}},
+      {},
+      env.dir() / "does_not_exist"};
+    CHECK_FALSE(makeTextureCacheKey(testFs, "test.png", ""));
+  }
+}
+
+TEST_CASE("TextureCache")
+{
+  auto env = TestEnvironment{};
+  env.createFile("textures/test.png", "some content");
+
+  const auto fs = DiskFileSystem{env.dir()};
+  const auto cache = TextureCache{env.dir() / "cache"};
+  const auto texture = makeTexture();
+
+  const auto key = makeTextureCacheKey(fs, "textures/test.png", "");
+  REQUIRE(key);
+
+  CHECK_FALSE(cache.load(*key).has_value());
+
+  REQUIRE(cache.store(*key, texture).is_success());
+  CHECK(env.directoryContents("cache").size() == 1);
+
+  const auto cachedTexture = cache.load(*key);
+  REQUIRE(cachedTexture.has_value());
+  checkTexture(*cachedTexture, texture);
+
+  SECTION("entries become stale when the source file changes")
+  {
+    env.createFile("textures/test.png", "some other content");
+
+    const auto changedKey = makeTextureCacheKey(fs, "textures/test.png", "");
+    REQUIRE(changedKey);
+    CHECK_FALSE(cache.load(*changedKey).has_value());
+
+    REQUIRE(cache.store(*changedKey, texture).is_success());
+    CHECK(cache.load(*changedKey).has_value());
+    CHECK(env.directoryContents("cache").size() == 1);
+  }
+}
+
+TEST_CASE("TextureCache.evictEntries")
+{
+  auto env = TestEnvironment{};
+  env.createFile("textures/old.png", "some content");
+  env.createFile("textures/new.png", "some other content");
+
+  const auto fs = DiskFileSystem{env.dir()};
+  const auto texture = makeTexture();
+
+  const auto oldKey = makeTextureCacheKey(fs, "textures/old.png", "");
+  const auto newKey = makeTextureCacheKey(fs, "textures/new.png", "");
+  REQUIRE(oldKey);
+  REQUIRE(newKey);
+
+  const auto cacheDir = env.dir() / "cache";
+  const auto storingCache = TextureCache{cacheDir};
+
+  REQUIRE(storingCache.store(*oldKey, texture).is_success());
+  REQUIRE(env.directoryContents("cache").size() == 1);
+  const auto oldEntry = env.dir() / env.directoryContents("cache").front();
+
+  REQUIRE(storingCache.store(*newKey, texture).is_success());
+  REQUIRE(env.directoryContents("cache").size() == 2);
+
+  const auto entrySize = std::filesystem::file_size(oldEntry);
+
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::filesystem::last_write_time(oldEntry, now - std::chrono::hours{1});
+
+  SECTION("Entries are kept if the cache does not exceed its maximum size")
+  {
+    const auto cache = TextureCache{cacheDir, 2 * entrySize};
+    CHECK(cache.evictEntries().is_success());
+    CHECK(env.directoryContents("cache").size() == 2);
+  }
+
+  SECTION("Least recently used entries are evicted if the cache exceeds its maximum size")
+  {
+    const auto cache = TextureCache{cacheDir, 2 * entrySize - 1};
+    CHECK(cache.evictEntries().is_success());
+    CHECK(env.directoryContents("cache").size() == 1);
+    CHECK_FALSE(std::filesystem::exists(oldEntry));
+    CHECK(cache.load(*newKey).has_value());
+  }
+
+  SECTION("Loading an entry marks it as recently used")
+  {
+    const auto cache = TextureCache{cacheDir, entrySize};
+    REQUIRE(cache.load(*oldKey).has_value());
+
+    CHECK(cache.evictEntries().is_success());
+    CHECK(env.directoryContents("cache").size() == 1);
+    CHECK(std::filesystem::exists(oldEntry));
+    CHECK_FALSE(cache.load(*newKey).has_value());
+  }
+
+  SECTION("Evicting entries from a missing directory succeeds")
+  {
+    const auto cache = TextureCache{env.dir() / "missing", 0};
+    CHECK(cache.evictEntries().is_success());
+  }
+}
+
+} // namespace tb::io
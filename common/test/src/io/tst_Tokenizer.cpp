@@ -17,12 +17,16 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "io/StandardMapParser.h"
 #include "io/Token.h"
 #include "io/Tokenizer.h"
 
 #include "vm/approx.h"
 
+#include <array>
+#include <optional>
 #include <string>
+#include <tuple>
 
 #include "Catch2.h"
 
@@ -273,4 +277,90 @@ TEST_CASE("TokenizerTest.simpleLanguageBlockWithNegativeDecimalAttribute")
   CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
 }
 
+TEST_CASE("QuakeMapTokenizer")
+{
+  SECTION("readNumberList")
+  {
+    using T = std::tuple<std::string, std::optional<std::array<double, 3>>>;
+
+    // clang-format off
+    const auto
+    [str,                    expected] = GENERATE(values<T>({
+    {"( 1 2 3 )",            std::array{1.0, 2.0, 3.0}},
+    {"\n\t(1\t-2 3.5)",        std::array{1.0, -2.0, 3.5}},
+    {"( -.5 1e2 2.5E-1 )",   std::array{-0.5, 100.0, 0.25}},
+    {"( 1. -0 5 )",          std::array{1.0, 0.0, 5.0}},
+    {"( 1 2 )",              std::nullopt},
+    {"( 1 2 3 4 )",          std::nullopt},
+    {"( 1 2 3",              std::nullopt},
+    {"[ 1 2 3 ]",            std::nullopt},
+    {"( 1 2\n3 )",           std::nullopt},
+    {"( 1 2 3a )",           std::nullopt},
+    {"( 1 2 inf )",          std::nullopt},
+    {"( 1 2 // 3 )",         std::nullopt},
+    }));
+    // clang-format on
+
+    CAPTURE(str);
+
+    auto tokenizer = QuakeMapTokenizer{str};
+    auto values = std::array<double, 3>{};
+    const auto success = tokenizer.readNumberList(
+      QuakeMapToken::OParenthesis, QuakeMapToken::CParenthesis, values);
+    CHECK(success == expected.has_value());
+
+    if (expected)
+    {
+      CHECK(values == *expected);
+      CHECK(tokenizer.nextToken().hasType(QuakeMapToken::Eof));
+    }
+    else
+    {
+      // only leading whitespace was consumed, so the caller can fall back to regular
+      // tokenization
+      CHECK(tokenizer.nextToken().begin() == str.data() + str.find_first_not_of(" \t\n"));
+    }
+  }
+
+  SECTION("readNumberList matches token conversion")
+  {
+    const auto str = std::string{"( 0.1 -12.75 3e-5 ) [ 1 2 3 4 ]"};
+
+    auto fastTokenizer = QuakeMapTokenizer{str};
+    auto fastValues = std::array<double, 3>{};
+    auto fastBracketValues = std::array<double, 4>{};
+    REQUIRE(fastTokenizer.readNumberList(
+      QuakeMapToken::OParenthesis, QuakeMapToken::CParenthesis, fastValues));
+    REQUIRE(fastTokenizer.readNumberList(
+      QuakeMapToken::OBracket, QuakeMapToken::CBracket, fastBracketValues));
+
+    auto tokenizer = QuakeMapTokenizer{str};
+    tokenizer.nextToken(QuakeMapToken::OParenthesis);
+    for (const auto value : fastValues)
+    {
+      CHECK(tokenizer.nextToken(QuakeMapToken::Number).toFloat<double>() == value);
+    }
+    tokenizer.nextToken(QuakeMapToken::CParenthesis);
+    tokenizer.nextToken(QuakeMapToken::OBracket);
+    for (const auto value : fastBracketValues)
+    {
+      CHECK(tokenizer.nextToken(QuakeMapToken::Number).toFloat<double>() == value);
+    }
+    tokenizer.nextToken(QuakeMapToken::CBracket);
+
+    CHECK(fastTokenizer.location() == tokenizer.location());
+  }
+
+  SECTION("readNumber")
+  {
+    auto tokenizer = QuakeMapTokenizer{"tex 1.5\n -2 x"};
+    CHECK(tokenizer.nextToken().data() == "tex");
+    CHECK(tokenizer.readNumber() == 1.5);
+    CHECK(tokenizer.readNumber() == -2.0);
+    CHECK(tokenizer.location() == FileLocation{2, 4});
+    CHECK(tokenizer.readNumber() == std::nullopt);
+    CHECK(tokenizer.nextToken().data() == "x");
+  }
+}
+
 } // namespace tb::io
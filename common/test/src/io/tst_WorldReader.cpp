@@ -42,6 +42,7 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -1958,6 +1959,132 @@ common/caulk
     }
   }
 
+  SECTION("parseInParallelChunks")
+  {
+    const auto data = R"(// Game: Quake
+// Format: Standard
+{
+"classname" "worldspawn"
+"message" "{ not a brace }"
+// a comment with a brace {
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) {grate 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) {grate 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) none 0 0 0 1 1
+}
+}
+; a Heretic2 style comment }
+{
+"classname" "func_door"
+"message" "a\"b}"
+"message" "duplicate"
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) none 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) none 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) none 0 0 0 1 1
+}
+{
+( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) none 0 0 0 1 1
+}
+}
+{
+"classname" "info_player_start"
+"origin" "0 0 0"
+}
+)";
+
+    const auto describeNodes = [](const mdl::Node& rootNode) {
+      auto result = std::vector<std::string>{};
+      const auto describe = [&](const auto& self, const mdl::Node& node) -> void {
+        auto lastLineNumber = node.lineNumber();
+        while (node.containsLine(lastLineNumber + 1))
+        {
+          ++lastLineNumber;
+        }
+
+        result.push_back(fmt::format(
+          "{} {} {} {}",
+          node.name(),
+          node.lineNumber(),
+          lastLineNumber,
+          node.children().size()));
+        if (const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(&node))
+        {
+          for (const auto& face : brushNode->brush().faces())
+          {
+            result.push_back(
+              fmt::format("{} {}", face.attributes().materialName(), face.lineNumber()));
+          }
+        }
+        for (const auto* child : node.children())
+        {
+          self(self, *child);
+        }
+      };
+      describe(describe, rootNode);
+      return result;
+    };
+
+    auto serialStatus = TestParserStatus{};
+    auto serialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    serialReader.setParallelParseChunkSize(std::nullopt);
+    auto serialWorldResult = serialReader.read(worldBounds, serialStatus, taskManager);
+    REQUIRE(serialWorldResult.is_success());
+
+    auto parallelStatus = TestParserStatus{};
+    auto parallelReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    parallelReader.setParallelParseChunkSize(0);
+    auto parallelWorldResult =
+      parallelReader.read(worldBounds, parallelStatus, taskManager);
+    REQUIRE(parallelWorldResult.is_success());
+
+    CHECK(
+      describeNodes(*parallelWorldResult.value())
+      == describeNodes(*serialWorldResult.value()));
+    CHECK(
+      parallelStatus.messages(LogLevel::Warn) == serialStatus.messages(LogLevel::Warn));
+    CHECK(
+      parallelStatus.messages(LogLevel::Error) == serialStatus.messages(LogLevel::Error));
+    CHECK(serialStatus.countStatus(LogLevel::Warn) > 0u);
+    CHECK(serialStatus.countStatus(LogLevel::Error) > 0u);
+  }
+
+  SECTION("parseMalformedMapInParallelChunks")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+}
+{
+"classname" "info_player_start"
+"origin" "0 0 0"
+}
+xyz
+{
+"classname" "info_player_start"
+"origin" "0 0 0"
+}
+)";
+
+    auto serialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    serialReader.setParallelParseChunkSize(std::nullopt);
+    auto serialWorldResult = serialReader.read(worldBounds, status, taskManager);
+    REQUIRE(serialWorldResult.is_error());
+
+    auto parallelReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    parallelReader.setParallelParseChunkSize(0);
+    auto parallelWorldResult = parallelReader.read(worldBounds, status, taskManager);
+    REQUIRE(parallelWorldResult.is_error());
+
+    CHECK(parallelWorldResult.error() == serialWorldResult.error());
+  }
+
   SECTION("parseUnknownFormatEmptyMap")
   {
     const auto data = R"(
@@ -194,6 +194,27 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty(EntityPropertyKeys::Spawnflags, "1");
     CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    SECTION("Updates cached model specification")
+    {
+      entity.addOrUpdateProperty("some_key", "some_value");
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.renameProperty(EntityPropertyKeys::Spawnflags, "other_key");
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.renameProperty("other_key", EntityPropertyKeys::Spawnflags);
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.removeProperty(EntityPropertyKeys::Spawnflags);
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.setProperties({{EntityPropertyKeys::Spawnflags, "2"}});
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+
+      entity.unsetEntityDefinitionAndModel();
+      CHECK(entity.modelSpecification() == ModelSpecification{});
+    }
   }
 
   SECTION("decalSpecification")
@@ -145,4 +145,61 @@ TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
   CHECK(renderer1 != nullptr);
   CHECK(renderer2 != nullptr);
 }
+
+TEST_CASE("EntityModelTest.intersect")
+{
+  auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+  auto& frame = modelData.addFrame("test", vm::bbox3f{0, 8});
+  auto& surface = modelData.addSurface("surface", 1);
+
+  auto size = render::IndexRangeMap::Size{};
+  size.inc(render::PrimType::TriangleFan, 1);
+
+  // a square in the XY plane
+  auto builder = render::IndexRangeMapBuilder<EntityModelVertex::Type>{4, size};
+  builder.addTriangleFan({
+    EntityModelVertex{{0, 0, 0}, {0, 0}},
+    EntityModelVertex{{8, 0, 0}, {1, 0}},
+    EntityModelVertex{{8, 8, 0}, {1, 1}},
+    EntityModelVertex{{0, 8, 0}, {0, 1}},
+  });
+  surface.addMesh(frame, builder.vertices(), builder.indices());
+
+  const auto memoryUsageBeforeIntersect = modelData.memoryUsage();
+  CHECK_FALSE(frame.hasBvh());
+
+  CHECK(
+    frame.intersect(vm::ray3f{vm::vec3f{6, 2, 8}, vm::vec3f{0, 0, -1}})
+    == vm::optional_approx{std::optional{8.0f}});
+  CHECK(frame.hasBvh());
+  CHECK(modelData.memoryUsage() > memoryUsageBeforeIntersect);
+
+  CHECK(
+    frame.intersect(vm::ray3f{vm::vec3f{9, 2, 8}, vm::vec3f{0, 0, -1}}) == std::nullopt);
+
+  SECTION("Replacing a mesh rebuilds the BVH")
+  {
+    // the same square, moved up by 4 units
+    auto replacementBuilder =
+      render::IndexRangeMapBuilder<EntityModelVertex::Type>{4, size};
+    replacementBuilder.addTriangleFan({
+      EntityModelVertex{{0, 0, 4}, {0, 0}},
+      EntityModelVertex{{8, 0, 4}, {1, 0}},
+      EntityModelVertex{{8, 8, 4}, {1, 1}},
+      EntityModelVertex{{0, 8, 4}, {0, 1}},
+    });
+    surface.addMesh(frame, replacementBuilder.vertices(), replacementBuilder.indices());
+    CHECK_FALSE(frame.hasBvh());
+
+    CHECK(
+      frame.intersect(vm::ray3f{vm::vec3f{6, 2, 8}, vm::vec3f{0, 0, -1}})
+      == vm::optional_approx{std::optional{4.0f}});
+
+    // the replaced square is no longer hit
+    CHECK(
+      frame.intersect(vm::ray3f{vm::vec3f{6, 2, 2}, vm::vec3f{0, 0, -1}})
+      == std::nullopt);
+  }
+}
+
 } // namespace tb::mdl
@@ -55,6 +55,18 @@ TEST_CASE("ModelDefinition")
       == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
   }
 
+  SECTION("dependsOnVariable")
+  {
+    auto d1 = makeModelDefinition(R"({{ spawnflags == 1 -> "maps/b_shell0.bsp" }})");
+    CHECK(d1.dependsOnVariable("spawnflags"));
+    CHECK_FALSE(d1.dependsOnVariable("origin"));
+
+    d1.append(makeModelDefinition(R"({ path: "maps/b_shell1.bsp", skin: skin })"));
+    CHECK(d1.dependsOnVariable("spawnflags"));
+    CHECK(d1.dependsOnVariable("skin"));
+    CHECK_FALSE(d1.dependsOnVariable("origin"));
+  }
+
   SECTION("modelSpecification")
   {
     using T =
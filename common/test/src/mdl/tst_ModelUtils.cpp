@@ -255,6 +255,57 @@ TEST_CASE("ModelUtils.collectTouchingNodes")
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectTouchingNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto* groupNode = new GroupNode{Group{"outer"}};
+  auto* groupedEntityNode = new EntityNode{Entity{}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+  auto* farBrushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+  transformNode(
+    *farBrushNode, vm::translation_matrix(vm::vec3d{1024, 1024, 0}), worldBounds);
+
+  groupNode->addChild(groupedEntityNode);
+  worldNode.defaultLayer()->addChildren({groupNode, entityNode, brushNode, farBrushNode});
+
+  auto touchesAll = BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(24.0, "material") | kdl::value()};
+
+  auto touchesBrush = BrushNode{touchesAll.brush()};
+  transformNode(touchesBrush, vm::translation_matrix(vm::vec3d{24, 0, 0}), worldBounds);
+
+  auto touchesNothing = BrushNode{touchesAll.brush()};
+  transformNode(
+    touchesNothing, vm::translation_matrix(vm::vec3d{512, 0, 0}), worldBounds);
+
+  using T = std::vector<BrushNode*>;
+
+  // clang-format off
+  const auto brushes = GENERATE_REF(values<T>({
+    {&touchesAll},
+    {&touchesBrush},
+    {&touchesNothing},
+    {&touchesBrush, &touchesAll},
+    {brushNode},
+  }));
+  // clang-format on
+
+  CHECK_THAT(
+    collectTouchingNodes(worldNode, brushes),
+    Catch::Matchers::Equals(collectTouchingNodes({&worldNode}, brushes)));
+
+  CHECK_THAT(
+    collectTouchingNodes(worldNode, {&touchesAll}),
+    Catch::Matchers::Equals(std::vector<Node*>{groupNode, entityNode, brushNode}));
+}
+
 TEST_CASE("ModelUtils.collectContainedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -333,6 +384,53 @@ TEST_CASE("ModelUtils.collectContainedNodes")
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectContainedNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto* groupNode = new GroupNode{Group{"outer"}};
+  auto* groupedEntityNode = new EntityNode{Entity{}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+  auto* farBrushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+  transformNode(
+    *farBrushNode, vm::translation_matrix(vm::vec3d{1024, 1024, 0}), worldBounds);
+
+  groupNode->addChild(groupedEntityNode);
+  worldNode.defaultLayer()->addChildren({groupNode, entityNode, brushNode, farBrushNode});
+
+  auto containsAll = BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(128.0, "material") | kdl::value()};
+
+  auto containsNothing = BrushNode{containsAll.brush()};
+  transformNode(
+    containsNothing, vm::translation_matrix(vm::vec3d{-64, 0, 0}), worldBounds);
+
+  using T = std::vector<BrushNode*>;
+
+  // clang-format off
+  const auto brushes = GENERATE_REF(values<T>({
+    {&containsAll},
+    {&containsNothing},
+    {&containsNothing, &containsAll},
+    {brushNode},
+  }));
+  // clang-format on
+
+  CHECK_THAT(
+    collectContainedNodes(worldNode, brushes),
+    Catch::Matchers::Equals(collectContainedNodes({&worldNode}, brushes)));
+
+  CHECK_THAT(
+    collectContainedNodes(worldNode, {&containsAll}),
+    Catch::Matchers::Equals(std::vector<Node*>{groupNode, entityNode, brushNode}));
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -19,10 +19,16 @@
 
 #include "Result.h"
 #include "io/DiskIO.h"
+#include "io/Reader.h"
 #include "mdl/Palette.h"
+#include "mdl/TextureBuffer.h"
 
 #include "kdl/result.h"
 
+#include "vm/approx.h"
+
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -214,4 +220,88 @@ TEST_CASE("loadPalette")
   CHECK(loadPalette(*file, filePath) == expectedPalette);
 }
 
+TEST_CASE("Palette.indexedToRgba")
+{
+  auto paletteData = std::vector<unsigned char>{};
+  for (size_t i = 0; i < 256; ++i)
+  {
+    paletteData.push_back(static_cast<unsigned char>(i));
+    paletteData.push_back(static_cast<unsigned char>(255 - i));
+    paletteData.push_back(static_cast<unsigned char>(i / 2));
+  }
+  const auto palette = makePalette(paletteData, PaletteColorFormat::Rgb) | kdl::value();
+
+  // an odd number of pixels to exercise the remainder of the unrolled loop
+  const auto indices = std::vector<unsigned char>{0, 1, 1, 1, 128, 254, 7};
+  auto expectedRgba = std::vector<unsigned char>{};
+  for (const auto index : indices)
+  {
+    expectedRgba.push_back(index);
+    expectedRgba.push_back(static_cast<unsigned char>(255 - index));
+    expectedRgba.push_back(static_cast<unsigned char>(index / 2));
+    expectedRgba.push_back(0xFF);
+  }
+
+  auto reader = io::Reader::from(
+    reinterpret_cast<const char*>(indices.data()),
+    reinterpret_cast<const char*>(indices.data() + indices.size()));
+  auto rgbaImage = TextureBuffer{4 * indices.size()};
+  auto averageColor = Color{};
+
+  SECTION("opaque")
+  {
+    CHECK_FALSE(palette.indexedToRgba(
+      reader, indices.size(), rgbaImage, PaletteTransparency::Opaque, averageColor));
+    CHECK(
+      std::vector<unsigned char>(rgbaImage.data(), rgbaImage.data() + rgbaImage.size())
+      == expectedRgba);
+    CHECK(reader.eof());
+
+    CHECK(
+      averageColor
+      == vm::approx{vm::vec4f{
+        392.0f / (255.0f * 7.0f),
+        (7.0f * 255.0f - 392.0f) / (255.0f * 7.0f),
+        194.0f / (255.0f * 7.0f),
+        1.0f}});
+  }
+
+  SECTION("index 255 transparent")
+  {
+    SECTION("without index 255")
+    {
+      CHECK_FALSE(palette.indexedToRgba(
+        reader,
+        indices.size(),
+        rgbaImage,
+        PaletteTransparency::Index255Transparent,
+        averageColor));
+    }
+
+    SECTION("with index 255")
+    {
+      const auto transparentIndices = std::vector<unsigned char>{0, 255, 3, 4, 5, 6, 7};
+      auto transparentReader = io::Reader::from(
+        reinterpret_cast<const char*>(transparentIndices.data()),
+        reinterpret_cast<const char*>(
+          transparentIndices.data() + transparentIndices.size()));
+
+      CHECK(palette.indexedToRgba(
+        transparentReader,
+        transparentIndices.size(),
+        rgbaImage,
+        PaletteTransparency::Index255Transparent,
+        averageColor));
+      CHECK(rgbaImage.data()[4 * 1 + 3] == 0);
+    }
+  }
+
+  SECTION("not enough data")
+  {
+    auto largeImage = TextureBuffer{4 * (indices.size() + 1)};
+    CHECK_THROWS(palette.indexedToRgba(
+      reader, indices.size() + 1, largeImage, PaletteTransparency::Opaque, averageColor));
+  }
+}
+
 } // namespace tb::mdl
@@ -113,6 +113,50 @@ TEST_CASE("Resource")
     CHECK(mockTaskRunner.tasks.empty());
   }
 
+  SECTION("Construction with on demand loading")
+  {
+    auto resource = ResourceT{
+      [&]() { return Result<MockResource>{MockResource{}}; }, ResourceLoadMode::OnDemand};
+
+    CHECK(resource.get() == nullptr);
+    CHECK(resource.isDeferred());
+    CHECK(!resource.needsProcessing());
+
+    SECTION("process")
+    {
+      CHECK(!resource.process(taskRunner, processContext));
+      CHECK(resource.isDeferred());
+      CHECK(mockTaskRunner.tasks.empty());
+    }
+
+    SECTION("requestLoading")
+    {
+      resource.requestLoading();
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource.state()));
+      CHECK(resource.needsProcessing());
+
+      CHECK(resource.process(taskRunner, processContext));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource.state()));
+      CHECK(mockTaskRunner.tasks.size() == 1);
+
+      resource.requestLoading();
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource.state()));
+    }
+
+    SECTION("drop")
+    {
+      resource.drop();
+      CHECK(resource.isDropped());
+    }
+
+    SECTION("loadSync")
+    {
+      resource.loadSync();
+      CHECK(resource.get() != nullptr);
+      CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource.state()));
+    }
+  }
+
   SECTION("Resource loading fails")
   {
     auto resource =
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/TextureBuffer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::vector<unsigned char> toVector(const TextureBuffer& buffer)
+{
+  return {buffer.data(), buffer.data() + buffer.size()};
+}
+
+} // namespace
+
+TEST_CASE("generateMips")
+{
+  SECTION("square texture")
+  {
+    // clang-format off
+    const auto mip0 = std::vector<unsigned char>{
+      0,   0,   0,   0,     4,   8,  12,  16,    10,  10,  10,  10,    20,  20,  20,  20,
+      8,  16,  24,  32,    12,  24,  36,  48,    30,  30,  30,  30,    40,  40,  40,  40,
+      255, 255, 255, 255,  255, 255, 255, 255,   1,   1,   1,   1,     1,   1,   1,   1,
+      255, 255, 255, 255,  254, 254, 254, 254,   1,   1,   1,   1,     2,   2,   2,   2,
+    };
+    // clang-format on
+
+    auto buffers = TextureBufferList{};
+    setMipBufferSize(buffers, 3, 4, 4, GL_RGBA);
+    std::copy(mip0.begin(), mip0.end(), buffers[0].data());
+
+    generateMips(buffers, 4, 4, GL_RGBA);
+
+    CHECK(
+      toVector(buffers[1])
+      == std::vector<unsigned char>{
+        6, 12, 18, 24, 25, 25, 25, 25, 255, 255, 255, 255, 1, 1, 1, 1});
+    CHECK(toVector(buffers[2]) == std::vector<unsigned char>{72, 73, 75, 76});
+  }
+
+  SECTION("non square texture")
+  {
+    const auto mip0 = std::vector<unsigned char>{
+      0, 0, 0, 0, 2, 2, 2, 2, 4, 4, 4, 4, 8, 8, 8, 8};
+
+    auto buffers = TextureBufferList{};
+    setMipBufferSize(buffers, 3, 4, 1, GL_RGBA);
+    std::copy(mip0.begin(), mip0.end(), buffers[0].data());
+
+    generateMips(buffers, 4, 1, GL_RGBA);
+
+    CHECK(toVector(buffers[1]) == std::vector<unsigned char>{1, 1, 1, 1, 6, 6, 6, 6});
+    CHECK(toVector(buffers[2]) == std::vector<unsigned char>{4, 4, 4, 4});
+  }
+}
+
+} // namespace tb::mdl
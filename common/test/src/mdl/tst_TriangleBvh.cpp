@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/TriangleBvh.h"
+
+#include "vm/approx.h"
+#include "vm/intersection.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::optional<float> intersectAll(
+  const std::vector<vm::vec3f>& triangles, const vm::ray3f& ray)
+{
+  auto closestDistance = std::optional<float>{};
+  for (size_t i = 0; i < triangles.size(); i += 3)
+  {
+    closestDistance = vm::safe_min(
+      closestDistance,
+      vm::intersect_ray_triangle(ray, triangles[i], triangles[i + 1], triangles[i + 2]));
+  }
+  return closestDistance;
+}
+
+} // namespace
+
+TEST_CASE("TriangleBvh")
+{
+  SECTION("empty")
+  {
+    const auto bvh = TriangleBvh{std::vector<vm::vec3f>{}};
+    CHECK(bvh.triangleCount() == 0);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{1, 0, 0}}) == std::nullopt);
+  }
+
+  SECTION("single triangle")
+  {
+    const auto bvh = TriangleBvh{std::vector<vm::vec3f>{
+      vm::vec3f{0, -1, -1},
+      vm::vec3f{0, 1, -1},
+      vm::vec3f{0, 0, 1},
+    }};
+    CHECK(bvh.triangleCount() == 1);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{-4, 0, 0}, vm::vec3f{1, 0, 0}})
+      == vm::optional_approx{std::optional{4.0f}});
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{-4, 0, 2}, vm::vec3f{1, 0, 0}}) == std::nullopt);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{-4, 0, 0}, vm::vec3f{-1, 0, 0}}) == std::nullopt);
+  }
+
+  SECTION("random triangles")
+  {
+    auto rng = std::mt19937{42};
+    auto position = std::uniform_real_distribution<float>{-256.0f, 256.0f};
+    auto offset = std::uniform_real_distribution<float>{-16.0f, 16.0f};
+
+    auto triangles = std::vector<vm::vec3f>{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto p = vm::vec3f{position(rng), position(rng), position(rng)};
+      triangles.push_back(p);
+      triangles.push_back(p + vm::vec3f{offset(rng), offset(rng), offset(rng)});
+      triangles.push_back(p + vm::vec3f{offset(rng), offset(rng), offset(rng)});
+    }
+
+    const auto bvh = TriangleBvh{triangles};
+    CHECK(bvh.triangleCount() == 1000);
+    CHECK(bvh.memoryUsage() > 0);
+
+    auto hits = size_t(0);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto origin = vm::vec3f{position(rng), position(rng), position(rng)} * 2.0f;
+      const auto target =
+        (triangles[i * 3] + triangles[i * 3 + 1] + triangles[i * 3 + 2]) / 3.0f;
+      const auto ray = vm::ray3f{origin, vm::normalize(target - origin)};
+
+      const auto expected = intersectAll(triangles, ray);
+      CHECK(bvh.intersect(ray) == vm::optional_approx{expected});
+      hits += expected ? 1 : 0;
+    }
+
+    // every ray aims at the center of a triangle, but some of them may be occluded
+    CHECK(hits == 1000);
+  }
+
+  SECTION("axis aligned rays")
+  {
+    // a grid of quads in the XY plane, hit by rays parallel to the Z axis which lie in
+    // the slab planes of some of the BVH nodes
+    auto triangles = std::vector<vm::vec3f>{};
+    for (int x = 0; x < 16; ++x)
+    {
+      for (int y = 0; y < 16; ++y)
+      {
+        const auto p = vm::vec3f{float(x), float(y), 0.0f};
+        triangles.push_back(p);
+        triangles.push_back(p + vm::vec3f{1, 0, 0});
+        triangles.push_back(p + vm::vec3f{1, 1, 0});
+        triangles.push_back(p);
+        triangles.push_back(p + vm::vec3f{1, 1, 0});
+        triangles.push_back(p + vm::vec3f{0, 1, 0});
+      }
+    }
+
+    const auto bvh = TriangleBvh{triangles};
+    for (int x = 0; x <= 16; ++x)
+    {
+      const auto ray = vm::ray3f{vm::vec3f{float(x), 8.0f, 10.0f}, vm::vec3f{0, 0, -1}};
+      CHECK(bvh.intersect(ray) == vm::optional_approx{intersectAll(triangles, ray)});
+    }
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,225 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EmptyGroupValidator.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Issue.h"
+#include "mdl/InvalidUVScaleValidator.h"
+#include "mdl/IssueType.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Material.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
+#include "mdl/ValidationEngine.h"
+#include "mdl/Validator.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr auto Unlimited = std::chrono::milliseconds{1000 * 1000};
+
+const auto Type = freeIssueType();
+
+class EntityValidator : public Validator
+{
+public:
+  EntityValidator()
+    : Validator{Type, "Entity", false}
+  {
+  }
+
+private:
+  void doValidate(
+    EntityNode& entityNode, std::vector<std::unique_ptr<Issue>>& issues) const override
+  {
+    issues.push_back(std::make_unique<Issue>(Type, entityNode, "entity"));
+  }
+};
+
+std::vector<const Node*> issueNodes(const std::vector<const Issue*>& issues)
+{
+  auto result = std::vector<const Node*>{};
+  for (const auto* issue : issues)
+  {
+    result.push_back(&issue->node());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("ValidationEngine")
+{
+  auto taskManager = kdl::task_manager{};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  worldNode.registerValidator(std::make_unique<EmptyGroupValidator>());
+  worldNode.registerValidator(std::make_unique<EntityValidator>());
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  worldNode.defaultLayer()->addChildren({groupNode, entityNode});
+
+  auto& validationEngine = worldNode.validationEngine();
+  const auto validators = worldNode.registeredValidators();
+
+  SECTION("Validates all nodes of a new world")
+  {
+    CHECK(validationEngine.invalidNodeCount() == 4u);
+
+    const auto delta = validationEngine.validate(validators, taskManager, Unlimited);
+    CHECK_THAT(
+      issueNodes(delta.addedIssues),
+      Catch::UnorderedEquals(std::vector<const Node*>{groupNode, entityNode}));
+    CHECK(delta.removedIssues.empty());
+    CHECK(validationEngine.invalidNodeCount() == 0u);
+    CHECK(groupNode->issuesValid());
+    CHECK(entityNode->issuesValid());
+  }
+
+  SECTION("Validates nothing if the time budget is exhausted")
+  {
+    const auto delta =
+      validationEngine.validate(validators, taskManager, std::chrono::milliseconds{0});
+    CHECK(delta.empty());
+    CHECK(validationEngine.invalidNodeCount() == 4u);
+  }
+
+  SECTION("Reports the replaced issues of revalidated nodes as removed")
+  {
+    const auto initialDelta =
+      validationEngine.validate(validators, taskManager, Unlimited);
+    REQUIRE(initialDelta.addedIssues.size() == 2u);
+
+    const auto oldEntityIssues = entityNode->cachedIssues();
+    REQUIRE(oldEntityIssues.size() == 1u);
+
+    entityNode->invalidateIssues();
+    CHECK(validationEngine.invalidNodeCount() == 1u);
+
+    const auto delta = validationEngine.validate(validators, taskManager, Unlimited);
+    CHECK(issueNodes(delta.addedIssues) == std::vector<const Node*>{entityNode});
+    CHECK(delta.removedIssues == oldEntityIssues);
+  }
+
+  SECTION("Reports the issues of removed nodes as removed")
+  {
+    validationEngine.validate(validators, taskManager, Unlimited);
+
+    const auto groupIssues = groupNode->cachedIssues();
+    REQUIRE(groupIssues.size() == 1u);
+
+    worldNode.defaultLayer()->removeChild(groupNode);
+
+    const auto delta = validationEngine.validate(validators, taskManager, Unlimited);
+    CHECK(delta.addedIssues.empty());
+    CHECK(delta.removedIssues == groupIssues);
+
+    SECTION("Revalidates nodes that are added again")
+    {
+      worldNode.defaultLayer()->addChild(groupNode);
+
+      const auto readdDelta =
+        validationEngine.validate(validators, taskManager, Unlimited);
+      CHECK_THAT(
+        issueNodes(readdDelta.addedIssues),
+        Catch::VectorContains(static_cast<const Node*>(groupNode)));
+    }
+
+    SECTION("Forgets removed nodes")
+    {
+      groupNode->invalidateIssues();
+      CHECK(validationEngine.invalidNodeCount() == 0u);
+      delete groupNode;
+    }
+  }
+
+  SECTION("Forgets invalid nodes that are removed")
+  {
+    worldNode.defaultLayer()->removeChild(entityNode);
+    CHECK(validationEngine.invalidNodeCount() == 3u);
+    delete entityNode;
+  }
+}
+
+TEST_CASE("ValidationEngine.parallelMaterialAssignment")
+{
+  constexpr auto BrushCount = size_t(2000);
+
+  auto taskManager = kdl::task_manager{8};
+  auto material = Material{"material", createTextureResource(Texture{64, 64})};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  worldNode.registerValidator(std::make_unique<InvalidUVScaleValidator>());
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    brushNodes.push_back(
+      new BrushNode{builder.createCube(32.0, "material") | kdl::value()});
+  }
+  worldNode.defaultLayer()->addChildren(brushNodes.begin(), brushNodes.end());
+
+  auto& validationEngine = worldNode.validationEngine();
+  const auto validators = worldNode.registeredValidators();
+  validationEngine.validate(validators, taskManager, Unlimited);
+  REQUIRE(validationEngine.invalidNodeCount() == 0u);
+
+  // mirrors how MapDocument assigns materials to brushes
+  taskManager.parallel_for(brushNodes, [&](auto* brushNode) {
+    for (size_t i = 0; i < brushNode->brush().faceCount(); ++i)
+    {
+      brushNode->setFaceMaterial(i, &material);
+    }
+  });
+
+  CHECK(validationEngine.invalidNodeCount() == BrushCount);
+
+  validationEngine.validate(validators, taskManager, Unlimited);
+  CHECK(validationEngine.invalidNodeCount() == 0u);
+  CHECK(std::ranges::all_of(
+    brushNodes, [](const auto* brushNode) { return brushNode->issuesValid(); }));
+}
+
+} // namespace tb::mdl
@@ -21,19 +21,25 @@
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
+#include "mdl/HitAdapter.h"
+#include "mdl/HitFilter.h"
 #include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/MapFormat.h"
 #include "mdl/PatchNode.h"
+#include "mdl/PickResult.h"
 #include "mdl/WorldNode.h"
 #include "octree.h"
 
 #include "kdl/result.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -316,6 +322,139 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.pickClosest")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  // a row of cubes along the X axis
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < 64; ++i)
+  {
+    const auto min = vm::vec3d{double(i) * 128.0, 0.0, 0.0};
+    const auto bounds = vm::bbox3d{min, min + vm::vec3d{64.0, 64.0, 64.0}};
+    auto* brushNode =
+      new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()};
+    worldNode.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto editorContext = EditorContext{};
+  const auto ray = vm::ray3d{{-64.0, 32.0, 32.0}, {1.0, 0.0, 0.0}};
+
+  auto allHits = PickResult::byDistance();
+  worldNode.pick(editorContext, ray, allHits);
+  REQUIRE(allHits.size() == brushNodes.size());
+
+  SECTION("Stops once the first matching hit is found")
+  {
+    const auto filter = HitFilters::type(BrushNode::BrushHitType);
+
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(editorContext, ray, filter, pickResult);
+
+    CHECK(pickResult.size() < allHits.size());
+    CHECK(hitToNode(pickResult.first(filter)) == brushNodes.front());
+  }
+
+  SECTION("Finds matching hits behind other hits")
+  {
+    brushNodes[10]->select();
+    const auto filter =
+      HitFilters::type(BrushNode::BrushHitType) && HitFilters::selected();
+
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(editorContext, ray, filter, pickResult);
+
+    CHECK(pickResult.size() < allHits.size());
+    CHECK(hitToNode(pickResult.first(filter)) == brushNodes[10]);
+  }
+
+  SECTION("Picks all nodes if no hit matches")
+  {
+    const auto filter = HitFilters::none();
+
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(editorContext, ray, filter, pickResult);
+
+    CHECK(pickResult.size() == allHits.size());
+  }
+}
+
+TEST_CASE("WorldNodeTest.linkIdIndex")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+
+  setLinkId(*groupNode, "group");
+  setLinkId(*entityNode, "entity");
+  setLinkId(*brushNode, "brush");
+  groupNode->addChildren({entityNode, brushNode});
+
+  REQUIRE(worldNode.nodesWithLinkId("group").empty());
+
+  SECTION("Adding a subtree adds all objects to the index")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+
+    CHECK(worldNode.nodesWithLinkId("group") == std::vector<Node*>{groupNode});
+    CHECK(worldNode.nodesWithLinkId("entity") == std::vector<Node*>{entityNode});
+    CHECK(worldNode.nodesWithLinkId("brush") == std::vector<Node*>{brushNode});
+  }
+
+  SECTION("Adding a linked node adds it to the index")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+
+    auto* linkedGroupNode = groupNode->cloneRecursively(worldBounds);
+    worldNode.defaultLayer()->addChild(linkedGroupNode);
+
+    CHECK(
+      worldNode.nodesWithLinkId("group")
+      == std::vector<Node*>{groupNode, linkedGroupNode});
+    CHECK(worldNode.nodesWithLinkId("brush").size() == 2u);
+  }
+
+  SECTION("Removing a subtree removes all objects from the index")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    worldNode.defaultLayer()->removeChild(groupNode);
+
+    CHECK(worldNode.nodesWithLinkId("group").empty());
+    CHECK(worldNode.nodesWithLinkId("entity").empty());
+    CHECK(worldNode.nodesWithLinkId("brush").empty());
+
+    delete groupNode;
+  }
+
+  SECTION("Changing the link ID of an object updates the index")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    setLinkId(*brushNode, "other");
+
+    CHECK(worldNode.nodesWithLinkId("brush").empty());
+    CHECK(worldNode.nodesWithLinkId("other") == std::vector<Node*>{brushNode});
+  }
+
+  SECTION("Adding an object uses its current link ID")
+  {
+    setLinkId(*brushNode, "other");
+    worldNode.defaultLayer()->addChild(groupNode);
+
+    CHECK(worldNode.nodesWithLinkId("brush").empty());
+    CHECK(worldNode.nodesWithLinkId("other") == std::vector<Node*>{brushNode});
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
@@ -276,6 +276,124 @@ TEST_CASE("AllocationTrackerTest.expandWithUsedSpaceAtEnd")
   }
 }
 
+TEST_CASE("AllocationTrackerTest.usedSize")
+{
+  AllocationTracker t(500);
+  CHECK(t.usedSize() == 0u);
+  CHECK(t.lastUsedBlock() == nullptr);
+
+  AllocationTracker::Block* a = t.allocate(100);
+  AllocationTracker::Block* b = t.allocate(50);
+  CHECK(t.usedSize() == 150u);
+  CHECK(t.lastUsedBlock() == b);
+
+  t.free(b);
+  CHECK(t.usedSize() == 100u);
+  CHECK(t.lastUsedBlock() == a);
+
+  t.free(a);
+  CHECK(t.usedSize() == 0u);
+  CHECK(t.lastUsedBlock() == nullptr);
+}
+
+TEST_CASE("AllocationTrackerTest.relocateIntoFreeBlock")
+{
+  AllocationTracker t(500);
+
+  AllocationTracker::Block* a = t.allocate(100);
+  AllocationTracker::Block* b = t.allocate(100);
+  AllocationTracker::Block* c = t.allocate(60);
+  AllocationTracker::Block* d = t.allocate(50);
+  t.free(a);
+  t.free(c);
+
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{100, 100}, {260, 50}}));
+
+  // d fits into both free blocks, the smaller one is used
+  AllocationTracker::Block* newD = t.relocate(d);
+  REQUIRE(newD != nullptr);
+  CHECK(newD->pos == 200u);
+  CHECK(newD->size == 50u);
+  CHECK(t.usedSize() == 150u);
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{100, 100}, {200, 50}}));
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}, {250, 250}}));
+
+  // b can only slide to the start
+  AllocationTracker::Block* newB = t.relocate(b);
+  REQUIRE(newB != nullptr);
+  CHECK(newB->pos == 0u);
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}, {200, 50}}));
+
+  // d slides into the space left of it
+  newD = t.relocate(newD);
+  REQUIRE(newD != nullptr);
+  CHECK(newD->pos == 100u);
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}, {100, 50}}));
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{150, 350}}));
+  CHECK(t.lastUsedBlock() == newD);
+}
+
+TEST_CASE("AllocationTrackerTest.relocateImpossible")
+{
+  AllocationTracker t(500);
+
+  AllocationTracker::Block* a = t.allocate(100);
+  AllocationTracker::Block* b = t.allocate(100);
+  AllocationTracker::Block* c = t.allocate(100);
+  t.free(b);
+
+  // the first block cannot move
+  CHECK(t.relocate(a) == nullptr);
+  CHECK(a->pos == 0u);
+
+  // there is no free space directly left of c, and the free space after it doesn't
+  // count
+  AllocationTracker::Block* d = t.allocate(150);
+  REQUIRE(d != nullptr);
+  CHECK(d->pos == 300u);
+  CHECK(t.relocate(d) == nullptr);
+  CHECK(
+    t.usedBlocks()
+    == (std::vector<AllocationTracker::Range>{{0, 100}, {200, 100}, {300, 150}}));
+
+  // c slides into b's space
+  AllocationTracker::Block* newC = t.relocate(c);
+  REQUIRE(newC != nullptr);
+  CHECK(newC->pos == 100u);
+}
+
+TEST_CASE("AllocationTrackerTest.shrink")
+{
+  AllocationTracker t(500);
+
+  AllocationTracker::Block* a = t.allocate(100);
+  AllocationTracker::Block* b = t.allocate(100);
+
+  CHECK_THROWS(t.shrink(500));
+  CHECK_THROWS(t.shrink(150));
+
+  t.free(b);
+  t.shrink(150);
+  CHECK(t.capacity() == 150u);
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{100, 50}}));
+  CHECK(t.largestPossibleAllocation() == 50u);
+
+  t.shrink(100);
+  CHECK(t.capacity() == 100u);
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{}));
+  CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}}));
+  CHECK(t.allocate(1) == nullptr);
+
+  t.free(a);
+  t.shrink(0);
+  CHECK(t.capacity() == 0u);
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{}));
+  CHECK_FALSE(t.hasAllocations());
+
+  t.expand(10);
+  CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{0, 10}}));
+}
+
 static constexpr size_t NumBrushes = 64'000;
 
 // between 12 and 140, inclusive.
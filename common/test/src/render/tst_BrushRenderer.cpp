@@ -0,0 +1,373 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CircleShape.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Material.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
+#include "render/BrushRenderer.h"
+#include "render/BrushRendererArrays.h"
+#include "render/GLVertex.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+using Primitive = std::vector<vm::vec3f>;
+
+/**
+ * Returns the primitives stored in the given index array, with each index replaced by the
+ * position of the vertex it refers to. Degenerate primitives, such as the ones left
+ * behind by removed brushes, are omitted. The result is sorted because compaction
+ * changes the order of the brushes in the arrays.
+ */
+std::vector<Primitive> resolvePrimitives(
+  const BrushVertexArray& vertexArray,
+  const BrushIndexArray* indexArray,
+  const size_t verticesPerPrimitive)
+{
+  auto result = std::vector<Primitive>{};
+  if (indexArray)
+  {
+    const auto* indices = indexArray->getPointerToReadElementsFrom(0);
+    for (size_t i = 0; i + verticesPerPrimitive <= indexArray->size();
+         i += verticesPerPrimitive)
+    {
+      const auto* first = indices + i;
+      const auto* last = first + verticesPerPrimitive;
+      if (std::all_of(first, last, [&](const auto index) { return index == *first; }))
+      {
+        continue;
+      }
+
+      auto primitive = Primitive{};
+      for (const auto* index = first; index != last; ++index)
+      {
+        REQUIRE(*index < vertexArray.size());
+        primitive.push_back(
+          getVertexComponent<0>(*vertexArray.getPointerToReadVerticesFrom(*index)));
+      }
+      result.push_back(std::move(primitive));
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+struct RenderedPrimitives
+{
+  std::vector<Primitive> edges;
+  std::vector<std::vector<Primitive>> opaqueFaces;
+  std::vector<std::vector<Primitive>> transparentFaces;
+
+  bool operator==(const RenderedPrimitives&) const = default;
+};
+
+RenderedPrimitives resolvePrimitives(
+  const BrushRenderer& renderer, const std::vector<mdl::Material>& materials)
+{
+  const auto& vertexArray = renderer.vertexArray();
+
+  auto result = RenderedPrimitives{
+    resolvePrimitives(vertexArray, &renderer.edgeIndexArray(), 2), {}, {}};
+  for (const auto& material : materials)
+  {
+    result.opaqueFaces.push_back(
+      resolvePrimitives(vertexArray, renderer.opaqueFaceIndexArray(&material), 3));
+    result.transparentFaces.push_back(
+      resolvePrimitives(vertexArray, renderer.transparentFaceIndexArray(&material), 3));
+  }
+  return result;
+}
+
+std::vector<mdl::Material> makeMaterials()
+{
+  auto result = std::vector<mdl::Material>{};
+  for (const auto* name : {"material1", "material2"})
+  {
+    result.emplace_back(name, createTextureResource(mdl::Texture{64, 64}));
+  }
+  return result;
+}
+
+std::vector<std::unique_ptr<mdl::BrushNode>> makeCubes(
+  const size_t count, std::vector<mdl::Material>& materials)
+{
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, vm::bbox3d{8192.0}};
+
+  auto result = std::vector<std::unique_ptr<mdl::BrushNode>>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3d{double(i % 64), double(i / 64), 0.0} * 32.0;
+    auto brush =
+      builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{16, 16, 16}}, "")
+      | kdl::value();
+
+    auto materialIndex = i;
+    for (auto& face : brush.faces())
+    {
+      face.setMaterial(&materials[materialIndex++ % materials.size()]);
+    }
+    result.push_back(std::make_unique<mdl::BrushNode>(std::move(brush)));
+  }
+  return result;
+}
+
+std::vector<GLuint> indices(const BrushIndexArray* indexArray)
+{
+  if (indexArray)
+  {
+    const auto* first = indexArray->getPointerToReadElementsFrom(0);
+    return {first, first + indexArray->size()};
+  }
+  return {};
+}
+
+/**
+ * Checks that both renderers store identical vertices and indices at identical
+ * positions.
+ */
+void checkArraysEqual(
+  const BrushRenderer& lhs,
+  const BrushRenderer& rhs,
+  const std::vector<mdl::Material>& materials)
+{
+  const auto& lhsVertices = lhs.vertexArray();
+  const auto& rhsVertices = rhs.vertexArray();
+  REQUIRE(lhsVertices.size() == rhsVertices.size());
+  CHECK(
+    std::memcmp(
+      lhsVertices.getPointerToReadVerticesFrom(0),
+      rhsVertices.getPointerToReadVerticesFrom(0),
+      lhsVertices.size() * sizeof(*lhsVertices.getPointerToReadVerticesFrom(0)))
+    == 0);
+
+  CHECK(indices(&lhs.edgeIndexArray()) == indices(&rhs.edgeIndexArray()));
+  for (const auto& material : materials)
+  {
+    CHECK(
+      indices(lhs.opaqueFaceIndexArray(&material))
+      == indices(rhs.opaqueFaceIndexArray(&material)));
+    CHECK(
+      indices(lhs.transparentFaceIndexArray(&material))
+      == indices(rhs.transparentFaceIndexArray(&material)));
+  }
+}
+
+bool compactToCompletion(BrushRenderer& renderer)
+{
+  for (size_t i = 0; i < 1'000'000; ++i)
+  {
+    if (renderer.compact(std::chrono::microseconds{10}))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+TEST_CASE("BrushRenderer.validate")
+{
+  auto materials = makeMaterials();
+  const auto brushes = makeCubes(1000, materials);
+
+  auto serialTaskManager = kdl::task_manager{1};
+  auto parallelTaskManager = kdl::task_manager{8};
+
+  auto serialRenderer = BrushRenderer{serialTaskManager};
+  auto parallelRenderer = BrushRenderer{parallelTaskManager};
+
+  for (auto* renderer : {&serialRenderer, &parallelRenderer})
+  {
+    for (const auto& brush : brushes)
+    {
+      renderer->addBrush(brush.get());
+    }
+    renderer->validate();
+  }
+
+  REQUIRE(serialRenderer.vertexArray().size() > 0);
+  checkArraysEqual(serialRenderer, parallelRenderer, materials);
+
+  SECTION("Revalidating changed brushes")
+  {
+    for (auto* renderer : {&serialRenderer, &parallelRenderer})
+    {
+      for (size_t i = 0; i < brushes.size(); i += 3)
+      {
+        renderer->invalidateBrush(brushes[i].get());
+      }
+      for (size_t i = 1; i < brushes.size(); i += 3)
+      {
+        renderer->removeBrush(brushes[i].get());
+      }
+      renderer->validate();
+    }
+
+    checkArraysEqual(serialRenderer, parallelRenderer, materials);
+  }
+}
+
+TEST_CASE("BrushRenderer.compact")
+{
+  auto materials = makeMaterials();
+  const auto brushes = makeCubes(3000, materials);
+
+  auto renderer = BrushRenderer{};
+  for (const auto& brush : brushes)
+  {
+    renderer.addBrush(brush.get());
+  }
+  renderer.validate();
+
+  // keep every fifth brush
+  auto keep = std::vector<bool>(brushes.size());
+  for (size_t i = 0; i < brushes.size(); ++i)
+  {
+    keep[i] = i % 5 == 0;
+    if (!keep[i])
+    {
+      renderer.removeBrush(brushes[i].get());
+    }
+  }
+
+  REQUIRE(renderer.needsCompaction());
+
+  SECTION("Compaction does not change the rendered primitives")
+  {
+    const auto expected = resolvePrimitives(renderer, materials);
+
+    REQUIRE(compactToCompletion(renderer));
+    CHECK_FALSE(renderer.needsCompaction());
+    CHECK(resolvePrimitives(renderer, materials) == expected);
+  }
+
+  SECTION("Brushes can be added and removed while compacting")
+  {
+    for (size_t i = 0; i < 10; ++i)
+    {
+      renderer.compact(std::chrono::microseconds{10});
+    }
+
+    // readd some removed brushes and remove some remaining brushes
+    for (size_t i = 0; i < brushes.size(); i += 7)
+    {
+      if (keep[i])
+      {
+        renderer.removeBrush(brushes[i].get());
+      }
+      else
+      {
+        renderer.addBrush(brushes[i].get());
+      }
+      keep[i] = !keep[i];
+    }
+    renderer.validate();
+
+    REQUIRE(compactToCompletion(renderer));
+
+    auto uncompactedRenderer = BrushRenderer{};
+    for (size_t i = 0; i < brushes.size(); ++i)
+    {
+      if (keep[i])
+      {
+        uncompactedRenderer.addBrush(brushes[i].get());
+      }
+    }
+    uncompactedRenderer.validate();
+
+    CHECK(
+      resolvePrimitives(renderer, materials)
+      == resolvePrimitives(uncompactedRenderer, materials));
+  }
+}
+
+TEST_CASE("BrushRenderer.compactStalled")
+{
+  auto materials = makeMaterials();
+
+  // groups of five cubes, followed by a cylinder that is larger than four cubes
+  auto brushes = makeCubes(2000, materials);
+
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, vm::bbox3d{8192.0}};
+  brushes.push_back(std::make_unique<mdl::BrushNode>(
+    builder.createCylinder(
+      vm::bbox3d{{-64, -64, -64}, {0, 0, 0}},
+      mdl::EdgeAlignedCircle{32},
+      vm::axis::z,
+      "")
+    | kdl::value()));
+
+  // add the brushes one by one so that they are stored in order
+  auto renderer = BrushRenderer{};
+  for (const auto& brush : brushes)
+  {
+    renderer.addBrush(brush.get());
+    renderer.validate();
+  }
+
+  // remove the first four cubes of each group, so that none of the gaps can hold the
+  // cylinder
+  for (size_t i = 0; i < brushes.size() - 1; ++i)
+  {
+    if (i % 5 != 4)
+    {
+      renderer.removeBrush(brushes[i].get());
+    }
+  }
+
+  REQUIRE(renderer.needsCompaction());
+
+  const auto expected = resolvePrimitives(renderer, materials);
+
+  CHECK(renderer.compact(std::chrono::seconds{10}));
+  CHECK(renderer.needsCompaction());
+  CHECK(resolvePrimitives(renderer, materials) == expected);
+
+  // another pass would not make any progress, so compaction is not restarted
+  CHECK(renderer.compact(std::chrono::nanoseconds{0}));
+
+  // compaction is restarted once the arrays change
+  renderer.removeBrush(brushes[4].get());
+  CHECK_FALSE(renderer.compact(std::chrono::nanoseconds{0}));
+}
+
+} // namespace tb::render
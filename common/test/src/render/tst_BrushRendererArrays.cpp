@@ -0,0 +1,242 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/BrushRendererArrays.h"
+#include "render/GLVertex.h"
+
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+using Range = DirtyRangeTracker::Range;
+
+TEST_CASE("DirtyRangeTracker")
+{
+  SECTION("constructor")
+  {
+    const auto t = DirtyRangeTracker{100};
+    CHECK(t.capacity() == 100u);
+    CHECK(t.clean());
+    CHECK(t.uploadRanges(0) == std::vector<Range>{});
+  }
+
+  SECTION("markDirty")
+  {
+    auto t = DirtyRangeTracker{100};
+
+    CHECK_THROWS(t.markDirty(90, 11));
+
+    t.markDirty(10, 0);
+    CHECK(t.clean());
+
+    t.markDirty(10, 5);
+    CHECK_FALSE(t.clean());
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 5}});
+
+    t.markDirty(80, 10);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 5}, {80, 10}});
+
+    // adjacent ranges are merged
+    t.markDirty(15, 5);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 10}, {80, 10}});
+
+    // overlapping ranges are merged
+    t.markDirty(75, 10);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 10}, {75, 15}});
+
+    // contained ranges don't change anything
+    t.markDirty(12, 2);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 10}, {75, 15}});
+
+    t.markDirty(40, 5);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 10}, {40, 5}, {75, 15}});
+
+    // a range covering several ranges replaces them
+    t.markDirty(5, 75);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{5, 85}});
+  }
+
+  SECTION("expand")
+  {
+    auto t = DirtyRangeTracker{100};
+    t.markDirty(10, 5);
+
+    CHECK_THROWS(t.expand(100));
+
+    t.expand(150);
+    CHECK(t.capacity() == 150u);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 5}, {100, 50}});
+  }
+
+  SECTION("shrink")
+  {
+    auto t = DirtyRangeTracker{100};
+    t.markDirty(10, 5);
+    t.markDirty(40, 20);
+    t.markDirty(80, 10);
+
+    CHECK_THROWS(t.shrink(100));
+
+    t.shrink(50);
+    CHECK(t.capacity() == 50u);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 5}, {40, 10}});
+
+    t.shrink(40);
+    CHECK(t.uploadRanges(0) == std::vector<Range>{{10, 5}});
+  }
+
+  SECTION("uploadRanges")
+  {
+    auto t = DirtyRangeTracker{1000};
+    t.markDirty(0, 10);
+    t.markDirty(20, 10);
+    t.markDirty(50, 10);
+    t.markDirty(500, 10);
+
+    CHECK(
+      t.uploadRanges(0) == std::vector<Range>{{0, 10}, {20, 10}, {50, 10}, {500, 10}});
+    CHECK(
+      t.uploadRanges(9) == std::vector<Range>{{0, 10}, {20, 10}, {50, 10}, {500, 10}});
+    CHECK(t.uploadRanges(10) == std::vector<Range>{{0, 30}, {50, 10}, {500, 10}});
+    CHECK(t.uploadRanges(20) == std::vector<Range>{{0, 60}, {500, 10}});
+    CHECK(t.uploadRanges(440) == std::vector<Range>{{0, 510}});
+  }
+}
+
+TEST_CASE("BrushRendererArrays.moveWithKey")
+{
+  using Vertex = GLVertexTypes::P3NT2::Vertex;
+
+  constexpr auto NumBrushes = size_t(8);
+  constexpr auto NumVerticesPerBrush = size_t(4);
+  constexpr auto NumIndicesPerBrush = size_t(6);
+
+  auto vertexArray = BrushVertexArray{};
+  auto indexArray = BrushIndexArray{};
+
+  auto vertexKeys = std::vector<AllocationTracker::Block*>{};
+  auto indexKeys = std::vector<AllocationTracker::Block*>{};
+
+  // each brush is a quad made of two triangles, and the first coordinate of the position
+  // of each of its vertices is the brush index
+  for (size_t brush = 0; brush < NumBrushes; ++brush)
+  {
+    auto [vertexKey, vertices] =
+      vertexArray.getPointerToInsertVerticesAt(NumVerticesPerBrush);
+    for (size_t i = 0; i < NumVerticesPerBrush; ++i)
+    {
+      vertices[i] = Vertex{
+        vm::vec3f{float(brush), float(i), 0.0f}, vm::vec3f{0, 0, 1}, vm::vec2f{0, 0}};
+    }
+
+    const auto base = GLuint(vertexKey->pos);
+    auto [indexKey, indices] =
+      indexArray.getPointerToInsertElementsAt(NumIndicesPerBrush);
+    for (const auto index : {0u, 1u, 2u, 0u, 2u, 3u})
+    {
+      *indices++ = base + index;
+    }
+
+    vertexKeys.push_back(vertexKey);
+    indexKeys.push_back(indexKey);
+  }
+
+  // fragment the arrays by removing every other brush
+  for (size_t brush = 0; brush < NumBrushes; brush += 2)
+  {
+    vertexArray.deleteVerticesWithKey(vertexKeys[brush]);
+    indexArray.zeroElementsWithKey(indexKeys[brush]);
+    vertexKeys[brush] = nullptr;
+    indexKeys[brush] = nullptr;
+  }
+
+  const auto ownerOf = [](const auto& keys, const auto* key) {
+    const auto it = std::find(keys.begin(), keys.end(), key);
+    REQUIRE(it != keys.end());
+    return size_t(std::distance(keys.begin(), it));
+  };
+
+  // move the vertices of the last brush until it cannot be moved anymore
+  for (auto* key = vertexArray.lastKey(); key != nullptr; key = vertexArray.lastKey())
+  {
+    const auto brush = ownerOf(vertexKeys, key);
+    const auto oldBase = GLuint(key->pos);
+
+    auto* newKey = vertexArray.moveVerticesWithKey(key);
+    if (newKey == nullptr)
+    {
+      break;
+    }
+
+    CHECK(newKey->pos < oldBase);
+    vertexKeys[brush] = newKey;
+    indexArray.rebaseElementsWithKey(indexKeys[brush], oldBase, GLuint(newKey->pos));
+  }
+
+  // move the indices of the last brush until it cannot be moved anymore
+  for (auto* key = indexArray.lastKey(); key != nullptr; key = indexArray.lastKey())
+  {
+    const auto brush = ownerOf(indexKeys, key);
+    const auto oldPos = key->pos;
+
+    auto* newKey = indexArray.moveElementsWithKey(key);
+    if (newKey == nullptr)
+    {
+      break;
+    }
+
+    CHECK(newKey->pos < oldPos);
+    indexKeys[brush] = newKey;
+  }
+
+  vertexArray.shrinkToFit();
+  indexArray.shrinkToFit();
+
+  CHECK(vertexArray.size() == NumBrushes / 2 * NumVerticesPerBrush);
+  CHECK(indexArray.size() == NumBrushes / 2 * NumIndicesPerBrush);
+
+  // every index block still refers to the vertices of its own brush
+  for (size_t brush = 1; brush < NumBrushes; brush += 2)
+  {
+    CAPTURE(brush);
+
+    const auto* indices = indexArray.getPointerToReadElementsFrom(indexKeys[brush]->pos);
+    auto positions = std::vector<vm::vec3f>{};
+    for (size_t i = 0; i < NumIndicesPerBrush; ++i)
+    {
+      const auto* vertex = vertexArray.getPointerToReadVerticesFrom(indices[i]);
+      positions.push_back(getVertexComponent<0>(*vertex));
+    }
+
+    const auto b = float(brush);
+    CHECK(
+      positions
+      == std::vector<vm::vec3f>{
+        {b, 0, 0}, {b, 1, 0}, {b, 2, 0}, {b, 0, 0}, {b, 2, 0}, {b, 3, 0}});
+  }
+}
+
+} // namespace tb::render
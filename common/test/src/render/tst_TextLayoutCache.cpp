@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/AttrString.h"
+#include "render/FontDescriptor.h"
+#include "render/FontGlyph.h"
+#include "render/FontTexture.h"
+#include "render/TextLayoutCache.h"
+#include "render/TextureFont.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+constexpr auto FirstChar = static_cast<unsigned char>(' ');
+constexpr auto CharCount = static_cast<unsigned char>('~' - ' ' + 1);
+
+std::unique_ptr<TextureFont> makeFont()
+{
+  auto glyphs = std::vector<FontGlyph>{};
+  for (size_t i = 0; i < CharCount; ++i)
+  {
+    glyphs.emplace_back(i % 10 * 8, i / 10 * 8, 6, 8, 5 + i % 3);
+  }
+
+  return std::make_unique<TextureFont>(
+    std::make_unique<FontTexture>(CharCount, 8, 0),
+    glyphs,
+    7,
+    1,
+    10,
+    FirstChar,
+    CharCount);
+}
+
+AttrString makeString()
+{
+  auto string = AttrString{};
+  string.appendLeftJustified("info_player_start");
+  string.appendRightJustified("angle 90");
+  string.appendCentered("x");
+  return string;
+}
+
+} // namespace
+
+TEST_CASE("TextLayoutCache")
+{
+  const auto font = makeFont();
+  const auto fontDescriptor = FontDescriptor{"font.ttf", 12};
+
+  SECTION("layout")
+  {
+    auto cache = TextLayoutCache{};
+
+    const auto string = makeString();
+    const auto layout = cache.layout(fontDescriptor, *font, string);
+    CHECK(layout->vertices == font->quads(string, true));
+    CHECK(layout->size == font->measure(string));
+
+    CHECK(cache.hits() == 0);
+    CHECK(cache.misses() == 1);
+    CHECK(cache.size() == 1);
+
+    CHECK(cache.layout(fontDescriptor, *font, makeString()) == layout);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 1);
+    CHECK(cache.size() == 1);
+  }
+
+  SECTION("Layouts are cached per font descriptor")
+  {
+    auto cache = TextLayoutCache{};
+
+    const auto string = AttrString{"light"};
+    const auto layout = cache.layout(fontDescriptor, *font, string);
+    CHECK(cache.layout(FontDescriptor{"font.ttf", 13}, *font, string) != layout);
+    CHECK(cache.layout(FontDescriptor{"other.ttf", 12}, *font, string) != layout);
+    CHECK(cache.hits() == 0);
+    CHECK(cache.misses() == 3);
+    CHECK(cache.size() == 3);
+  }
+
+  SECTION("Evicts least recently used layouts")
+  {
+    auto cache = TextLayoutCache{2};
+
+    const auto a = cache.layout(fontDescriptor, *font, AttrString{"a"});
+    const auto b = cache.layout(fontDescriptor, *font, AttrString{"b"});
+    CHECK(cache.layout(fontDescriptor, *font, AttrString{"a"}) == a);
+
+    // evicts b
+    const auto c = cache.layout(fontDescriptor, *font, AttrString{"c"});
+    CHECK(cache.size() == 2);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 3);
+
+    CHECK(cache.layout(fontDescriptor, *font, AttrString{"a"}) == a);
+    CHECK(cache.layout(fontDescriptor, *font, AttrString{"c"}) == c);
+    CHECK(cache.hits() == 3);
+
+    // evicted layouts remain valid
+    CHECK(b->vertices == font->quads(AttrString{"b"}, true));
+    CHECK(cache.layout(fontDescriptor, *font, AttrString{"b"}) != b);
+    CHECK(cache.misses() == 4);
+    CHECK(cache.size() == 2);
+  }
+
+  SECTION("clear")
+  {
+    auto cache = TextLayoutCache{};
+
+    cache.layout(fontDescriptor, *font, AttrString{"a"});
+    cache.clear();
+    CHECK(cache.size() == 0);
+
+    cache.layout(fontDescriptor, *font, AttrString{"a"});
+    CHECK(cache.misses() == 2);
+  }
+}
+
+} // namespace tb::render
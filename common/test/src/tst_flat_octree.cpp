@@ -0,0 +1,365 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "flat_octree.h"
+#include "octree.h"
+
+#include "kdl/task_manager.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb
+{
+namespace
+{
+
+using Item = std::pair<vm::bbox3d, int>;
+
+std::vector<Item> makeRandomItems(const size_t count, const unsigned int seed)
+{
+  auto rng = std::mt19937{seed};
+  auto position = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+  auto extent = std::uniform_real_distribution<double>{1.0, 256.0};
+
+  auto result = std::vector<Item>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto max = min + vm::vec3d{extent(rng), extent(rng), extent(rng)};
+    result.emplace_back(vm::bbox3d{min, max}, int(i));
+  }
+  return result;
+}
+
+template <typename Tree>
+void checkQueries(const Tree& actual, const octree<double, int>& expected)
+{
+  const auto rays = std::vector<vm::ray3d>{
+    {{0, 0, 0}, {1, 0, 0}},
+    {{-5000, 100, 100}, {1, 0, 0}},
+    {{100, -5000, -100}, vm::normalize(vm::vec3d{0.1, 1, 0.2})},
+    {{1000, 1000, 5000}, vm::normalize(vm::vec3d{-0.3, -0.2, -1})},
+  };
+  for (const auto& ray : rays)
+  {
+    CHECK_THAT(
+      actual.find_intersectors(ray),
+      Catch::UnorderedEquals(expected.find_intersectors(ray)));
+  }
+
+  const auto boxes = std::vector<vm::bbox3d>{
+    {{-16, -16, -16}, {16, 16, 16}},
+    {{512, 512, 512}, {1024, 1024, 1024}},
+    {{-4000, -100, 0}, {-3000, 100, 2000}},
+    {{-8192, -8192, -8192}, {8192, 8192, 8192}},
+  };
+  for (const auto& box : boxes)
+  {
+    CHECK_THAT(
+      actual.find_intersectors(box),
+      Catch::UnorderedEquals(expected.find_intersectors(box)));
+  }
+
+  const auto points = std::vector<vm::vec3d>{
+    {0, 0, 0},
+    {1000, -1000, 500},
+    {-3500, 2000, 64},
+    {4096, 4096, 4096},
+  };
+  for (const auto& point : points)
+  {
+    CHECK_THAT(
+      actual.find_containers(point),
+      Catch::UnorderedEquals(expected.find_containers(point)));
+  }
+}
+
+} // namespace
+
+TEST_CASE("flat_octree.insert")
+{
+  auto tree = flat_octree<double, int>{32.0};
+  CHECK(tree.empty());
+
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+  tree.insert({{-2, 0, 0}, {5, 3, 6}}, 2);
+  tree.insert({{-120, 130, -48}, {-116, 140, -40}}, 3);
+
+  CHECK_FALSE(tree.empty());
+  CHECK(tree.contains(1));
+  CHECK(tree.contains(2));
+  CHECK(tree.contains(3));
+  CHECK_FALSE(tree.contains(4));
+
+  CHECK_THROWS_AS(tree.insert({{0, 0, 0}, {2, 1, 1}}, 1), NodeTreeException);
+  CHECK_THROWS_AS(
+    tree.insert({{0, 0, 0}, {std::numeric_limits<double>::quiet_NaN(), 1, 1}}, 4),
+    NodeTreeException);
+}
+
+TEST_CASE("flat_octree.remove")
+{
+  auto tree = flat_octree<double, int>{32.0};
+  tree.insert({{2, 2, 2}, {3, 3, 3}}, 1);
+  tree.insert({{3, 3, 3}, {4, 4, 4}}, 2);
+  tree.insert({{31, 31, 31}, {34, 34, 34}}, 3);
+
+  CHECK_FALSE(tree.remove(4));
+
+  CHECK(tree.remove(1));
+  CHECK_FALSE(tree.contains(1));
+  CHECK(tree.find_containers({3, 3, 3}) == std::vector<int>{3, 2});
+
+  CHECK(tree.remove(3));
+  CHECK(tree.find_containers({3, 3, 3}) == std::vector<int>{2});
+
+  CHECK(tree.remove(2));
+  CHECK(tree.empty());
+}
+
+TEST_CASE("flat_octree.update")
+{
+  auto tree = flat_octree<double, int>{32.0};
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+  tree.update({{-64, -64, -64}, {-32, -32, -32}}, 1);
+  CHECK(tree.find_containers({48, 48, 48}).empty());
+  CHECK(tree.find_containers({-48, -48, -48}) == std::vector<int>{1});
+
+  CHECK_THROWS_AS(tree.update({{0, 0, 0}, {1, 1, 1}}, 2), NodeTreeException);
+}
+
+TEST_CASE("flat_octree.build")
+{
+  auto tree = flat_octree<double, int>{32.0};
+
+  SECTION("empty list")
+  {
+    tree.insert({{0, 0, 0}, {1, 1, 1}}, 1);
+    tree.build({});
+    CHECK(tree.empty());
+    CHECK_FALSE(tree.contains(1));
+  }
+
+  SECTION("replaces existing data")
+  {
+    tree.insert({{0, 0, 0}, {1, 1, 1}}, 1);
+    tree.build({{{{32, 32, 32}, {64, 64, 64}}, 2}});
+    CHECK_FALSE(tree.contains(1));
+    CHECK(tree.contains(2));
+    CHECK(tree.find_containers({48, 48, 48}) == std::vector<int>{2});
+  }
+
+  SECTION("duplicate data")
+  {
+    CHECK_THROWS_AS(
+      tree.build({
+        {{{0, 0, 0}, {1, 1, 1}}, 1},
+        {{{2, 2, 2}, {3, 3, 3}}, 1},
+      }),
+      NodeTreeException);
+    CHECK(tree.empty());
+  }
+
+  SECTION("invalid bounds")
+  {
+    CHECK_THROWS_AS(
+      tree.build({
+        {{{0, 0, 0}, {1, 1, 1}}, 1},
+        {{{0, 0, 0}, {std::numeric_limits<double>::quiet_NaN(), 1, 1}}, 2},
+      }),
+      NodeTreeException);
+    CHECK(tree.empty());
+  }
+
+  SECTION("items can be removed and inserted after building")
+  {
+    tree.build({
+      {{{2, 2, 2}, {3, 3, 3}}, 1},
+      {{{3, 3, 3}, {4, 4, 4}}, 2},
+      {{{31, 31, 31}, {34, 34, 34}}, 3},
+    });
+
+    CHECK(tree.remove(2));
+    tree.insert({{33, 33, 33}, {34, 34, 34}}, 4);
+
+    CHECK_THAT(
+      tree.find_containers({3, 3, 3}), Catch::UnorderedEquals(std::vector<int>{1, 3}));
+    CHECK_THAT(
+      tree.find_containers({33, 33, 33}), Catch::UnorderedEquals(std::vector<int>{3, 4}));
+  }
+}
+
+TEST_CASE("flat_octree.matches_octree")
+{
+  const auto items = makeRandomItems(2000, 1234);
+
+  auto expected = octree<double, int>{64.0};
+  for (const auto& [bounds, data] : items)
+  {
+    expected.insert(bounds, data);
+  }
+
+  auto actual = flat_octree<double, int>{64.0};
+
+  SECTION("inserting items one by one")
+  {
+    for (const auto& [bounds, data] : items)
+    {
+      actual.insert(bounds, data);
+    }
+    checkQueries(actual, expected);
+  }
+
+  SECTION("building from a list of items")
+  {
+    actual.build(items);
+    checkQueries(actual, expected);
+  }
+
+  SECTION("building from a list of items in parallel")
+  {
+    auto taskManager = kdl::task_manager{};
+    actual.build(items, taskManager);
+    checkQueries(actual, expected);
+  }
+
+  SECTION("removing and updating items")
+  {
+    actual.build(items);
+
+    const auto moved = makeRandomItems(500, 5678);
+    for (size_t i = 0; i < items.size(); i += 2)
+    {
+      REQUIRE(actual.remove(items[i].second));
+      REQUIRE(expected.remove(items[i].second));
+    }
+    for (const auto& [bounds, data] : moved)
+    {
+      if (data % 2 == 1)
+      {
+        actual.update(bounds, data);
+        expected.update(bounds, data);
+      }
+    }
+    checkQueries(actual, expected);
+
+    for (const auto& [bounds, data] : items)
+    {
+      if (data % 2 == 0)
+      {
+        actual.insert(bounds, data);
+        expected.insert(bounds, data);
+      }
+    }
+    checkQueries(actual, expected);
+  }
+}
+
+TEST_CASE("flat_octree.visit_intersectors_in_order")
+{
+  const auto items = makeRandomItems(2000, 1234);
+
+  auto tree = flat_octree<double, int>{64.0};
+  tree.build(items);
+
+  const auto distanceTo = [&](const vm::ray3d& ray, const int data) {
+    const auto& bounds = items[size_t(data)].first;
+    return bounds.contains(ray.origin) ? std::optional{0.0}
+                                       : vm::intersect_ray_bbox(ray, bounds);
+  };
+
+  const auto rays = std::vector<vm::ray3d>{
+    {{0, 0, 0}, {1, 0, 0}},
+    {{-5000, 100, 100}, {1, 0, 0}},
+    {{100, -5000, -100}, vm::normalize(vm::vec3d{0.1, 1, 0.2})},
+    {{1000, 1000, 5000}, vm::normalize(vm::vec3d{-0.3, -0.2, -1})},
+  };
+
+  for (const auto& ray : rays)
+  {
+    const auto intersectors = tree.find_intersectors(ray);
+
+    auto expectedDistance = std::numeric_limits<double>::max();
+    for (const auto data : intersectors)
+    {
+      if (const auto distance = distanceTo(ray, data))
+      {
+        expectedDistance = std::min(expectedDistance, *distance);
+      }
+    }
+
+    // without a distance limit, every intersector is visited
+    auto visited = std::vector<int>{};
+    tree.visit_intersectors_in_order(ray, [&](const int data) {
+      visited.push_back(data);
+      return std::numeric_limits<double>::max();
+    });
+    CHECK_THAT(visited, Catch::UnorderedEquals(intersectors));
+
+    // limiting the distance to the closest intersection found so far
+    auto numVisited = size_t(0);
+    auto closestDistance = std::numeric_limits<double>::max();
+    tree.visit_intersectors_in_order(ray, [&](const int data) {
+      ++numVisited;
+      if (const auto distance = distanceTo(ray, data))
+      {
+        closestDistance = std::min(closestDistance, *distance);
+      }
+      return closestDistance;
+    });
+    CHECK(closestDistance == expectedDistance);
+    CHECK(numVisited <= intersectors.size());
+  }
+}
+
+TEST_CASE("flat_octree.visit_intersectors_in_order.stops_early")
+{
+  // a row of small boxes along the X axis
+  auto tree = flat_octree<double, int>{8.0};
+  for (int i = 0; i < 256; ++i)
+  {
+    const auto min = vm::vec3d{double(i * 16), 0, 0};
+    tree.insert({min, min + vm::vec3d{8, 8, 8}}, i);
+  }
+
+  const auto ray = vm::ray3d{{-16, 4, 4}, {1, 0, 0}};
+
+  auto numVisited = size_t(0);
+  auto closest = std::numeric_limits<int>::max();
+  tree.visit_intersectors_in_order(ray, [&](const int data) {
+    ++numVisited;
+    closest = std::min(closest, data);
+    // the ray hits box i at distance i * 16 + 16
+    return double(closest * 16 + 16);
+  });
+
+  CHECK(closest == 0);
+  CHECK(numVisited < 16);
+}
+
+} // namespace tb
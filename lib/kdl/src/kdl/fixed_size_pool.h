@@ -0,0 +1,202 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A slab allocator for blocks of a fixed size and alignment.
+ *
+ * Blocks are carved out of slabs that hold many blocks each. Freed blocks are kept in a
+ * thread local free list, so allocating and freeing blocks usually requires neither a
+ * call to the global allocator nor any synchronization. Whenever a thread local free list
+ * runs empty or grows too large, a batch of blocks is exchanged with a shared free list.
+ *
+ * Blocks may be freed on a different thread than the one that allocated them. The slabs
+ * are never returned to the global allocator, so the memory used by a pool is bounded by
+ * the maximum number of blocks that were in use at the same time.
+ *
+ * Since the pool is shared by all types with the same block size and alignment, a type
+ * can use it by providing class specific allocation functions:
+ *
+ * static void* operator new(std::size_t) { return pool::allocate(); }
+ * static void operator delete(void* p) { pool::deallocate(p); }
+ *
+ * @tparam block_size the size of the blocks
+ * @tparam block_alignment the alignment of the blocks
+ */
+template <std::size_t block_size, std::size_t block_alignment>
+class fixed_size_pool
+{
+private:
+  union block
+  {
+    block* next;
+    alignas(block_alignment) std::byte storage[block_size];
+  };
+
+  static constexpr std::size_t batch_size = 64;
+  static constexpr std::size_t batches_per_slab = 4;
+
+  struct batch
+  {
+    block* first;
+    std::size_t size;
+  };
+
+  struct shared_state
+  {
+    std::mutex mutex;
+    std::vector<batch> batches;
+    std::vector<std::unique_ptr<block[]>> slabs;
+
+    batch take_batch()
+    {
+      auto lock = std::lock_guard{mutex};
+      if (batches.empty())
+      {
+        allocate_slab();
+      }
+
+      const auto result = batches.back();
+      batches.pop_back();
+      return result;
+    }
+
+    void return_batch(const batch b)
+    {
+      auto lock = std::lock_guard{mutex};
+      batches.push_back(b);
+    }
+
+  private:
+    void allocate_slab()
+    {
+      auto& slab = slabs.emplace_back(
+        std::make_unique_for_overwrite<block[]>(batch_size * batches_per_slab));
+
+      for (std::size_t i = 0; i < batches_per_slab; ++i)
+      {
+        auto* first = slab.get() + i * batch_size;
+        for (std::size_t j = 0; j + 1 < batch_size; ++j)
+        {
+          first[j].next = first + j + 1;
+        }
+        first[batch_size - 1].next = nullptr;
+        batches.push_back(batch{first, batch_size});
+      }
+    }
+  };
+
+  static shared_state& shared()
+  {
+    // intentionally leaked so that blocks can be freed during static destruction
+    static auto* instance = new shared_state{};
+    return *instance;
+  }
+
+  struct local_state
+  {
+    block* first = nullptr;
+    std::size_t size = 0;
+
+    ~local_state()
+    {
+      if (first)
+      {
+        shared().return_batch(batch{first, size});
+      }
+    }
+
+    void* allocate()
+    {
+      if (!first)
+      {
+        const auto b = shared().take_batch();
+        first = b.first;
+        size = b.size;
+      }
+
+      auto* result = first;
+      first = first->next;
+      --size;
+      return result;
+    }
+
+    void deallocate(void* p)
+    {
+      auto* b = static_cast<block*>(p);
+      b->next = first;
+      first = b;
+      ++size;
+
+      if (size == 2 * batch_size)
+      {
+        // return the first half of the free list to the shared state
+        auto* last = first;
+        for (std::size_t i = 1; i < batch_size; ++i)
+        {
+          last = last->next;
+        }
+
+        auto* remaining = last->next;
+        last->next = nullptr;
+        shared().return_batch(batch{first, batch_size});
+
+        first = remaining;
+        size -= batch_size;
+      }
+    }
+  };
+
+  static local_state& local()
+  {
+    thread_local auto instance = local_state{};
+    return instance;
+  }
+
+public:
+  /**
+   * Returns a block of uninitialized memory of the given size and alignment.
+   */
+  static void* allocate() { return local().allocate(); }
+
+  /**
+   * Returns the given block to this pool. The block must have been allocated by this
+   * pool.
+   */
+  static void deallocate(void* p)
+  {
+    if (p)
+    {
+      local().deallocate(p);
+    }
+  }
+};
+
+} // namespace kdl
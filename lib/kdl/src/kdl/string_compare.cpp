@@ -117,6 +117,18 @@ bool string_equal::operator()(
     std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), char_equal());
 }
 
+std::size_t string_hash::operator()(const std::string_view str) const
+{
+  // FNV-1a
+  auto result = std::size_t(14695981039346656037ull);
+  for (const auto c : str)
+  {
+    result ^= std::size_t(std::tolower(static_cast<unsigned char>(c)));
+    result *= std::size_t(1099511628211ull);
+  }
+  return result;
+}
+
 std::size_t str_mismatch(const std::string_view s1, const std::string_view s2)
 {
   return kdl::str_mismatch(s1, s2, char_equal());
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 
 namespace kdl
@@ -150,9 +151,23 @@ struct string_less
 
 struct string_equal
 {
+  using is_transparent = void;
+
   bool operator()(std::string_view lhs, std::string_view rhs) const;
 };
 
+/**
+ * A hash function that is consistent with string_equal, that is, strings which only
+ * differ in case have the same hash value. Together with string_equal, it can be used
+ * for unordered containers with case insensitive keys.
+ */
+struct string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const;
+};
+
 /**
  * Returns the first position at which the given strings differ. Characters are compared
  * without case sensitivity.
@@ -22,10 +22,16 @@
 
 #include "kdl/range_to_vector.h"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <ranges>
 #include <thread>
@@ -33,6 +39,147 @@
 
 namespace kdl
 {
+namespace
+{
+
+struct chunk
+{
+  std::size_t begin;
+  std::size_t end;
+
+  std::size_t size() const { return end - begin; }
+};
+
+struct participant_queue
+{
+  std::mutex mutex;
+  std::deque<chunk> chunks;
+};
+
+/**
+ * The state of one call to run_chunked. It is shared between the calling thread and the
+ * helper tasks because a helper task may only start running after the call has returned.
+ */
+struct chunked_job
+{
+  const std::function<void(std::size_t, std::size_t)>* run_range;
+  std::size_t grain_size;
+  std::vector<participant_queue> queues;
+  std::atomic<std::size_t> next_participant = 1;
+  std::atomic<std::size_t> remaining;
+
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  chunked_job(
+    const std::function<void(std::size_t, std::size_t)>& run_range_,
+    const std::size_t count,
+    const std::size_t participant_count)
+    : run_range{&run_range_}
+    // aim for several chunks per participant so that there is enough work to steal
+    , grain_size{std::max(count / (participant_count * 8), std::size_t(1))}
+    , queues(participant_count)
+    , remaining{count}
+  {
+    // hand every participant an equal share of the range up front
+    const auto share = count / participant_count;
+    for (std::size_t i = 0; i < participant_count; ++i)
+    {
+      const auto begin = i * share;
+      const auto end = i + 1 < participant_count ? begin + share : count;
+      if (begin < end)
+      {
+        queues[i].chunks.push_back(chunk{begin, end});
+      }
+    }
+  }
+
+  std::optional<chunk> pop(const std::size_t participant)
+  {
+    auto& queue = queues[participant];
+    auto lock = std::lock_guard{queue.mutex};
+    if (queue.chunks.empty())
+    {
+      return std::nullopt;
+    }
+
+    const auto result = queue.chunks.back();
+    queue.chunks.pop_back();
+    return result;
+  }
+
+  void push(const std::size_t participant, const chunk c)
+  {
+    auto& queue = queues[participant];
+    auto lock = std::lock_guard{queue.mutex};
+    queue.chunks.push_back(c);
+  }
+
+  std::optional<chunk> steal(const std::size_t participant)
+  {
+    for (std::size_t i = 1; i < queues.size(); ++i)
+    {
+      auto& queue = queues[(participant + i) % queues.size()];
+      auto lock = std::lock_guard{queue.mutex};
+      if (!queue.chunks.empty())
+      {
+        // the oldest chunk is the largest one
+        const auto result = queue.chunks.front();
+        queue.chunks.pop_front();
+        return result;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void run(chunk c, const std::size_t participant)
+  {
+    // split the chunk lazily, leaving the upper halves for ourselves or for thieves
+    while (c.size() > grain_size)
+    {
+      const auto mid = c.begin + c.size() / 2;
+      push(participant, chunk{mid, c.end});
+      c.end = mid;
+    }
+
+    try
+    {
+      (*run_range)(c.begin, c.end);
+    }
+    catch (...)
+    {
+      auto lock = std::lock_guard{exception_mutex};
+      if (!exception)
+      {
+        exception = std::current_exception();
+      }
+    }
+
+    remaining.fetch_sub(c.size(), std::memory_order_acq_rel);
+  }
+
+  void participate(const std::size_t participant)
+  {
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+      if (auto c = pop(participant))
+      {
+        run(*c, participant);
+      }
+      else if (auto stolen = steal(participant))
+      {
+        run(*stolen, participant);
+      }
+      else
+      {
+        // the remaining chunks are being processed by other participants
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+} // namespace
 
 std::function<void()> task_manager::make_worker_func()
 {
@@ -60,6 +207,43 @@ std::function<void()> task_manager::make_worker_func()
   };
 }
 
+void task_manager::run_chunked(
+  const std::size_t count, const std::function<void(std::size_t, std::size_t)>& run_range)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  if (m_workers.empty() || count == 1)
+  {
+    run_range(0, count);
+    return;
+  }
+
+  const auto participant_count = std::min(m_workers.size() + 1, count);
+  auto job = std::make_shared<chunked_job>(run_range, count, participant_count);
+
+  {
+    auto lock = std::lock_guard{m_pending_tasks_mutex};
+    for (std::size_t i = 1; i < participant_count; ++i)
+    {
+      m_pending_tasks.push([job]() {
+        const auto participant = job->next_participant.fetch_add(1);
+        job->participate(participant);
+      });
+    }
+  }
+  m_pending_tasks_cv.notify_all();
+
+  job->participate(0);
+
+  if (job->exception)
+  {
+    std::rethrow_exception(job->exception);
+  }
+}
+
 task_manager::task_manager(const std::size_t max_concurrent_tasks)
 {
   for (size_t i = 0; i < max_concurrent_tasks; ++i)
@@ -23,12 +23,15 @@
 #include "kdl/range_to_vector.h"
 
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <ranges>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace kdl
@@ -48,6 +51,39 @@ private:
 
   std::function<void()> make_worker_func();
 
+  /**
+   * Calls the given function for disjoint subranges [begin, end) that together cover
+   * [0, count). The subranges are distributed over per-participant deques and the
+   * participants steal work from each other once their own deque is empty. The calling
+   * thread participates, too, so this function can safely be called from within a task.
+   *
+   * Returns once the function has been called for every subrange. If the function throws,
+   * the first exception is rethrown after all subranges have been processed.
+   */
+  void run_chunked(
+    std::size_t count, const std::function<void(std::size_t, std::size_t)>& run_range);
+
+  template <std::ranges::random_access_range range>
+  static std::size_t elements_size(range& elements)
+  {
+    return static_cast<std::size_t>(std::ranges::distance(elements));
+  }
+
+  template <std::ranges::random_access_range range, typename function>
+  void parallel_for_index(range& elements, function f)
+  {
+    using difference_type = std::ranges::range_difference_t<range>;
+
+    auto first = std::ranges::begin(elements);
+    run_chunked(
+      elements_size(elements), [&](const std::size_t begin, const std::size_t end) {
+        for (auto i = begin; i < end; ++i)
+        {
+          f(i, first[static_cast<difference_type>(i)]);
+        }
+      });
+  }
+
 public:
   explicit task_manager(
     std::size_t max_concurrent_tasks = std::thread::hardware_concurrency());
@@ -94,6 +130,63 @@ public:
     return futures | std::views::transform([](auto& future) { return future.get(); })
            | to_vector;
   }
+
+  /**
+   * Calls the given function for every element of the given range in parallel and waits
+   * until all calls have returned.
+   *
+   * Unlike run_tasks_and_wait, no task, promise or future is created per element.
+   * Instead, the range is split into adaptively sized chunks which are processed by the
+   * workers and the calling thread.
+   */
+  template <std::ranges::random_access_range range, typename function>
+  void parallel_for(range&& elements, function f)
+  {
+    parallel_for_index(
+      elements, [&](const std::size_t, auto&& element) {
+        f(std::forward<decltype(element)>(element));
+      });
+  }
+
+  /**
+   * Applies the given function to every element of the given range in parallel and
+   * returns a vector containing the results in the order of the elements.
+   *
+   * The results are written directly into a preallocated vector, see parallel_for.
+   */
+  template <std::ranges::random_access_range range, typename function>
+  auto parallel_transform(range&& elements, function f)
+  {
+    using result_type = std::remove_cvref_t<
+      std::invoke_result_t<function&, std::ranges::range_reference_t<range>>>;
+
+    // std::vector<bool> cannot be written to concurrently
+    if constexpr (
+      std::is_default_constructible_v<result_type> && !std::is_same_v<result_type, bool>)
+    {
+      auto results = std::vector<result_type>(elements_size(elements));
+      parallel_for_index(elements, [&](const std::size_t i, auto&& element) {
+        results[i] = f(std::forward<decltype(element)>(element));
+      });
+      return results;
+    }
+    else
+    {
+      auto optional_results =
+        std::vector<std::optional<result_type>>(elements_size(elements));
+      parallel_for_index(elements, [&](const std::size_t i, auto&& element) {
+        optional_results[i].emplace(f(std::forward<decltype(element)>(element)));
+      });
+
+      auto results = std::vector<result_type>{};
+      results.reserve(optional_results.size());
+      for (auto& result : optional_results)
+      {
+        results.push_back(std::move(*result));
+      }
+      return results;
+    }
+  }
 };
 
 } // namespace kdl
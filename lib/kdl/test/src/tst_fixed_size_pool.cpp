@@ -0,0 +1,118 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/fixed_size_pool.h"
+
+#include <cstdint>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+namespace
+{
+struct pooled
+{
+  using pool = fixed_size_pool<24, 8>;
+
+  std::uint64_t a;
+  std::uint64_t b;
+  std::uint64_t c;
+
+  static void* operator new(std::size_t) { return pool::allocate(); }
+  static void operator delete(void* p) { pool::deallocate(p); }
+};
+} // namespace
+
+TEST_CASE("fixed_size_pool")
+{
+  using pool = fixed_size_pool<16, 16>;
+
+  SECTION("allocates distinct aligned blocks")
+  {
+    auto blocks = std::vector<void*>{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    CHECK(std::unordered_set<void*>{blocks.begin(), blocks.end()}.size() == blocks.size());
+    for (auto* block : blocks)
+    {
+      CHECK(reinterpret_cast<std::uintptr_t>(block) % 16 == 0);
+    }
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("reuses freed blocks")
+  {
+    auto* block = pool::allocate();
+    pool::deallocate(block);
+    CHECK(pool::allocate() == block);
+    pool::deallocate(block);
+  }
+
+  SECTION("blocks can be freed on another thread")
+  {
+    auto blocks = std::vector<void*>{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    auto thread = std::thread{[&]() {
+      for (auto* block : blocks)
+      {
+        pool::deallocate(block);
+      }
+    }};
+    thread.join();
+
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      blocks[i] = pool::allocate();
+    }
+    CHECK(std::unordered_set<void*>{blocks.begin(), blocks.end()}.size() == blocks.size());
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("class specific allocation functions")
+  {
+    auto* p = new pooled{1, 2, 3};
+    CHECK(p->a == 1);
+    CHECK(p->b == 2);
+    CHECK(p->c == 3);
+    delete p;
+  }
+}
+
+} // namespace kdl
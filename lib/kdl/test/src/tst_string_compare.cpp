@@ -21,6 +21,10 @@
 #include "kdl/collection_utils.h"
 #include "kdl/string_compare.h"
 
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "catch2.h"
 
 namespace kdl
@@ -328,6 +332,25 @@ TEST_CASE("string_utils_ci_test.str_matches_glob")
   CHECK(str_matches_glob("aSD*?fJ\\kL", "asd\\*\\?fj\\\\kl"));
 }
 
+TEST_CASE("string_utils_ci_test.string_hash")
+{
+  const auto hash = string_hash{};
+  CHECK(hash("") == hash(""));
+  CHECK(hash("asdf") == hash("asdf"));
+  CHECK(hash("asdf") == hash("AsDF"));
+  CHECK(hash("ASDF") == hash("asdf"));
+  CHECK(hash("asdf") != hash("asdg"));
+  CHECK(hash("asdf") != hash("asd"));
+
+  const auto map = std::unordered_map<std::string, int, string_hash, string_equal>{
+    {"asdf", 1},
+    {"Other", 2},
+  };
+  CHECK(map.find(std::string_view{"ASDF"})->second == 1);
+  CHECK(map.find(std::string{"other"})->second == 2);
+  CHECK(map.find("asd") == map.end());
+}
+
 template <typename C>
 C sorted(C c)
 {
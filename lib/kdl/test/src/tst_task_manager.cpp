@@ -21,7 +21,11 @@
 #include "kdl/range_to_vector.h"
 #include "kdl/task_manager.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 #include "catch2.h"
@@ -121,6 +125,93 @@ TEST_CASE("task_manager")
     CHECK(task_ran2);
     CHECK(task_ran3);
   }
+
+  SECTION("parallel_for")
+  {
+    const auto count = GENERATE(0u, 1u, 2u, 7u, 1000u);
+    CAPTURE(count);
+
+    auto counts = std::vector<std::atomic<int>>(count);
+    auto indices = std::views::iota(0u, count) | to_vector;
+
+    tm.parallel_for(indices, [&](const auto i) { ++counts[i]; });
+
+    CHECK(std::ranges::all_of(counts, [](const auto& c) { return c == 1; }));
+  }
+
+  SECTION("parallel_transform")
+  {
+    const auto count = GENERATE(0u, 1u, 2u, 7u, 1000u);
+    CAPTURE(count);
+
+    const auto ints = std::views::iota(0, int(count)) | to_vector;
+
+    CHECK(
+      tm.parallel_transform(ints, [](const auto i) { return i * 2; })
+      == (ints | std::views::transform([](const auto i) { return i * 2; }) | to_vector));
+
+    CHECK(
+      tm.parallel_transform(ints, [](const auto i) { return i % 2 == 0; })
+      == (ints | std::views::transform([](const auto i) { return i % 2 == 0; })
+          | to_vector));
+
+    CHECK(
+      tm.parallel_transform(ints, [](const auto i) { return std::to_string(i); })
+      == (ints | std::views::transform([](const auto i) { return std::to_string(i); })
+          | to_vector));
+  }
+
+  SECTION("parallel_transform with non default constructible result")
+  {
+    struct no_default
+    {
+      int i;
+
+      explicit no_default(const int i_)
+        : i{i_}
+      {
+      }
+    };
+
+    const auto ints = std::views::iota(0, 100) | to_vector;
+    const auto results =
+      tm.parallel_transform(ints, [](const auto i) { return no_default{i}; });
+
+    CHECK(
+      (results | std::views::transform([](const auto& r) { return r.i; }) | to_vector)
+      == ints);
+  }
+
+  SECTION("parallel_for rethrows exception")
+  {
+    const auto ints = std::views::iota(0, 100) | to_vector;
+    auto calls = std::atomic<int>{0};
+
+    CHECK_THROWS_AS(
+      tm.parallel_for(
+        ints,
+        [&](const auto i) {
+          ++calls;
+          if (i == 50)
+          {
+            throw std::runtime_error{"error"};
+          }
+        }),
+      std::runtime_error);
+    CHECK(calls > 0);
+  }
+
+  SECTION("nested parallel_for")
+  {
+    const auto ints = std::views::iota(0, 16) | to_vector;
+    auto sum = std::atomic<int>{0};
+
+    tm.parallel_for(ints, [&](const auto) {
+      tm.parallel_for(ints, [&](const auto j) { sum += j; });
+    });
+
+    CHECK(sum == 16 * (15 * 16 / 2));
+  }
 }
 
 TEST_CASE("task_manager stress test")